@@ -0,0 +1,119 @@
+/**
+ * \file allocations.c
+ * \brief Fichier contenant le comptage des allocations de mémoire, qui vérifie dans les builds de débogage que les frames de jeu n'allouent pas
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#include "allocations.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef ALLOCATION_CHECK
+
+/**
+ * \brief Nombre d'allocations faites par le fil courant
+ */
+static _Thread_local Uint64 allocations;
+
+static SDL_malloc_func original_malloc;
+static SDL_calloc_func original_calloc;
+static SDL_realloc_func original_realloc;
+static SDL_free_func original_free;
+
+static void *SDLCALL counting_malloc(size_t size) {
+    allocations++;
+    return original_malloc(size);
+}
+
+static void *SDLCALL counting_calloc(size_t count, size_t size) {
+    allocations++;
+    return original_calloc(count, size);
+}
+
+static void *SDLCALL counting_realloc(void *memory, size_t size) {
+    allocations++;
+    return original_realloc(memory, size);
+}
+
+static void SDLCALL counting_free(void *memory) {
+    original_free(memory);
+}
+
+// Allocations du jeu lui-même, redirigées ici par l'éditeur de liens (--wrap)
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *memory, size_t size);
+
+void *__wrap_malloc(size_t size) {
+    allocations++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size) {
+    allocations++;
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *memory, size_t size) {
+    allocations++;
+    return __real_realloc(memory, size);
+}
+
+/**
+ * \brief La fonction installe le comptage des allocations de SDL et de ses bibliothèques (surfaces, textures, polices). Elle doit être appelée
+ * avant toute autre fonction SDL.
+ */
+void init_allocation_hook(void) {
+    SDL_GetMemoryFunctions(&original_malloc, &original_calloc, &original_realloc, &original_free);
+    SDL_SetMemoryFunctions(counting_malloc, counting_calloc, counting_realloc, counting_free);
+}
+
+/**
+ * \brief La fonction donne le nombre d'allocations faites par le fil courant
+ * \return le nombre d'allocations
+ */
+Uint64 allocation_count(void) {
+    return allocations;
+}
+
+/**
+ * \brief La fonction arrête le programme si le fil courant a alloué de la mémoire depuis un comptage
+ * \param previous_count le nombre d'allocations donné par allocation_count au début de la frame
+ * \param where le nom de la boucle vérifiée, pour le message d'erreur
+ */
+void expect_no_allocation(Uint64 previous_count, const char *where) {
+    if (allocations != previous_count) {
+        fprintf(stderr, "Erreur : %llu allocation(s) pendant une frame de jeu dans %s\n", (unsigned long long)(allocations - previous_count), where);
+        abort();
+    }
+}
+
+#else
+
+/**
+ * \brief Sans ALLOCATION_CHECK, les allocations ne sont pas comptées
+ */
+void init_allocation_hook(void) {
+}
+
+/**
+ * \brief Sans ALLOCATION_CHECK, les allocations ne sont pas comptées
+ * \return 0
+ */
+Uint64 allocation_count(void) {
+    return 0;
+}
+
+/**
+ * \brief Sans ALLOCATION_CHECK, les allocations ne sont pas vérifiées
+ * \param previous_count ignoré
+ * \param where ignoré
+ */
+void expect_no_allocation(Uint64 previous_count, const char *where) {
+    (void)previous_count;
+    (void)where;
+}
+
+#endif
@@ -0,0 +1,26 @@
+/**
+ * \file allocations.h
+ * \brief Fichier contenant le comptage des allocations de mémoire, qui vérifie dans les builds de débogage que les frames de jeu n'allouent pas
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#ifndef __ALLOCATIONS_H__
+#define __ALLOCATIONS_H__
+
+#include <SDL.h>
+
+/**
+ * \brief Nombre de frames de jeu autorisées à allouer au début de chaque niveau, une par tampon d'instantané, chacun étant dimensionné pour les
+ * météorites visibles à sa première utilisation. Un tampon agrandi ensuite relance ces frames.
+ */
+#define ALLOCATION_CHECK_WARMUP_FRAMES 3
+
+void init_allocation_hook(void);
+
+Uint64 allocation_count(void);
+
+void expect_no_allocation(Uint64 previous_count, const char *where);
+
+#endif
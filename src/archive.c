@@ -0,0 +1,125 @@
+/**
+ * \file archive.c
+ * \brief Fichier contenant le format de l'archive des ressources et son chargement en mémoire projetée
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#include "archive.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * \brief La fonction charge l'archive en mémoire. Sous POSIX, le fichier est projeté en mémoire et les pages ne sont lues qu'à leur premier accès ;
+ * sous Windows, il est lu en entier.
+ * \param path le chemin du fichier
+ * \param archive l'archive à remplir
+ * \return true si l'archive a été chargée et est valide, false sinon
+ */
+bool open_archive(const char *path, archive_t *archive) {
+    archive->data = NULL;
+    archive->size = 0;
+#ifndef _WIN32
+    int fd = open(path, O_RDONLY);
+    if (fd == -1) {
+        return false;
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || (size_t)file_stat.st_size < sizeof(archive_header_t)) {
+        close(fd);
+        return false;
+    }
+    // Projection privée en écriture (copie à l'écriture), car les surfaces SDL pointent vers des pixels non constants
+    void *data = mmap(NULL, file_stat.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+    archive->data = data;
+    archive->size = file_stat.st_size;
+#else
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        return false;
+    }
+    fseek(file, 0, SEEK_END);
+    archive->size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    archive->data = malloc(archive->size);
+    if (archive->size < sizeof(archive_header_t) || archive->data == NULL || fread(archive->data, 1, archive->size, file) != archive->size) {
+        fclose(file);
+        close_archive(archive);
+        return false;
+    }
+    fclose(file);
+#endif
+
+    archive->header = (const archive_header_t *)archive->data;
+    archive->entries = (const archive_entry_t *)(archive->data + sizeof(archive_header_t));
+    if (archive->header->magic != ARCHIVE_MAGIC || archive->header->version != ARCHIVE_VERSION ||
+        sizeof(archive_header_t) + sizeof(archive_entry_t) * archive->header->entry_count > archive->size) {
+        fprintf(stderr, "Archive invalide : %s\n", path);
+        close_archive(archive);
+        return false;
+    }
+    for (Uint32 i = 0; i < archive->header->entry_count; i++) {
+        if (archive->entries[i].offset + archive->entries[i].size > archive->size) {
+            fprintf(stderr, "Archive tronquée : %s\n", path);
+            close_archive(archive);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * \brief La fonction cherche une entrée de l'archive
+ * \param archive l'archive, ou une archive vide
+ * \param name le chemin de la ressource
+ * \return l'entrée, ou NULL si elle n'existe pas
+ */
+const archive_entry_t *find_archive_entry(const archive_t *archive, const char *name) {
+    if (archive->data == NULL) {
+        return NULL;
+    }
+    for (Uint32 i = 0; i < archive->header->entry_count; i++) {
+        if (strncmp(archive->entries[i].name, name, ARCHIVE_NAME_SIZE) == 0) {
+            return &archive->entries[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * \brief La fonction donne les données d'une entrée, directement dans la mémoire de l'archive
+ * \param archive l'archive
+ * \param entry l'entrée
+ * \return les données, valides jusqu'à la fermeture de l'archive
+ */
+void *archive_entry_data(const archive_t *archive, const archive_entry_t *entry) {
+    return archive->data + entry->offset;
+}
+
+/**
+ * \brief La fonction libère l'archive
+ * \param archive l'archive
+ */
+void close_archive(archive_t *archive) {
+    if (archive->data != NULL) {
+#ifndef _WIN32
+        munmap(archive->data, archive->size);
+#else
+        free(archive->data);
+#endif
+    }
+    archive->data = NULL;
+    archive->size = 0;
+}
@@ -0,0 +1,91 @@
+/**
+ * \file archive.h
+ * \brief Fichier contenant le format de l'archive des ressources et son chargement en mémoire projetée
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#ifndef __ARCHIVE_H__
+#define __ARCHIVE_H__
+
+#include <SDL.h>
+#include <stdbool.h>
+
+/**
+ * \brief Nom du fichier de l'archive, à côté de l'exécutable
+ */
+#define ARCHIVE_FILE_NAME "resources.pak"
+
+/**
+ * \brief Signature de l'archive ("SCPK")
+ */
+#define ARCHIVE_MAGIC 0x4B504353
+
+/**
+ * \brief Version du format de l'archive
+ */
+#define ARCHIVE_VERSION 1
+
+/**
+ * \brief Alignement des données de chaque entrée, égal à la taille d'une page mémoire
+ */
+#define ARCHIVE_ALIGNMENT 4096
+
+/**
+ * \brief Taille maximale du nom d'une entrée, zéro final compris
+ */
+#define ARCHIVE_NAME_SIZE 48
+
+/**
+ * \brief Types d'entrées de l'archive
+ */
+enum archive_entry_type_e {
+    ARCHIVE_ENTRY_IMAGE, /*!< Pixels RGBA8888, lignes de width * 4 octets */
+    ARCHIVE_ENTRY_SOUND, /*!< Échantillons PCM entrelacés */
+    ARCHIVE_ENTRY_FONT,  /*!< Fichier de police TrueType */
+};
+typedef enum archive_entry_type_e archive_entry_type_t;
+
+/**
+ * \brief En-tête de l'archive, au début du fichier
+ */
+typedef struct archive_header_s {
+    Uint32 magic;
+    Uint32 version;
+    Uint32 entry_count;
+    Uint32 reserved;
+} archive_header_t;
+
+/**
+ * \brief Entrée de l'index, qui suit l'en-tête
+ */
+typedef struct archive_entry_s {
+    char name[ARCHIVE_NAME_SIZE]; /*!< Chemin de la ressource, par exemple "resources/meteorite.png" */
+    Uint32 type;
+    Uint32 width;  /*!< Largeur d'une image, ou fréquence d'un son */
+    Uint32 height; /*!< Hauteur d'une image, ou nombre de canaux d'un son */
+    Uint32 format; /*!< Format SDL des pixels d'une image, ou des échantillons d'un son */
+    Uint64 offset; /*!< Position des données, multiple de ARCHIVE_ALIGNMENT */
+    Uint64 size;   /*!< Taille des données */
+} archive_entry_t;
+
+/**
+ * \brief Archive chargée en mémoire
+ */
+typedef struct archive_s {
+    Uint8 *data;
+    size_t size;
+    const archive_header_t *header;
+    const archive_entry_t *entries;
+} archive_t;
+
+bool open_archive(const char *path, archive_t *archive);
+
+const archive_entry_t *find_archive_entry(const archive_t *archive, const char *name);
+
+void *archive_entry_data(const archive_t *archive, const archive_entry_t *entry);
+
+void close_archive(archive_t *archive);
+
+#endif
@@ -0,0 +1,95 @@
+/**
+ * \file arena.c
+ * \brief Fichier contenant l'arène, mémoire allouée par incrément d'un pointeur et libérée d'un seul coup
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#include "arena.h"
+#include <stdlib.h>
+
+/**
+ * \brief La fonction donne la place qu'occupe une allocation dans l'arène, pour dimensionner l'arène lors d'une passe de comptage
+ * \param size la taille demandée
+ * \return la taille arrondie à l'alignement
+ */
+size_t arena_allocation_size(size_t size) {
+    return (size + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT;
+}
+
+/**
+ * \brief La fonction initialise une arène vide
+ * \param arena l'arène
+ */
+void init_arena(arena_t *arena) {
+    arena->data = NULL;
+    arena->capacity = 0;
+    arena->used = 0;
+    arena->overflow = NULL;
+}
+
+/**
+ * \brief La fonction vide l'arène et s'assure qu'elle peut contenir une taille donnée. Le bloc existant est réutilisé s'il est assez grand.
+ * \param arena l'arène
+ * \param capacity la taille nécessaire, somme des arena_allocation_size des allocations prévues
+ * \return true si l'arène peut contenir cette taille, false si la mémoire manque, l'arène gardant alors son bloc et sa capacité
+ */
+bool reserve_arena(arena_t *arena, size_t capacity) {
+    reset_arena(arena);
+    if (capacity > arena->capacity) {
+        unsigned char *data = malloc(capacity);
+        if (data == NULL) {
+            return false;
+        }
+        free(arena->data);
+        arena->data = data;
+        arena->capacity = capacity;
+    }
+    return true;
+}
+
+/**
+ * \brief La fonction alloue de la mémoire dans l'arène. Si l'arène est pleine, un bloc est alloué à part, et libéré avec l'arène.
+ * \param arena l'arène
+ * \param size la taille
+ * \return la mémoire, alignée sur ARENA_ALIGNMENT, valide jusqu'à la réinitialisation de l'arène, ou NULL si la mémoire manque
+ */
+void *arena_alloc(arena_t *arena, size_t size) {
+    size = arena_allocation_size(size);
+    if (arena->used + size <= arena->capacity) {
+        void *memory = arena->data + arena->used;
+        arena->used += size;
+        return memory;
+    }
+    arena_overflow_t *overflow = malloc(arena_allocation_size(sizeof(arena_overflow_t)) + size);
+    if (overflow == NULL) {
+        return NULL;
+    }
+    overflow->next = arena->overflow;
+    arena->overflow = overflow;
+    return (unsigned char *)overflow + arena_allocation_size(sizeof(arena_overflow_t));
+}
+
+/**
+ * \brief La fonction libère d'un coup toutes les allocations de l'arène, en gardant son bloc
+ * \param arena l'arène
+ */
+void reset_arena(arena_t *arena) {
+    while (arena->overflow != NULL) {
+        arena_overflow_t *next = arena->overflow->next;
+        free(arena->overflow);
+        arena->overflow = next;
+    }
+    arena->used = 0;
+}
+
+/**
+ * \brief La fonction libère l'arène et son bloc
+ * \param arena l'arène
+ */
+void clean_arena(arena_t *arena) {
+    reset_arena(arena);
+    free(arena->data);
+    init_arena(arena);
+}
@@ -0,0 +1,49 @@
+/**
+ * \file arena.h
+ * \brief Fichier contenant l'arène, mémoire allouée par incrément d'un pointeur et libérée d'un seul coup
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#ifndef __ARENA_H__
+#define __ARENA_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * \brief Alignement de chaque allocation de l'arène
+ */
+#define ARENA_ALIGNMENT 16
+
+/**
+ * \brief Bloc alloué hors de l'arène lorsqu'elle est pleine, libéré à sa réinitialisation
+ */
+typedef struct arena_overflow_s {
+    struct arena_overflow_s *next;
+} arena_overflow_t;
+
+/**
+ * \brief Arène : un seul bloc, dimensionné à l'avance, découpé dans l'ordre des allocations
+ */
+typedef struct arena_s {
+    unsigned char *data;
+    size_t capacity;
+    size_t used;
+    arena_overflow_t *overflow; /*!< Blocs alloués au-delà de la capacité, par exemple lors d'une édition du niveau en cours de partie */
+} arena_t;
+
+size_t arena_allocation_size(size_t size);
+
+void init_arena(arena_t *arena);
+
+bool reserve_arena(arena_t *arena, size_t capacity);
+
+void *arena_alloc(arena_t *arena, size_t size);
+
+void reset_arena(arena_t *arena);
+
+void clean_arena(arena_t *arena);
+
+#endif
@@ -0,0 +1,145 @@
+/**
+ * \file audio.c
+ * \brief Fichier contenant les effets sonores synthétisés dans le fil audio et la mesure de la latence du son
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#include "audio.h"
+#include "constants.h"
+#include "utilities.h"
+#include <SDL_mixer.h>
+#include <math.h>
+#include <stdio.h>
+
+/**
+ * \brief Échelle de la virgule fixe des intensités publiées par la simulation
+ */
+#define AUDIO_FIXED_POINT 65536
+
+/**
+ * \brief La fonction de post-mixage, appelée par le fil audio sur chaque tampon déjà mixé par SDL_mixer : elle mesure la latence du dernier
+ * évènement sonore puis ajoute les effets synthétisés, en faisant glisser leurs intensités sur la durée du tampon pour éviter les clics
+ * \param data les effets sonores
+ * \param stream le tampon, au format négocié
+ * \param length la taille du tampon, en octets
+ */
+static void audio_postmix(void *data, Uint8 *stream, int length) {
+    audio_t *audio = data;
+    if (SDL_AtomicGet(&audio->event_pending)) {
+        record_latency(&audio->latency, SDL_GetPerformanceCounter() - audio->event_counter);
+        SDL_AtomicSet(&audio->event_pending, 0);
+    }
+
+    Sint16 *samples = (Sint16 *)stream;
+    int frames = length / (int)(sizeof(Sint16) * audio->channels);
+    SDL_AtomicSet(&audio->buffer_frames, frames);
+    double hum_target = (double)SDL_AtomicGet(&audio->proximity) / AUDIO_FIXED_POINT;
+    double engine_target = (double)SDL_AtomicGet(&audio->engine) / AUDIO_FIXED_POINT;
+    if (frames == 0 || (audio->hum_level == 0.0 && hum_target == 0.0 && audio->engine_level == 0.0 && engine_target == 0.0)) {
+        return;
+    }
+
+    double hum_step = (hum_target - audio->hum_level) / frames, engine_step = (engine_target - audio->engine_level) / frames;
+    double phase_step = AUDIO_HUM_FREQUENCY / audio->frequency;
+    for (int f = 0; f < frames; f++) {
+        audio->hum_level += hum_step;
+        audio->engine_level += engine_step;
+
+        // Bourdonnement : fondamentale et première harmonique
+        double hum = sin(2.0 * M_PI * audio->hum_phase) + 0.5 * sin(4.0 * M_PI * audio->hum_phase);
+        audio->hum_phase += phase_step;
+        audio->hum_phase -= floor(audio->hum_phase);
+
+        // Moteur : bruit blanc (xorshift) filtré passe-bas, plus clair quand le moteur pousse fort
+        audio->noise_state ^= audio->noise_state << 13;
+        audio->noise_state ^= audio->noise_state >> 17;
+        audio->noise_state ^= audio->noise_state << 5;
+        double white_noise = (Sint32)audio->noise_state / 2147483648.0;
+        audio->engine_noise += (0.05 + 0.25 * audio->engine_level) * (white_noise - audio->engine_noise);
+
+        double value = hum * audio->hum_level * AUDIO_HUM_VOLUME + audio->engine_noise * audio->engine_level * AUDIO_ENGINE_VOLUME;
+        int offset = value * 32767;
+        for (int c = 0; c < audio->channels; c++) {
+            Sint16 *sample = &samples[f * audio->channels + c];
+            *sample = CLAMP(*sample + offset, -32768, 32767);
+        }
+    }
+    audio->hum_level = hum_target;
+    audio->engine_level = engine_target;
+}
+
+/**
+ * \brief La fonction ajoute les effets sonores au mixage. L'audio doit déjà être ouvert ; les effets sont désactivés si le format négocié
+ * n'est pas celui des échantillons synthétisés.
+ * \param audio les effets sonores
+ */
+void start_audio(audio_t *audio) {
+    Uint16 format;
+    audio->enabled = Mix_QuerySpec(&audio->frequency, &format, &audio->channels) != 0 && format == AUDIO_S16SYS;
+    SDL_AtomicSet(&audio->proximity, 0);
+    SDL_AtomicSet(&audio->engine, 0);
+    audio->hum_level = 0.0;
+    audio->engine_level = 0.0;
+    audio->hum_phase = 0.0;
+    audio->engine_noise = 0.0;
+    audio->noise_state = 0x12345678;
+    audio->event_counter = 0;
+    SDL_AtomicSet(&audio->event_pending, 0);
+    SDL_AtomicSet(&audio->buffer_frames, 0);
+    SDL_memset(&audio->latency, 0, sizeof(audio->latency));
+    audio->mixing = audio->enabled;
+    if (audio->mixing) {
+        Mix_SetPostMix(audio_postmix, audio);
+    }
+}
+
+/**
+ * \brief La fonction publie l'intensité des effets sonores, appliquée au prochain tampon
+ * \param audio les effets sonores
+ * \param proximity l'intensité du bourdonnement, entre 0 et 1
+ * \param engine l'intensité du moteur, entre 0 et 1
+ */
+void set_audio_effects(audio_t *audio, double proximity, double engine) {
+    SDL_AtomicSet(&audio->proximity, CLAMP(proximity, 0.0, 1.0) * AUDIO_FIXED_POINT);
+    SDL_AtomicSet(&audio->engine, CLAMP(engine, 0.0, 1.0) * AUDIO_FIXED_POINT);
+}
+
+/**
+ * \brief La fonction horodate un évènement sonore (collision, victoire), pour mesurer le délai jusqu'au mixage du tampon qui le contient.
+ * Un évènement survenant avant le mixage du précédent n'est pas mesuré.
+ * \param audio les effets sonores
+ */
+void mark_audio_event(audio_t *audio) {
+    if (audio->enabled && !SDL_AtomicGet(&audio->event_pending)) {
+        audio->event_counter = SDL_GetPerformanceCounter();
+        SDL_AtomicSet(&audio->event_pending, 1);
+    }
+}
+
+/**
+ * \brief La fonction affiche la mesure de la latence du son. Elle doit être appelée une fois les effets retirés du mixage
+ * \param audio les effets sonores
+ */
+void report_audio_latency(audio_t *audio) {
+    if (!audio->enabled) {
+        printf("Latence du son : audio indisponible\n");
+        return;
+    }
+    int buffer_frames = SDL_AtomicGet(&audio->buffer_frames);
+    printf("Latence du son (%d Hz, tampon de %d échantillons, soit %.1f ms de plus avant la sortie) :\n", audio->frequency, buffer_frames,
+           buffer_frames * 1000.0 / audio->frequency);
+    report_latency("évènement -> mixage", &audio->latency);
+}
+
+/**
+ * \brief La fonction retire les effets sonores du mixage. Les appels suivants ne font rien
+ * \param audio les effets sonores
+ */
+void stop_audio(audio_t *audio) {
+    if (audio->mixing) {
+        Mix_SetPostMix(NULL, NULL);
+        audio->mixing = false;
+    }
+}
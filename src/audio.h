@@ -0,0 +1,50 @@
+/**
+ * \file audio.h
+ * \brief Fichier contenant les effets sonores synthétisés dans le fil audio et la mesure de la latence du son
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#ifndef __AUDIO_H__
+#define __AUDIO_H__
+
+#include "latency.h"
+#include <SDL.h>
+#include <stdbool.h>
+
+/**
+ * \brief Effets sonores ajoutés au mixage par le fil audio : un bourdonnement qui croît à l'approche des météorites et le bruit du moteur.
+ *
+ * La simulation publie l'intensité des effets par des entiers atomiques, lus par le fil audio au début de chaque tampon ; la synthèse
+ * n'alloue rien et ne prend aucun verrou.
+ */
+typedef struct audio_s {
+    bool enabled;           /*!< Indique si l'audio est ouvert au format attendu par la synthèse */
+    bool mixing;            /*!< Indique si les effets sont branchés sur le mixage, jusqu'à stop_audio */
+    int frequency;          /*!< Fréquence négociée avec le périphérique */
+    int channels;           /*!< Nombre de canaux négocié avec le périphérique */
+    SDL_atomic_t proximity; /*!< Intensité du bourdonnement, en virgule fixe sur 16 bits, écrite par la simulation */
+    SDL_atomic_t engine;    /*!< Intensité du moteur, en virgule fixe sur 16 bits, écrite par la simulation */
+    double hum_level;       /*!< Intensités appliquées à la fin du tampon précédent, propriété du fil audio */
+    double engine_level;
+    double hum_phase;            /*!< Phase du bourdonnement, en tours */
+    double engine_noise;         /*!< Bruit filtré du moteur */
+    Uint32 noise_state;          /*!< État du générateur de bruit */
+    Uint64 event_counter;        /*!< Instant du dernier évènement sonore, en ticks de SDL_GetPerformanceCounter */
+    SDL_atomic_t event_pending;  /*!< Indique qu'un évènement sonore attend d'être mixé */
+    SDL_atomic_t buffer_frames;  /*!< Taille du dernier tampon mixé, en échantillons par canal */
+    latency_histogram_t latency; /*!< Latences entre un évènement et le mixage du tampon qui le contient, écrites par le fil audio */
+} audio_t;
+
+void start_audio(audio_t *audio);
+
+void set_audio_effects(audio_t *audio, double proximity, double engine);
+
+void mark_audio_event(audio_t *audio);
+
+void report_audio_latency(audio_t *audio);
+
+void stop_audio(audio_t *audio);
+
+#endif
@@ -0,0 +1,200 @@
+/**
+ * \file benchmark.c
+ * \brief Fichier contenant le banc d'essai sans fenêtre, qui mesure le chargement et la simulation de niveaux de taille croissante
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#include "benchmark.h"
+#include "allocations.h"
+#include "game.h"
+#include "graphics.h"
+#include "latency.h"
+#include "logger.h"
+#include "replay.h"
+#include "snapshot.h"
+#include "utilities.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+/**
+ * \brief La fonction compte les niveaux d'un répertoire, numérotés à partir de 0 sans trou, sans les décoder
+ * \param levels_dir le répertoire des niveaux
+ * \return le nombre de niveaux
+ */
+static int count_benchmark_levels(const char *levels_dir) {
+    int count = 0;
+    while (true) {
+        char level_path[30];
+        sprintf(level_path, "level_%d.png", count);
+        char *path = concat_paths(levels_dir, level_path);
+        SDL_RWops *file = SDL_RWFromFile(path, "rb");
+        free(path);
+        if (file == NULL) {
+            return count;
+        }
+        SDL_RWclose(file);
+        count++;
+    }
+}
+
+/**
+ * \brief La fonction donne le pic de mémoire résidente du processus depuis son démarrage. Les niveaux étant mesurés par taille croissante et
+ * libérés entre deux mesures, le pic après un niveau est celui de ce niveau.
+ * \return le pic de mémoire résidente, en Mio, ou 0 s'il n'est pas disponible (Windows)
+ */
+static double peak_resident_memory(void) {
+#ifndef _WIN32
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0.0;
+    }
+#ifdef __APPLE__
+    return usage.ru_maxrss / (1024.0 * 1024.0);
+#else
+    return usage.ru_maxrss / 1024.0;
+#endif
+#else
+    return 0.0;
+#endif
+}
+
+/**
+ * \brief La fonction fait tourner chaque niveau d'un répertoire sans fenêtre, à pas fixe et avec les mêmes entrées (haut maintenu, ou un
+ * enregistrement), et mesure son chargement, le pic de mémoire, le temps de chaque pas de simulation et de chaque dessin. Les résultats sont écrits
+ * en CSV dans le répertoire des niveaux, une ligne par niveau, pour suivre le passage à l'échelle d'une version à l'autre.
+ * \param exe_dir le chemin de l'exécutable, utilisé pour charger les ressources
+ * \param options les options de la ligne de commande
+ * \return le code de sortie du programme
+ */
+int run_benchmark(const char *exe_dir, const options_t *options) {
+    int level_count = count_benchmark_levels(options->benchmark_dir);
+    if (level_count == 0) {
+        LOG_ERROR("Aucun niveau level_0.png dans %s", options->benchmark_dir);
+        return 1;
+    }
+    replay_t replay = {0};
+    if (options->replay_path != NULL && !load_replay(options->replay_path, &replay)) {
+        return 1;
+    }
+    char *results_path = concat_paths(options->benchmark_dir, BENCHMARK_RESULTS_FILE);
+    FILE *results = fopen(results_path, "w");
+    if (results == NULL) {
+        LOG_ERROR("Erreur lors de l'ouverture de %s", results_path);
+        free(results_path);
+        return 1;
+    }
+
+    SDL_Surface *surface;
+    SDL_Renderer *renderer;
+    if (init_sdl_offscreen(&surface, &renderer, INITIAL_SCREEN_WIDTH, INITIAL_SCREEN_HEIGHT) != 0) {
+        fclose(results);
+        free(results_path);
+        clean_replay(&replay);
+        return 1;
+    }
+    init_ttf();
+    init_mix(false);
+
+    resources_t resources;
+    world_t world;
+    if (!init_resources(exe_dir, renderer, &resources)) {
+        fclose(results);
+        free(results_path);
+        clean_replay(&replay);
+        clean_resources(&resources);
+        clean_mix();
+        clean_ttf();
+        clean_sdl(renderer, NULL);
+        clean_surface(surface);
+        return 1;
+    }
+    init_data(exe_dir, &resources, &world);
+    resources.levels_dir = options->benchmark_dir;
+    world.level_count = level_count;
+    world.fixed_frame_time = 1000 / MAX_FPS;
+
+    fprintf(results, "niveau,largeur,hauteur,meteorites,chargement_ms,maj_meteorites_ms,memoire_max_mio,frames,pas_moyen_ms,pas_p99_ms,dessin_p99_ms,"
+                     "pas_par_seconde\n");
+    printf("Banc d'essai (%d niveau(x), %ld frames au plus par niveau) :\n", level_count, options->frames);
+    snapshot_t snapshot = {0};
+    static latency_histogram_t steps, draws;
+    for (int level = 0; level < level_count; level++) {
+        if (world.level_loaded) {
+            clean_playing_data(&world);
+        }
+        world.current_level = level;
+        Uint64 load_start = SDL_GetPerformanceCounter();
+        bool loaded = transition_to_playing(exe_dir, &resources, &world);
+        double load_ms = (SDL_GetPerformanceCounter() - load_start) * 1000.0 / SDL_GetPerformanceFrequency();
+        if (!loaded) {
+            // Un niveau trop grand pour la mémoire garde sa ligne, sans mesures, et les niveaux suivants sont quand même essayés
+            fprintf(results, "%d,,,,%.1f,,%.1f,0,,,,\n", level, load_ms, peak_resident_memory());
+            printf("  niveau %d : chargement impossible après %.1f ms, %.1f Mio au plus\n", level, load_ms, peak_resident_memory());
+            continue;
+        }
+        size_t meteorite_count = world.meteorites.count;
+        double width = world.level_width, height = world.level_height;
+
+        // Mise à jour de toutes les météorites à la fois, à des instants tous différents pour qu'aucun groupe ne soit sauté : le pire cas d'une
+        // frame, qui ne met à jour que les groupes proches des vaisseaux et de la caméra
+        Uint64 update_start = SDL_GetPerformanceCounter();
+        for (int u = 0; u < BENCHMARK_METEORITE_UPDATES; u++) {
+            update_meteorites(&world.meteorites, meteorite_time(&world) + u * world.fixed_frame_time / 1000.0, -INFINITY, INFINITY, width);
+        }
+        double update_ms = (SDL_GetPerformanceCounter() - update_start) * 1000.0 / SDL_GetPerformanceFrequency() / BENCHMARK_METEORITE_UPDATES;
+
+        steps = (latency_histogram_t){0};
+        draws = (latency_histogram_t){0};
+        Uint64 simulation_time = 0;
+        long frames = 0;
+        int playing_frames = 0; // frames consécutives sans agrandissement de l'instantané, pour la vérification des allocations
+        while (frames < options->frames && world.game_state == GAME_STATE_PLAYING) {
+            Uint64 allocations = allocation_count();
+            Uint8 input = options->replay_path != NULL ? replay_input(&replay, frames) : INPUT_UP;
+            Uint64 step_start = SDL_GetPerformanceCounter();
+            update_data(exe_dir, &resources, &world, &input);
+            capture_snapshot(&world, &snapshot, surface->w, surface->h);
+            Uint64 step_time = SDL_GetPerformanceCounter() - step_start;
+            record_latency(&steps, step_time);
+            simulation_time += step_time;
+            frames++;
+            playing_frames = world.game_state == GAME_STATE_PLAYING && !snapshot.meteorites_grown ? playing_frames + 1 : 0;
+            if (playing_frames > ALLOCATION_CHECK_WARMUP_FRAMES) {
+                expect_no_allocation(allocations, "le banc d'essai");
+            }
+
+            Uint64 draw_start = SDL_GetPerformanceCounter();
+            draw_graphics(exe_dir, renderer, NULL, &resources, &snapshot);
+            update_screen(renderer);
+            record_latency(&draws, SDL_GetPerformanceCounter() - draw_start);
+        }
+
+        double step_rate = simulation_time > 0 ? frames * (double)SDL_GetPerformanceFrequency() / simulation_time : 0.0;
+        double step_mean = frames > 0 ? steps.total_ms / frames : 0.0;
+        double step_p99 = frames > 0 ? latency_percentile(&steps, 99) : 0.0, draw_p99 = frames > 0 ? latency_percentile(&draws, 99) : 0.0;
+        fprintf(results, "%d,%.0f,%.0f,%zu,%.1f,%.3f,%.1f,%ld,%.4f,%.1f,%.1f,%.0f\n", level, width, height, meteorite_count, load_ms, update_ms,
+                peak_resident_memory(), frames, step_mean, step_p99, draw_p99, step_rate);
+        printf("  niveau %d (%.0fx%.0f, %zu météorites) : chargé en %.1f ms, toutes les météorites mises à jour en %.3f ms, %.1f Mio au plus, %ld pas, "
+               "p99 %.1f ms, %.0f pas/s\n",
+               level, width, height, meteorite_count, load_ms, update_ms, peak_resident_memory(), frames, step_p99, step_rate);
+    }
+    fclose(results);
+    printf("Résultats écrits dans %s\n", results_path);
+    free(results_path);
+
+    clean_snapshot(&snapshot);
+    clean_replay(&replay);
+    clean_data(&world);
+    clean_resources(&resources);
+    clean_mix();
+    clean_ttf();
+    clean_sdl(renderer, NULL);
+    clean_surface(surface);
+    return 0;
+}
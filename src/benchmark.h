@@ -0,0 +1,26 @@
+/**
+ * \file benchmark.h
+ * \brief Fichier contenant le banc d'essai sans fenêtre, qui mesure le chargement et la simulation de niveaux de taille croissante
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#ifndef __BENCHMARK_H__
+#define __BENCHMARK_H__
+
+#include "options.h"
+
+/**
+ * \brief Nom du fichier des résultats, écrit dans le répertoire des niveaux mesurés
+ */
+#define BENCHMARK_RESULTS_FILE "benchmark.csv"
+
+/**
+ * \brief Nombre de mises à jour complètes des météorites chronométrées après le chargement de chaque niveau
+ */
+#define BENCHMARK_METEORITE_UPDATES 100
+
+int run_benchmark(const char *exe_dir, const options_t *options);
+
+#endif
@@ -0,0 +1,268 @@
+/**
+ * \file capture.c
+ * \brief Fichier contenant l'enregistrement d'images et de vidéos sur disque par un fil d'écriture en arrière-plan
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#include "capture.h"
+#include "constants.h"
+#include "sdl2-light.h"
+#include "utilities.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * \brief La fonction répète la dernière image de la vidéo jusqu'à atteindre le numéro demandé. L'en-tête YUV4MPEG2 annonce une cadence
+ * constante : une image abandonnée qui manquerait à la vidéo en accélérerait la suite.
+ * \param capture l'enregistrement
+ * \param index le numéro de la prochaine image à écrire
+ */
+static void repeat_y4m_frames(capture_t *capture, Uint64 index) {
+    size_t plane_size = (size_t)capture->width * capture->height;
+    // Avant la première image, il n'y a rien à répéter : la vidéo commence plus tard
+    if (capture->written == 0) {
+        capture->written = index;
+        return;
+    }
+    for (; capture->written < index; capture->written++) {
+        fputs("FRAME\n", capture->stream);
+        if (fwrite(capture->converted, plane_size, 3, capture->stream) != 3) {
+            fprintf(stderr, "Erreur pendant l'écriture de la vidéo %s\n", capture->path);
+        }
+    }
+}
+
+/**
+ * \brief La fonction ajoute une image au fichier vidéo YUV4MPEG2, après conversion de RGBA en YCbCr 4:4:4 (BT.601, plage complète). Les
+ * images abandonnées avant elle sont remplacées par la précédente.
+ * \param capture l'enregistrement
+ * \param frame l'image
+ */
+static void write_y4m_frame(capture_t *capture, const capture_frame_t *frame) {
+    repeat_y4m_frames(capture, frame->index);
+    size_t plane_size = (size_t)capture->width * capture->height;
+    Uint8 *y_plane = capture->converted, *cb_plane = y_plane + plane_size, *cr_plane = cb_plane + plane_size;
+    for (size_t i = 0; i < plane_size; i++) {
+        int r = frame->pixels[i * 4], g = frame->pixels[i * 4 + 1], b = frame->pixels[i * 4 + 2];
+        y_plane[i] = (77 * r + 150 * g + 29 * b + 128) >> 8;
+        cb_plane[i] = ((-43 * r - 85 * g + 128 * b + 128) >> 8) + 128;
+        cr_plane[i] = ((128 * r - 107 * g - 21 * b + 128) >> 8) + 128;
+    }
+    fputs("FRAME\n", capture->stream);
+    if (fwrite(capture->converted, plane_size, 3, capture->stream) != 3) {
+        fprintf(stderr, "Erreur pendant l'écriture de la vidéo %s\n", capture->path);
+    }
+    capture->written = frame->index + 1;
+}
+
+/**
+ * \brief La fonction écrit une image sur disque
+ * \param capture l'enregistrement
+ * \param frame l'image
+ */
+static void write_capture_frame(capture_t *capture, const capture_frame_t *frame) {
+    if (capture->format == CAPTURE_FORMAT_Y4M) {
+        write_y4m_frame(capture, frame);
+        return;
+    }
+    char name[32];
+    sprintf(name, "frame_%06llu.%s", (unsigned long long)frame->index, capture->format == CAPTURE_FORMAT_PNG ? "png" : "rgba");
+    char *path = concat_paths(capture->path, name);
+    if (capture->format == CAPTURE_FORMAT_PNG) {
+        SDL_Surface *surface =
+            SDL_CreateRGBSurfaceWithFormatFrom(frame->pixels, capture->width, capture->height, 32, capture->width * 4, SDL_PIXELFORMAT_RGBA32);
+        if (surface == NULL || IMG_SavePNG(surface, path) != 0) {
+            fprintf(stderr, "Erreur pendant l'écriture de l'image %s : %s\n", path, SDL_GetError());
+        }
+        SDL_FreeSurface(surface);
+    } else {
+        FILE *file = fopen(path, "wb");
+        if (file == NULL || fwrite(frame->pixels, (size_t)capture->width * 4, capture->height, file) != (size_t)capture->height) {
+            fprintf(stderr, "Erreur pendant l'écriture de l'image %s\n", path);
+        }
+        if (file != NULL) {
+            fclose(file);
+        }
+    }
+    free(path);
+}
+
+/**
+ * \brief La boucle du fil d'écriture : il écrit les images dans l'ordre jusqu'à l'arrêt de l'enregistrement et l'épuisement de la file
+ * \param data l'enregistrement
+ * \return 0
+ */
+static int capture_thread(void *data) {
+    capture_t *capture = data;
+    while (true) {
+        SDL_SemWait(capture->frame_ready);
+        int tail = SDL_AtomicGet(&capture->tail);
+        if (tail == SDL_AtomicGet(&capture->head)) {
+            if (!SDL_AtomicGet(&capture->running)) {
+                break;
+            }
+            continue;
+        }
+        write_capture_frame(capture, &capture->frames[tail % CAPTURE_QUEUE_SIZE]);
+        SDL_AtomicAdd(&capture->encoded, 1);
+        SDL_AtomicSet(&capture->tail, tail + 1);
+        SDL_SemPost(capture->frame_freed);
+    }
+    return 0;
+}
+
+/**
+ * \brief La fonction libère les images, les sémaphores et le fichier vidéo, une fois le fil d'écriture arrêté ou jamais démarré
+ * \param capture l'enregistrement
+ */
+static void release_capture(capture_t *capture) {
+    if (capture->frame_ready != NULL) {
+        SDL_DestroySemaphore(capture->frame_ready);
+    }
+    if (capture->frame_freed != NULL) {
+        SDL_DestroySemaphore(capture->frame_freed);
+    }
+    for (int i = 0; i < CAPTURE_QUEUE_SIZE; i++) {
+        free(capture->frames[i].pixels);
+    }
+    if (capture->stream != NULL) {
+        fclose(capture->stream);
+    }
+    free(capture->converted);
+}
+
+/**
+ * \brief La fonction alloue les images et démarre le fil d'écriture
+ * \param capture l'enregistrement
+ * \param path le répertoire où écrire les images, qui doit exister, ou le fichier vidéo pour le format Y4M
+ * \param format le format des images
+ * \param width la largeur des images
+ * \param height la hauteur des images
+ * \param drop_when_full abandonner les images quand la file est pleine, plutôt que d'attendre le fil d'écriture
+ * \param fps le nombre maximal d'images lues par seconde depuis un renderer, ou 0 pour lire toutes les images
+ * \return true si l'enregistrement a démarré, false sinon
+ */
+bool start_capture(capture_t *capture, const char *path, capture_format_t format, int width, int height, bool drop_when_full, int fps) {
+    capture->path = path;
+    capture->format = format;
+    capture->width = width;
+    capture->height = height;
+    capture->drop_when_full = drop_when_full;
+    capture->interval = fps > 0 ? SDL_GetPerformanceFrequency() / fps : 0;
+    capture->next_counter = 0;
+    capture->stream = NULL;
+    capture->converted = NULL;
+    capture->written = 0;
+    if (format == CAPTURE_FORMAT_Y4M) {
+        capture->stream = fopen(path, "wb");
+        if (capture->stream == NULL) {
+            fprintf(stderr, "Erreur pendant l'ouverture de la vidéo %s\n", path);
+            return false;
+        }
+        fprintf(capture->stream, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C444\n", width, height, fps > 0 ? fps : MAX_FPS);
+        capture->converted = malloc((size_t)width * height * 3);
+    }
+    bool allocated = format != CAPTURE_FORMAT_Y4M || capture->converted != NULL;
+    for (int i = 0; i < CAPTURE_QUEUE_SIZE; i++) {
+        capture->frames[i].pixels = malloc((size_t)width * height * 4);
+        allocated = allocated && capture->frames[i].pixels != NULL;
+    }
+    capture->frame_ready = NULL;
+    capture->frame_freed = NULL;
+    if (!allocated) {
+        fprintf(stderr, "Mémoire insuffisante pour l'enregistrement %s\n", path);
+        release_capture(capture);
+        return false;
+    }
+    capture->next_index = 0;
+    SDL_AtomicSet(&capture->head, 0);
+    SDL_AtomicSet(&capture->tail, 0);
+    SDL_AtomicSet(&capture->running, 1);
+    SDL_AtomicSet(&capture->encoded, 0);
+    SDL_AtomicSet(&capture->dropped, 0);
+    capture->frame_ready = SDL_CreateSemaphore(0);
+    capture->frame_freed = SDL_CreateSemaphore(0);
+    capture->thread = SDL_CreateThread(capture_thread, "capture", capture);
+    if (capture->thread == NULL) {
+        fprintf(stderr, "Erreur lors de la creation du fil d'écriture : %s\n", SDL_GetError());
+        release_capture(capture);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * \brief La fonction réserve la prochaine image de la file
+ * \param capture l'enregistrement
+ * \return les pixels à remplir, ou NULL si la file est pleine et que l'image est abandonnée
+ */
+Uint8 *begin_capture_frame(capture_t *capture) {
+    int head = SDL_AtomicGet(&capture->head);
+    while (head - SDL_AtomicGet(&capture->tail) >= CAPTURE_QUEUE_SIZE) {
+        if (capture->drop_when_full) {
+            SDL_AtomicAdd(&capture->dropped, 1);
+            capture->next_index++;
+            return NULL;
+        }
+        SDL_SemWait(capture->frame_freed);
+    }
+    capture->frames[head % CAPTURE_QUEUE_SIZE].index = capture->next_index++;
+    return capture->frames[head % CAPTURE_QUEUE_SIZE].pixels;
+}
+
+/**
+ * \brief La fonction transmet au fil d'écriture l'image réservée par begin_capture_frame
+ * \param capture l'enregistrement
+ */
+void submit_capture_frame(capture_t *capture) {
+    SDL_AtomicAdd(&capture->head, 1);
+    SDL_SemPost(capture->frame_ready);
+}
+
+/**
+ * \brief La fonction lit l'image du renderer et la transmet au fil d'écriture, au plus au rythme demandé. La lecture n'attend jamais le fil
+ * d'écriture : si la file est pleine, ou si la taille du renderer a changé, l'image est abandonnée.
+ * \param capture l'enregistrement
+ * \param renderer le renderer, avant sa présentation
+ */
+void capture_renderer(capture_t *capture, SDL_Renderer *renderer) {
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (now < capture->next_counter) {
+        return;
+    }
+    capture->next_counter += capture->interval;
+    if (capture->next_counter <= now) {
+        capture->next_counter = now + capture->interval;
+    }
+
+    int width, height;
+    SDL_GetRendererOutputSize(renderer, &width, &height);
+    if (width != capture->width || height != capture->height) {
+        SDL_AtomicAdd(&capture->dropped, 1);
+        capture->next_index++;
+        return;
+    }
+    Uint8 *pixels = begin_capture_frame(capture);
+    if (pixels == NULL) {
+        return;
+    }
+    SDL_RenderReadPixels(renderer, NULL, SDL_PIXELFORMAT_RGBA32, pixels, width * 4);
+    submit_capture_frame(capture);
+}
+
+/**
+ * \brief La fonction attend l'écriture des images restantes, arrête le fil d'écriture et libère les images
+ * \param capture l'enregistrement
+ */
+void stop_capture(capture_t *capture) {
+    SDL_AtomicSet(&capture->running, 0);
+    SDL_SemPost(capture->frame_ready);
+    SDL_WaitThread(capture->thread, NULL);
+    // Les images abandonnées à la fin sont aussi répétées, pour que la vidéo dure autant que l'enregistrement
+    if (capture->format == CAPTURE_FORMAT_Y4M) {
+        repeat_y4m_frames(capture, capture->next_index);
+    }
+    release_capture(capture);
+}
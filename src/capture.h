@@ -0,0 +1,76 @@
+/**
+ * \file capture.h
+ * \brief Fichier contenant l'enregistrement d'images et de vidéos sur disque par un fil d'écriture en arrière-plan
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#ifndef __CAPTURE_H__
+#define __CAPTURE_H__
+
+#include <SDL.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+/**
+ * \brief Nombre d'images préallouées entre le producteur et le fil d'écriture (puissance de 2)
+ */
+#define CAPTURE_QUEUE_SIZE 8
+
+/**
+ * \brief Formats d'écriture des images
+ */
+enum capture_format_e {
+    CAPTURE_FORMAT_RAW, /*!< Un fichier .rgba par image, octets R, G, B, A sans en-tête */
+    CAPTURE_FORMAT_PNG, /*!< Un fichier .png par image */
+    CAPTURE_FORMAT_Y4M, /*!< Un seul fichier vidéo YUV4MPEG2 non compressé, en YCbCr 4:4:4 */
+};
+typedef enum capture_format_e capture_format_t;
+
+/**
+ * \brief Image en attente d'écriture
+ */
+typedef struct capture_frame_s {
+    Uint64 index;  /*!< Numéro de l'image */
+    Uint8 *pixels; /*!< Pixels RGBA, lignes de width * 4 octets */
+} capture_frame_t;
+
+/**
+ * \brief Enregistrement d'images ou de vidéo. Les images passent du producteur au fil d'écriture par une file circulaire sans verrou, à un seul
+ * producteur et un seul consommateur, dont les tampons sont alloués une fois pour toutes.
+ */
+typedef struct capture_s {
+    const char *path; /*!< Répertoire des images, ou fichier vidéo */
+    capture_format_t format;
+    int width;
+    int height;
+    bool drop_when_full; /*!< Abandonner les images quand la file est pleine, plutôt que d'attendre le fil d'écriture */
+    Uint64 interval;     /*!< Durée minimale entre deux images lues depuis un renderer, en ticks de SDL_GetPerformanceCounter */
+    Uint64 next_counter; /*!< Instant de la prochaine image à lire depuis un renderer */
+    FILE *stream;        /*!< Fichier vidéo, pour le format Y4M */
+    Uint8 *converted;    /*!< Image convertie avant écriture, propriété du fil d'écriture */
+    Uint64 written;      /*!< Numéro suivant la dernière image écrite dans la vidéo, propriété du fil d'écriture */
+    capture_frame_t frames[CAPTURE_QUEUE_SIZE];
+    Uint64 next_index;    /*!< Numéro de la prochaine image, propriété du producteur */
+    SDL_atomic_t head;    /*!< Écrit par le producteur */
+    SDL_atomic_t tail;    /*!< Écrit par le fil d'écriture */
+    SDL_sem *frame_ready; /*!< Réveille le fil d'écriture */
+    SDL_sem *frame_freed; /*!< Réveille le producteur qui attend une place */
+    SDL_atomic_t running;
+    SDL_atomic_t encoded; /*!< Nombre d'images écrites */
+    SDL_atomic_t dropped; /*!< Nombre d'images abandonnées */
+    SDL_Thread *thread;
+} capture_t;
+
+bool start_capture(capture_t *capture, const char *path, capture_format_t format, int width, int height, bool drop_when_full, int fps);
+
+Uint8 *begin_capture_frame(capture_t *capture);
+
+void submit_capture_frame(capture_t *capture);
+
+void capture_renderer(capture_t *capture, SDL_Renderer *renderer);
+
+void stop_capture(capture_t *capture);
+
+#endif
@@ -0,0 +1,129 @@
+/**
+ * \file collision.c
+ * \brief Fichier contenant les masques de collision, opacités des images extraites au chargement, éventuellement tournées
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#include "collision.h"
+#include "parallel.h"
+#include "sdl2-light.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+/**
+ * \brief Nombre minimal de masques tournés par fil de calcul
+ */
+#define COLLISION_MASKS_PER_THREAD 4
+
+/**
+ * \brief Données du calcul des masques tournés
+ */
+typedef struct rotated_masks_s {
+    SDL_Surface *surface;
+    double max_angle;
+    int count;
+    collision_mask_t *masks;
+} rotated_masks_t;
+
+/**
+ * \brief La fonction lit l'opacité d'un pixel d'une image
+ * \param surface l'image, en 32 bits par pixel
+ * \param x l'abscisse du pixel
+ * \param y l'ordonnée du pixel
+ * \return l'opacité
+ */
+static Uint8 surface_alpha(SDL_Surface *surface, int x, int y) {
+    Uint8 red, green, blue, alpha;
+    SDL_GetRGBA(get_pixel_RGBA32(surface, x, y), surface->format, &red, &green, &blue, &alpha);
+    return alpha;
+}
+
+/**
+ * \brief La fonction extrait le masque de collision d'une image
+ * \param surface l'image, en 32 bits par pixel
+ * \param mask le masque, à libérer avec clean_collision_mask
+ * \return true si le masque a été construit, false si la mémoire manque
+ */
+bool build_collision_mask(SDL_Surface *surface, collision_mask_t *mask) {
+    mask->w = surface->w;
+    mask->h = surface->h;
+    mask->alpha = malloc((size_t)mask->w * mask->h);
+    if (mask->alpha == NULL) {
+        return false;
+    }
+    for (int y = 0; y < mask->h; y++) {
+        for (int x = 0; x < mask->w; x++) {
+            mask->alpha[(size_t)y * mask->w + x] = surface_alpha(surface, x, y);
+        }
+    }
+    return true;
+}
+
+/**
+ * \brief La fonction calcule une plage de masques tournés. Chaque pixel du masque lit, au plus proche, le pixel de l'image tourné en sens
+ * inverse autour du centre, comme le fait SDL_RenderCopyEx ; les parties de l'image qui sortent du carré de l'image sont perdues.
+ * \param data les données du calcul
+ * \param thread le numéro du fil de calcul
+ * \param first le premier masque
+ * \param last le masque suivant le dernier
+ */
+static void build_rotated_mask_range(void *data, int thread, int first, int last) {
+    (void)thread;
+    rotated_masks_t *rotated = data;
+    SDL_Surface *surface = rotated->surface;
+    for (int i = first; i < last; i++) {
+        collision_mask_t *mask = &rotated->masks[i];
+        double angle = rotated->count > 1 ? rotated->max_angle * (2.0 * i / (rotated->count - 1) - 1.0) : 0.0;
+        double cosine = cos(angle * M_PI / 180.0), sine = sin(angle * M_PI / 180.0);
+        for (int y = 0; y < mask->h; y++) {
+            for (int x = 0; x < mask->w; x++) {
+                // Sens horaire à l'écran, l'axe des ordonnées pointant vers le bas
+                double u = x + 0.5 - mask->w / 2.0, v = y + 0.5 - mask->h / 2.0;
+                int source_x = floor(cosine * u + sine * v + mask->w / 2.0);
+                int source_y = floor(-sine * u + cosine * v + mask->h / 2.0);
+                bool inside = source_x >= 0 && source_x < mask->w && source_y >= 0 && source_y < mask->h;
+                mask->alpha[(size_t)y * mask->w + x] = inside ? surface_alpha(surface, source_x, source_y) : 0;
+            }
+        }
+    }
+}
+
+/**
+ * \brief La fonction calcule les masques d'une image tournée selon des angles régulièrement répartis entre -max_angle et max_angle, en
+ * parallèle
+ * \param surface l'image, en 32 bits par pixel
+ * \param max_angle l'angle maximal, en degrés dans le sens horaire
+ * \param count le nombre d'angles, impair pour que l'angle nul en fasse partie
+ * \param masks les masques, à libérer avec clean_collision_mask
+ * \return true si les masques ont été construits, false si la mémoire manque, aucun masque n'étant alors alloué
+ */
+bool build_rotated_collision_masks(SDL_Surface *surface, double max_angle, int count, collision_mask_t *masks) {
+    bool allocated = true;
+    for (int i = 0; i < count; i++) {
+        masks[i].w = surface->w;
+        masks[i].h = surface->h;
+        masks[i].alpha = malloc((size_t)surface->w * surface->h);
+        allocated = allocated && masks[i].alpha != NULL;
+    }
+    if (!allocated) {
+        for (int i = 0; i < count; i++) {
+            clean_collision_mask(&masks[i]);
+        }
+        return false;
+    }
+    rotated_masks_t rotated = {surface, max_angle, count, masks};
+    run_parallel(count, parallel_thread_count(count, COLLISION_MASKS_PER_THREAD), build_rotated_mask_range, &rotated);
+    return true;
+}
+
+/**
+ * \brief La fonction libère un masque
+ * \param mask le masque
+ */
+void clean_collision_mask(collision_mask_t *mask) {
+    free(mask->alpha);
+    mask->alpha = NULL;
+}
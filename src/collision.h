@@ -0,0 +1,30 @@
+/**
+ * \file collision.h
+ * \brief Fichier contenant les masques de collision, opacités des images extraites au chargement, éventuellement tournées
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#ifndef __COLLISION_H__
+#define __COLLISION_H__
+
+#include <SDL.h>
+#include <stdbool.h>
+
+/**
+ * \brief Masque de collision : l'opacité de chaque pixel d'une image, un octet par pixel
+ */
+typedef struct collision_mask_s {
+    int w;
+    int h;
+    Uint8 *alpha;
+} collision_mask_t;
+
+bool build_collision_mask(SDL_Surface *surface, collision_mask_t *mask);
+
+bool build_rotated_collision_masks(SDL_Surface *surface, double max_angle, int count, collision_mask_t *masks);
+
+void clean_collision_mask(collision_mask_t *mask);
+
+#endif
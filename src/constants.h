@@ -14,6 +14,66 @@
  */
 #define MAX_FPS 240
 
+/**
+ * \brief Durée d'affichage des écrans de démarrage, de niveau terminé et de fin, en ms
+ */
+#define SCREEN_DURATION 3000
+
+/**
+ * \brief Fréquence d'échantillonnage de l'audio
+ */
+#define AUDIO_FREQUENCY 44100
+
+/**
+ * \brief Format des échantillons de l'audio (celui de MIX_DEFAULT_FORMAT)
+ */
+#define AUDIO_FORMAT AUDIO_S16SYS
+
+/**
+ * \brief Nombre de canaux de l'audio
+ */
+#define AUDIO_CHANNELS 2
+
+/**
+ * \brief Taille du tampon de l'audio, en échantillons
+ */
+#define AUDIO_CHUNK_SIZE 2048
+
+/**
+ * \brief Taille du tampon de l'audio en mode faible latence, en échantillons (environ 6 ms à 44100 Hz)
+ */
+#define AUDIO_LOW_LATENCY_CHUNK_SIZE 256
+
+/**
+ * \brief Fréquence fondamentale du bourdonnement de proximité des météorites, en Hz
+ */
+#define AUDIO_HUM_FREQUENCY 55.0
+
+/**
+ * \brief Volume maximal du bourdonnement de proximité, entre 0 et 1
+ */
+#define AUDIO_HUM_VOLUME 0.15
+
+/**
+ * \brief Distance (en unités du niveau) à partir de laquelle le bourdonnement de proximité est audible
+ */
+#define AUDIO_HUM_RADIUS 3.0
+
+/**
+ * \brief Distance entre les centres du vaisseau et d'une météorite en dessous de laquelle le passage compte comme un frôlement
+ */
+#define NEAR_MISS_DISTANCE 1.25
+
+/**
+ * \brief Distance à laquelle le vaisseau doit s'éloigner des météorites pour qu'un frôlement soit compté, et qu'un autre puisse commencer
+ */
+#define NEAR_MISS_RELEASE 2.0
+
+/**
+ * \brief Volume maximal du bruit du moteur, entre 0 et 1
+ */
+#define AUDIO_ENGINE_VOLUME 0.08
+
 /**
  * \brief Largeur initial de l'écran de jeu
  */
@@ -39,11 +99,51 @@
  */
 #define INITIAL_CAMERA_OFFSET 5.0
 
+/**
+ * \brief Zoom minimal de la vue d'ensemble, relatif au zoom normal où la largeur du niveau remplit l'écran
+ */
+#define OVERVIEW_MIN_ZOOM 0.02
+
+/**
+ * \brief Facteur de zoom de chaque appui sur - ou =, ou de chaque cran de la molette
+ */
+#define OVERVIEW_ZOOM_STEP 1.25
+
+/**
+ * \brief Taille à l'écran (en pixels) d'une météorite au-dessus de laquelle toutes les météorites sont dessinées une à une
+ */
+#define OVERVIEW_SPRITE_PIXELS 8.0
+
+/**
+ * \brief Taille à l'écran (en pixels) d'une météorite en dessous de laquelle seule la carte de densité est dessinée, loin des vaisseaux
+ */
+#define OVERVIEW_TEXTURE_PIXELS 3.0
+
+/**
+ * \brief Distance aux vaisseaux en deçà de laquelle les météorites restent dessinées une à une dans la vue d'ensemble
+ */
+#define OVERVIEW_DETAIL_RADIUS 12.0
+
+/**
+ * \brief Part du rayon de détail sur laquelle les météorites proches s'effacent vers la carte de densité
+ */
+#define OVERVIEW_DETAIL_FADE 0.25
+
 /**
  * \brief Taille d'un vaisseau
  */
 #define SPACESHIP_SIZE 1.0
 
+/**
+ * \brief Inclinaison maximale du vaisseau, atteinte à sa vitesse latérale limite, en degrés
+ */
+#define SPACESHIP_MAX_BANK_ANGLE 20.0
+
+/**
+ * \brief Nombre d'inclinaisons du vaisseau dont le masque de collision est calculé au chargement, impair pour inclure l'inclinaison nulle
+ */
+#define SPACESHIP_BANK_ANGLE_COUNT 21
+
 /**
  * \brief Taille d'une flamme relative au vaisseau
  */
@@ -54,6 +154,37 @@
  */
 #define METEORITE_SIZE 1.0
 
+/**
+ * \brief Nombre de météorites par groupe de mise à jour et de recherche de collisions
+ */
+#define METEORITE_CHUNK_SIZE 64
+
+/**
+ * \brief Pulsation de l'oscillation des météorites mobiles (en radians par seconde)
+ */
+#define METEORITE_OSCILLATION_FREQUENCY 1.5
+
+/**
+ * \brief Amplitude maximale de l'oscillation des météorites mobiles
+ */
+#define METEORITE_MAX_AMPLITUDE 2.0
+
+/**
+ * \brief Vitesse maximale de dérive horizontale des météorites mobiles (en unités par seconde)
+ */
+#define METEORITE_MAX_DRIFT_SPEED 2.0
+
+/**
+ * \brief Vitesse maximale de rotation des météorites mobiles (en degrés par seconde)
+ */
+#define METEORITE_MAX_ANGULAR_SPEED 180.0
+
+/**
+ * \brief Nombre d'angles de la météorite, sur un tour de -180 à 180 degrés, dont le masque de collision est calculé au chargement : impair
+ * pour inclure l'angle nul, soit un masque tous les 10 degrés
+ */
+#define METEORITE_ROTATION_COUNT 37
+
 /**
  * \brief Coefficient de la traînée
  */
@@ -84,4 +215,84 @@
  */
 #define BACKGROUND_SPEED 0.5
 
+/**
+ * \brief Nombre de couches de fond supplémentaires (resources/background_N.png, facultatives), dessinées par-dessus le fond
+ */
+#define BACKGROUND_LAYER_COUNT 2
+
+/**
+ * \brief Rapport entre les vitesses de défilement de deux couches de fond successives
+ */
+#define BACKGROUND_LAYER_SPEED_FACTOR 2.0
+
+/**
+ * \brief Nombre maximal de répétitions de la texture du fond sur la hauteur de l'écran
+ */
+#define BACKGROUND_MAX_TILES 32
+
+/**
+ * \brief Taille des particules (en unités du niveau)
+ */
+#define PARTICLE_SIZE 0.1
+
+/**
+ * \brief Amortissement de la vitesse des particules (par ms)
+ */
+#define PARTICLE_DRAG 0.002
+
+/**
+ * \brief Nombre de particules de traînée émises par ms, à pleine poussée
+ */
+#define PARTICLE_EXHAUST_RATE 2.0
+
+/**
+ * \brief Vitesse maximale d'éjection des particules de traînée (en unités par ms)
+ */
+#define PARTICLE_EXHAUST_SPEED 0.004
+
+/**
+ * \brief Ouverture du cône de la traînée (en radians)
+ */
+#define PARTICLE_EXHAUST_SPREAD 0.6
+
+/**
+ * \brief Durée de vie maximale des particules de traînée (en ms)
+ */
+#define PARTICLE_EXHAUST_LIFETIME 500.0
+
+/**
+ * \brief Nombre de débris émis lors d'une collision
+ */
+#define PARTICLE_DEBRIS_COUNT 4000
+
+/**
+ * \brief Vitesse maximale d'éjection des débris (en unités par ms)
+ */
+#define PARTICLE_DEBRIS_SPEED 0.006
+
+/**
+ * \brief Durée de vie maximale des débris (en ms)
+ */
+#define PARTICLE_DEBRIS_LIFETIME 2500.0
+
+/**
+ * \brief Nombre de particules de la gerbe du passage de la ligne d'arrivée
+ */
+#define PARTICLE_BURST_COUNT 8000
+
+/**
+ * \brief Vitesse maximale d'éjection des particules de la gerbe (en unités par ms)
+ */
+#define PARTICLE_BURST_SPEED 0.01
+
+/**
+ * \brief Durée de vie maximale des particules de la gerbe (en ms)
+ */
+#define PARTICLE_BURST_LIFETIME 2500.0
+
+/**
+ * \brief Déplacement du stick gauche d'une manette en dessous duquel il est ignoré, sur 32767
+ */
+#define CONTROLLER_DEAD_ZONE 8000
+
 #endif
@@ -0,0 +1,61 @@
+/**
+ * \file cpu_usage.c
+ * \brief Fichier contenant la mesure de l'utilisation du processeur par état du jeu
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#include "cpu_usage.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * \brief Noms des états du jeu dans le rapport, les états sans nom n'y figurent pas
+ */
+static const char *const state_names[GAME_STATE_QUIT + 1] = {
+    [GAME_STATE_SPLASH_SCREEN] = "écran de démarrage",
+    [GAME_STATE_PLAYING] = "jeu",
+    [GAME_STATE_LEVEL_COMPLETE_SCREEN] = "écran de niveau terminé",
+    [GAME_STATE_END_SCREEN] = "écran de fin",
+};
+
+/**
+ * \brief La fonction commence la mesure
+ * \param usage la mesure
+ */
+void init_cpu_usage(cpu_usage_t *usage) {
+    memset(usage, 0, sizeof(*usage));
+    usage->last_clock = clock();
+    usage->last_counter = SDL_GetPerformanceCounter();
+}
+
+/**
+ * \brief La fonction attribue le temps écoulé depuis l'échantillon précédent à un état du jeu
+ * \param usage la mesure
+ * \param state l'état affiché pendant ce temps
+ */
+void sample_cpu_usage(cpu_usage_t *usage, game_state_t state) {
+    clock_t now_clock = clock();
+    Uint64 now_counter = SDL_GetPerformanceCounter();
+    usage->cpu_seconds[state] += (double)(now_clock - usage->last_clock) / CLOCKS_PER_SEC;
+    usage->elapsed_seconds[state] += (double)(now_counter - usage->last_counter) / SDL_GetPerformanceFrequency();
+    usage->last_clock = now_clock;
+    usage->last_counter = now_counter;
+}
+
+/**
+ * \brief La fonction affiche l'utilisation du processeur dans chaque état, en pourcentage d'un cœur
+ * \param usage la mesure
+ * \param idle indique si les écrans fixes étaient dessinés une seule fois
+ */
+void report_cpu_usage(const cpu_usage_t *usage, bool idle) {
+    printf("Utilisation du processeur (écrans fixes au repos %s) :\n", idle ? "activé" : "désactivé");
+    for (int state = 0; state <= GAME_STATE_QUIT; state++) {
+        if (state_names[state] == NULL || usage->elapsed_seconds[state] <= 0.0) {
+            continue;
+        }
+        printf("  %s : %.1f %% d'un cœur pendant %.1f s\n", state_names[state], 100.0 * usage->cpu_seconds[state] / usage->elapsed_seconds[state],
+               usage->elapsed_seconds[state]);
+    }
+}
@@ -0,0 +1,31 @@
+/**
+ * \file cpu_usage.h
+ * \brief Fichier contenant la mesure de l'utilisation du processeur par état du jeu
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#ifndef __CPU_USAGE_H__
+#define __CPU_USAGE_H__
+
+#include "game.h"
+#include <time.h>
+
+/**
+ * \brief Temps processeur et temps écoulé cumulés dans chaque état du jeu
+ */
+typedef struct cpu_usage_s {
+    clock_t last_clock;                          /*!< Temps processeur du processus au dernier échantillon */
+    Uint64 last_counter;                         /*!< Instant du dernier échantillon, en ticks de SDL_GetPerformanceCounter */
+    double cpu_seconds[GAME_STATE_QUIT + 1];     /*!< Temps processeur, tous fils confondus, en secondes */
+    double elapsed_seconds[GAME_STATE_QUIT + 1]; /*!< Temps écoulé, en secondes */
+} cpu_usage_t;
+
+void init_cpu_usage(cpu_usage_t *usage);
+
+void sample_cpu_usage(cpu_usage_t *usage, game_state_t state);
+
+void report_cpu_usage(const cpu_usage_t *usage, bool idle);
+
+#endif
@@ -0,0 +1,241 @@
+/**
+ * \file distance_field.c
+ * \brief Fichier contenant le champ de distance du niveau, qui donne en temps constant la distance à la météorite fixe la plus proche
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#include "distance_field.h"
+#include "utilities.h"
+#include <math.h>
+#include <string.h>
+
+/**
+ * \brief Erreur maximale due à l'arrondi d'une position à l'échantillon le plus proche, en unités du niveau. Elle est retranchée de la distance
+ * lue pour en faire un minorant, qui peut donc être inférieur à la vraie distance de DISTANCE_FIELD_MAX_UNDERESTIMATE, soit deux fois cette
+ * erreur et un pas.
+ */
+#define DISTANCE_FIELD_ERROR (M_SQRT2 / (2.0 * DISTANCE_FIELD_RESOLUTION))
+
+/**
+ * \brief La fonction donne le nombre d'échantillons le plus grand d'une colonne ou d'une ligne, qui dimensionne la mémoire de travail
+ * \param field le champ
+ * \return le nombre d'échantillons
+ */
+static int distance_field_line_size(const distance_field_t *field) {
+    return MAX(field->sample_width, field->sample_height);
+}
+
+/**
+ * \brief La fonction donne la place qu'occupe dans l'arène le champ d'un niveau
+ * \param width la largeur du niveau, en cases
+ * \param height la hauteur du niveau, en cases
+ * \return la taille à réserver dans l'arène
+ */
+size_t distance_field_arena_size(int width, int height) {
+    size_t sample_width = (size_t)(width - 1) * DISTANCE_FIELD_RESOLUTION + 1, sample_height = (size_t)(height - 1) * DISTANCE_FIELD_RESOLUTION + 1;
+    size_t line_size = MAX(sample_width, sample_height);
+    return arena_allocation_size((size_t)width * height) + arena_allocation_size(sizeof(Uint16) * sample_width * sample_height) +
+           arena_allocation_size(sizeof(float) * PARALLEL_MAX_THREADS * line_size) +
+           arena_allocation_size(sizeof(float) * PARALLEL_MAX_THREADS * line_size) +
+           arena_allocation_size(sizeof(int) * PARALLEL_MAX_THREADS * line_size) +
+           arena_allocation_size(sizeof(double) * PARALLEL_MAX_THREADS * (line_size + 1));
+}
+
+/**
+ * \brief La fonction alloue le champ d'un niveau dans son arène, sans aucune case occupée
+ * \param field le champ
+ * \param arena l'arène du niveau
+ * \param width la largeur du niveau, en cases
+ * \param height la hauteur du niveau, en cases
+ */
+void init_distance_field(distance_field_t *field, arena_t *arena, int width, int height) {
+    field->width = width;
+    field->height = height;
+    field->sample_width = (width - 1) * DISTANCE_FIELD_RESOLUTION + 1;
+    field->sample_height = (height - 1) * DISTANCE_FIELD_RESOLUTION + 1;
+    field->origin_x = -width / 2.0 + 0.5;
+    field->origin_y = -(height - 1);
+    size_t line_size = distance_field_line_size(field);
+    field->occupied = arena_alloc(arena, (size_t)width * height);
+    memset(field->occupied, 0, (size_t)width * height);
+    field->distances = arena_alloc(arena, sizeof(Uint16) * field->sample_width * field->sample_height);
+    field->line_samples = arena_alloc(arena, sizeof(float) * PARALLEL_MAX_THREADS * line_size);
+    field->line_values = arena_alloc(arena, sizeof(float) * PARALLEL_MAX_THREADS * line_size);
+    field->parabolas = arena_alloc(arena, sizeof(int) * PARALLEL_MAX_THREADS * line_size);
+    field->boundaries = arena_alloc(arena, sizeof(double) * PARALLEL_MAX_THREADS * (line_size + 1));
+}
+
+/**
+ * \brief La fonction calcule en place la transformée de distance au carré d'une ligne d'échantillons, en temps linéaire, par l'enveloppe
+ * inférieure des paraboles centrées sur chaque échantillon (Felzenszwalb et Huttenlocher). Les échantillons infinis ne portent pas de parabole.
+ * \param line le premier échantillon de la ligne
+ * \param stride l'écart entre deux échantillons consécutifs
+ * \param n le nombre d'échantillons
+ * \param field le champ, qui fournit la mémoire de travail
+ * \param thread le numéro du fil de calcul
+ */
+static void distance_transform_line(float *line, ptrdiff_t stride, int n, const distance_field_t *field, int thread) {
+    size_t line_size = distance_field_line_size(field);
+    float *values = field->line_values + thread * line_size;
+    int *parabolas = field->parabolas + thread * line_size;
+    double *boundaries = field->boundaries + thread * (line_size + 1);
+    int k = -1;
+    for (int q = 0; q < n; q++) {
+        values[q] = line[q * stride];
+        if (values[q] == INFINITY) {
+            continue;
+        }
+        // Les paraboles entièrement cachées par la nouvelle sont retirées de l'enveloppe
+        double s = -INFINITY;
+        while (k >= 0) {
+            int p = parabolas[k];
+            s = ((values[q] + (double)q * q) - (values[p] + (double)p * p)) / (2.0 * (q - p));
+            if (s > boundaries[k]) {
+                break;
+            }
+            k--;
+        }
+        k++;
+        parabolas[k] = q;
+        boundaries[k] = k == 0 ? -INFINITY : s;
+    }
+    if (k < 0) {
+        return;
+    }
+    boundaries[k + 1] = INFINITY;
+    for (int q = 0, j = 0; q < n; q++) {
+        while (boundaries[j + 1] < q) {
+            j++;
+        }
+        int p = parabolas[j];
+        line[q * stride] = (float)(q - p) * (q - p) + values[p];
+    }
+}
+
+/**
+ * \brief La fonction indique si un échantillon est le centre d'une météorite fixe. Les centres des météorites tombent exactement sur un
+ * échantillon sur DISTANCE_FIELD_RESOLUTION.
+ * \param field le champ
+ * \param i la colonne de l'échantillon
+ * \param j la ligne de l'échantillon
+ * \return true si l'échantillon est occupé, false sinon
+ */
+static bool sample_occupied(const distance_field_t *field, int i, int j) {
+    return i % DISTANCE_FIELD_RESOLUTION == 0 && j % DISTANCE_FIELD_RESOLUTION == 0 &&
+           field->occupied[(size_t)j / DISTANCE_FIELD_RESOLUTION * field->width + i / DISTANCE_FIELD_RESOLUTION];
+}
+
+/**
+ * \brief La passe sur les colonnes, qui part des cases occupées : dans une colonne, la distance à l'échantillon occupé le plus proche est
+ * entière, et s'obtient par un parcours dans chaque sens. Elle est gardée en nombre d'échantillons, UINT16_MAX signifiant qu'aucun échantillon
+ * occupé n'est assez proche pour compter. Seules les lignes recalculées sont écrites ; le parcours ne va pas au-delà de DISTANCE_FIELD_SATURATION
+ * échantillons autour d'elles, où une case occupée ne compte plus.
+ * \param data le champ
+ * \param thread le numéro du fil de calcul, inutilisé
+ * \param first la première colonne d'échantillons
+ * \param last la colonne suivant la dernière
+ */
+static void distance_field_columns(void *data, int thread, int first, int last) {
+    (void)thread;
+    distance_field_t *field = data;
+    int sample_width = field->sample_width, update_first = field->update_first, update_last = field->update_last;
+    int scan_first = MAX(update_first - DISTANCE_FIELD_SATURATION, 0), scan_last = MIN(update_last + DISTANCE_FIELD_SATURATION, field->sample_height);
+    for (int i = first; i < last; i++) {
+        Uint16 *column = field->distances + i;
+        Uint32 distance = UINT16_MAX;
+        for (int j = scan_first; j < update_last; j++) {
+            distance = sample_occupied(field, i, j) ? 0 : MIN(distance + 1, UINT16_MAX);
+            if (j >= update_first) {
+                column[(size_t)j * sample_width] = distance;
+            }
+        }
+        distance = UINT16_MAX;
+        for (int j = scan_last - 1; j >= update_first; j--) {
+            Uint32 above = j < update_last ? column[(size_t)j * sample_width] : sample_occupied(field, i, j) ? 0 : UINT16_MAX;
+            distance = MIN(MIN(distance + 1, UINT16_MAX), above);
+            if (j < update_last) {
+                column[(size_t)j * sample_width] = distance;
+            }
+        }
+    }
+}
+
+/**
+ * \brief La passe sur les lignes, qui termine les distances et les enregistre sur 16 bits, arrondies par défaut. Une distance verticale
+ * saturée ne fausse que des distances qui dépassent de toute façon la saturation.
+ * \param data le champ
+ * \param thread le numéro du fil de calcul
+ * \param first la première ligne d'échantillons, comptée depuis la première ligne recalculée
+ * \param last la ligne suivant la dernière
+ */
+static void distance_field_rows(void *data, int thread, int first, int last) {
+    distance_field_t *field = data;
+    float *samples = field->line_samples + thread * distance_field_line_size(field);
+    for (int j = field->update_first + first; j < field->update_first + last; j++) {
+        Uint16 *row = field->distances + (size_t)j * field->sample_width;
+        for (int i = 0; i < field->sample_width; i++) {
+            samples[i] = row[i] == UINT16_MAX ? INFINITY : (float)row[i] * row[i];
+        }
+        distance_transform_line(samples, 1, field->sample_width, field, thread);
+        for (int i = 0; i < field->sample_width; i++) {
+            row[i] = MIN(floorf(sqrtf(samples[i]) * DISTANCE_FIELD_QUANTUM / DISTANCE_FIELD_RESOLUTION), (float)UINT16_MAX);
+        }
+    }
+}
+
+/**
+ * \brief La fonction calcule le champ à partir des cases occupées : une transformée de distance euclidienne exacte, séparable, en temps linéaire
+ * en le nombre d'échantillons, d'abord sur les colonnes puis sur les lignes, chaque passe étant répartie entre plusieurs fils
+ * \param field le champ, dont les cases occupées sont remplies
+ */
+void compute_distance_field(distance_field_t *field) {
+    update_distance_field(field, 0, field->height);
+}
+
+/**
+ * \brief La fonction recalcule le champ après une modification des cases occupées d'un groupe de lignes. Seuls les échantillons à moins de
+ * DISTANCE_FIELD_SATURATION de ces lignes peuvent changer : ce sont les seuls recalculés, avec les mêmes passes que le calcul complet.
+ * \param field le champ
+ * \param first_row la première ligne de cases modifiée
+ * \param last_row la ligne suivant la dernière modifiée
+ */
+void update_distance_field(distance_field_t *field, int first_row, int last_row) {
+    field->update_first = MAX(first_row * DISTANCE_FIELD_RESOLUTION - DISTANCE_FIELD_SATURATION, 0);
+    field->update_last = MIN((last_row - 1) * DISTANCE_FIELD_RESOLUTION + 1 + DISTANCE_FIELD_SATURATION, field->sample_height);
+    int rows = field->update_last - field->update_first;
+    int thread_count = parallel_thread_count((size_t)field->sample_width * rows, DISTANCE_FIELD_SAMPLES_PER_THREAD);
+    run_parallel(field->sample_width, thread_count, distance_field_columns, field);
+    run_parallel(rows, thread_count, distance_field_rows, field);
+}
+
+/**
+ * \brief La fonction donne un minorant de la distance d'un point au centre de la météorite fixe la plus proche, en temps constant. Hors de la
+ * grille, qui contient toutes les météorites, la distance est combinée avec celle du point à la grille.
+ * \param field le champ
+ * \param x l'abscisse du point
+ * \param y l'ordonnée du point
+ * \return la distance, inférieure d'au plus DISTANCE_FIELD_MAX_UNDERESTIMATE à la vraie, et d'au plus UINT16_MAX / DISTANCE_FIELD_QUANTUM cases
+ * dans la grille
+ */
+double static_meteorite_distance(const distance_field_t *field, double x, double y) {
+    if (field->distances == NULL) {
+        return INFINITY;
+    }
+    double sample_x = (x - field->origin_x) * DISTANCE_FIELD_RESOLUTION, sample_y = (y - field->origin_y) * DISTANCE_FIELD_RESOLUTION;
+    double grid_x = CLAMP(sample_x, 0.0, field->sample_width - 1.0), grid_y = CLAMP(sample_y, 0.0, field->sample_height - 1.0);
+    double nearest = field->distances[(size_t)(grid_y + 0.5) * field->sample_width + (size_t)(grid_x + 0.5)] / (double)DISTANCE_FIELD_QUANTUM;
+    double outside = hypot(sample_x - grid_x, sample_y - grid_y) / DISTANCE_FIELD_RESOLUTION;
+    return hypot(outside, MAX(nearest - DISTANCE_FIELD_ERROR, 0.0));
+}
+
+/**
+ * \brief La fonction oublie le champ, qui est rendu avec l'arène du niveau
+ * \param field le champ
+ */
+void clean_distance_field(distance_field_t *field) {
+    field->occupied = NULL;
+    field->distances = NULL;
+    field->line_samples = NULL;
+}
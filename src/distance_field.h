@@ -0,0 +1,83 @@
+/**
+ * \file distance_field.h
+ * \brief Fichier contenant le champ de distance du niveau, qui donne en temps constant la distance à la météorite fixe la plus proche
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#ifndef __DISTANCE_FIELD_H__
+#define __DISTANCE_FIELD_H__
+
+#include "arena.h"
+#include "parallel.h"
+#include <SDL.h>
+#include <math.h>
+#include <stdbool.h>
+
+/**
+ * \brief Nombre d'échantillons du champ par case du niveau, dans chaque direction
+ */
+#define DISTANCE_FIELD_RESOLUTION 2
+
+/**
+ * \brief Nombre de pas par case des distances enregistrées sur 16 bits : au-delà de UINT16_MAX / DISTANCE_FIELD_QUANTUM cases, soit près de
+ * 256, la distance est saturée
+ */
+#define DISTANCE_FIELD_QUANTUM 256
+
+/**
+ * \brief Distance, en échantillons, à partir de laquelle toute distance enregistrée est saturée : une case occupée plus loin d'un échantillon
+ * ne change pas sa valeur
+ */
+#define DISTANCE_FIELD_SATURATION (UINT16_MAX * DISTANCE_FIELD_RESOLUTION / DISTANCE_FIELD_QUANTUM + 1)
+
+/**
+ * \brief Écart maximal, en cases, entre la distance donnée par static_meteorite_distance et la vraie distance, qu'elle ne dépasse jamais :
+ * l'arrondi du point à l'échantillon le plus proche, compté deux fois (une fois dans l'échantillon, une fois retranché pour garder un
+ * minorant), plus un pas d'enregistrement. Il vaut environ 0,71 case.
+ */
+#define DISTANCE_FIELD_MAX_UNDERESTIMATE (M_SQRT2 / DISTANCE_FIELD_RESOLUTION + 1.0 / DISTANCE_FIELD_QUANTUM)
+
+/**
+ * \brief Nombre minimal d'échantillons par fil de calcul, en dessous duquel un fil supplémentaire coûte plus qu'il ne rapporte
+ */
+#define DISTANCE_FIELD_SAMPLES_PER_THREAD 65536
+
+/**
+ * \brief Champ de distance du niveau
+ *
+ * Les échantillons forment une grille de DISTANCE_FIELD_RESOLUTION pas par case, alignée sur les centres des météorites : l'échantillon (0, 0)
+ * est le centre de la case en haut à gauche. Seules les météorites qui ne se déplacent pas sont prises en compte ; les météorites mobiles
+ * restent cherchées dans leurs groupes. Chaque échantillon tient sur 16 bits, soit 8 octets par case du niveau.
+ */
+typedef struct distance_field_s {
+    int width;         /*!< Largeur du niveau, en cases */
+    int height;        /*!< Hauteur du niveau, en cases */
+    int sample_width;  /*!< Nombre d'échantillons par ligne */
+    int sample_height; /*!< Nombre de lignes d'échantillons */
+    double origin_x;   /*!< Position de l'échantillon (0, 0) dans le niveau */
+    double origin_y;
+    Uint8 *occupied;     /*!< Cases occupées par une météorite fixe, remplies par l'appelant */
+    Uint16 *distances;   /*!< Distance de chaque échantillon au centre de la météorite fixe la plus proche, en pas de DISTANCE_FIELD_QUANTUM */
+    float *line_samples; /*!< Mémoire de travail des fils de calcul : carrés des distances d'une ligne */
+    float *line_values;  /*!< Mémoire de travail : valeurs d'une ligne */
+    int *parabolas;      /*!< Mémoire de travail : sommets des paraboles de l'enveloppe inférieure */
+    double *boundaries;  /*!< Mémoire de travail : limites des paraboles de l'enveloppe inférieure */
+    int update_first;    /*!< Première ligne d'échantillons recalculée par le calcul en cours */
+    int update_last;     /*!< Ligne d'échantillons suivant la dernière recalculée */
+} distance_field_t;
+
+size_t distance_field_arena_size(int width, int height);
+
+void init_distance_field(distance_field_t *field, arena_t *arena, int width, int height);
+
+void compute_distance_field(distance_field_t *field);
+
+void update_distance_field(distance_field_t *field, int first_row, int last_row);
+
+double static_meteorite_distance(const distance_field_t *field, double x, double y);
+
+void clean_distance_field(distance_field_t *field);
+
+#endif
@@ -9,28 +9,155 @@
 #include "game.h"
 #include "constants.h"
 #include "level.h"
+#include "logger.h"
+#include "trace.h"
 #include "utilities.h"
+#include <string.h>
+#include <time.h>
 
+/**
+ * \brief Distance entre les centres du vaisseau et d'une météorite au-delà de laquelle leurs images, même tournées, ne peuvent pas se toucher
+ */
+#define COLLISION_DISTANCE ((SPACESHIP_SIZE + METEORITE_SIZE) * M_SQRT1_2)
+
+/**
+ * \brief Nombre maximal de vaisseaux testés ensemble contre les météorites : les joueurs et les fantômes
+ */
+#define SHIP_MAX_COUNT (PLAYER_MAX_COUNT + GHOST_MAX_COUNT)
+
+/**
+ * \brief La fonction ajoute un rect au journal, au niveau de débogage
+ * \param name le nom du rect
+ * \param rect le rect
+ */
 void print_rect(char *name, rect_t rect) {
-    printf("Rect \"%s\" : %gx%g%+g%+g\n", name, rect.w, rect.h, rect.x, rect.y);
+    LOG_DEBUG("Rect \"%s\" : %gx%g%+g%+g", name, rect.w, rect.h, rect.x, rect.y);
+}
+
+/**
+ * \brief La fonction construit le rect courant d'une météorite
+ * \param world les données du monde
+ * \param i l'indice de la météorite
+ * \return le rect de la météorite
+ */
+rect_t meteorite_rect(const world_t *world, size_t i) {
+    return (rect_t){world->meteorites.x[i], world->meteorites.y[i], METEORITE_SIZE, METEORITE_SIZE};
+}
+
+/**
+ * \brief La fonction construit le rect courant du vaisseau d'un joueur
+ * \param world les données du monde
+ * \param player le numéro du joueur
+ * \return le rect du vaisseau
+ */
+rect_t spaceship_rect(const world_t *world, int player) {
+    return (rect_t){world->spaceship_x[player], world->spaceship_y[player], SPACESHIP_SIZE, SPACESHIP_SIZE};
+}
+
+/**
+ * \brief La fonction donne l'inclinaison d'un vaisseau, proportionnelle à sa vitesse latérale
+ * \param speed_x la vitesse horizontale du vaisseau
+ * \return l'angle, en degrés dans le sens horaire, entre -SPACESHIP_MAX_BANK_ANGLE et SPACESHIP_MAX_BANK_ANGLE
+ */
+double spaceship_bank_angle(double speed_x) {
+    // La vitesse latérale limite est atteinte quand la traînée compense la poussée
+    return CLAMP(speed_x / (MOVING_SPEED / DRAG_COEFFICIENT), -1.0, 1.0) * SPACESHIP_MAX_BANK_ANGLE;
+}
+
+/**
+ * \brief La fonction choisit le masque de collision précalculé le plus proche de l'inclinaison d'un vaisseau
+ * \param resources les ressources
+ * \param speed_x la vitesse horizontale du vaisseau
+ * \return le masque
+ */
+static const collision_mask_t *spaceship_mask(const resources_t *resources, double speed_x) {
+    double position = (spaceship_bank_angle(speed_x) / SPACESHIP_MAX_BANK_ANGLE + 1.0) / 2.0;
+    return &resources->spaceship_masks[(int)round(position * (SPACESHIP_BANK_ANGLE_COUNT - 1))];
+}
+
+/**
+ * \brief La fonction choisit le masque de collision précalculé le plus proche de l'angle d'une météorite, tel qu'elle est dessinée
+ * \param resources les ressources
+ * \param angle l'angle de la météorite, en degrés dans le sens horaire, de 0 à 360
+ * \return le masque
+ */
+static const collision_mask_t *meteorite_mask(const resources_t *resources, double angle) {
+    double position = ((angle > 180.0 ? angle - 360.0 : angle) / 180.0 + 1.0) / 2.0;
+    return &resources->meteorite_masks[(int)round(CLAMP(position, 0.0, 1.0) * (METEORITE_ROTATION_COUNT - 1))];
+}
+
+/**
+ * \brief La fonction donne l'instant auquel calculer le mouvement des météorites. Il est compté depuis le début du niveau, pour que les fantômes
+ * retrouvent les météorites de leur course.
+ * \param world les données du monde
+ * \return l'instant, en secondes
+ */
+double meteorite_time(const world_t *world) {
+    return (world->playing_time - world->level_start_time) / 1000.0;
 }
 
 /**
  * \brief La fonction initialise les données du monde du jeu
  * \param exe_dir le chemin de l'exécutable, utilisé pour charger les ressources
+ * \param resources les ressources
  * \param world les données du monde
  */
-void init_data(const char *exe_dir, world_t *world) {
-    init_levels(exe_dir, world);
+void init_data(const char *exe_dir, resources_t *resources, world_t *world) {
+    init_levels(exe_dir, resources, world);
     world->game_state = GAME_STATE_STARTED;
     world->last_frame_time = SDL_GetTicks64();
+    world->fixed_frame_time = 0;
     world->splash_screen_sound_channel = -1;
     world->playing_time = 0;
+    world->level_start_time = 0;
     world->current_level = 0;
+    world->player_count = 1;
+    for (int p = 0; p < PLAYER_MAX_COUNT; p++) {
+        world->near_misses[p] = 0;
+        world->controllers[p] = NULL;
+    }
+    init_arena(&world->level_arena);
+    world->level_pixels = NULL;
+    world->overview = (overview_t){0};
+    world->zoom = 1.0;
+    world->telemetry = NULL;
+    world->records = NULL;
+    world->split_count = 0;
+    world->best_time = 0;
+    world->new_best = false;
+    world->level_loaded = false;
+    world->has_checkpoint = false;
+    world->practice = false;
+    init_ghosts(&world->ghosts, NULL);
+    init_particles(&world->particles);
+}
+
+/**
+ * \brief La fonction construit un évènement de télémétrie avec l'état courant de la partie
+ * \param world les données du monde
+ * \param type le type de l'évènement
+ * \param player le numéro du joueur concerné
+ * \return l'évènement
+ */
+static telemetry_event_t telemetry_event(const world_t *world, telemetry_event_type_t type, int player) {
+    return (telemetry_event_t){.type = type,
+                               .level = world->current_level,
+                               .player = player,
+                               .playing_time = world->playing_time,
+                               .x = world->spaceship_x[player],
+                               .y = world->spaceship_y[player],
+                               .meteorite = -1,
+                               .invincible = world->invincible};
 }
 
 void clean_playing_data(world_t *world) {
-    free(world->meteorite_rects);
+    world->level_loaded = false;
+    clean_meteorites(&world->meteorites);
+    clean_distance_field(&world->distance_field);
+    clean_overview(&world->overview);
+    world->level_pixels = NULL;
+    reset_arena(&world->level_arena);
+    clean_ghosts(&world->ghosts);
 }
 
 /**
@@ -38,9 +165,131 @@ void clean_playing_data(world_t *world) {
  * \param world les données du monde
  */
 void clean_data(world_t *world) {
-    if (world->game_state == GAME_STATE_PLAYING) {
+    if (world->level_loaded) {
         clean_playing_data(world);
     }
+    clean_particles(&world->particles);
+    clean_arena(&world->level_arena);
+    for (int p = 0; p < PLAYER_MAX_COUNT; p++) {
+        if (world->controllers[p] != NULL) {
+            SDL_GameControllerClose(world->controllers[p]);
+            world->controllers[p] = NULL;
+        }
+    }
+}
+
+/**
+ * \brief La fonction copie l'état du niveau en cours dans un point de passage. Elle n'alloue pas et ne copie que quelques kilo-octets.
+ * \param world les données du monde
+ * \param checkpoint le point de passage
+ */
+static void save_checkpoint(const world_t *world, level_checkpoint_t *checkpoint) {
+    const ghosts_t *ghosts = &world->ghosts;
+    checkpoint->level = world->current_level;
+    checkpoint->level_time = world->playing_time - world->level_start_time;
+    memcpy(checkpoint->spaceship_x, world->spaceship_x, sizeof(world->spaceship_x));
+    memcpy(checkpoint->spaceship_y, world->spaceship_y, sizeof(world->spaceship_y));
+    memcpy(checkpoint->spaceship_speed_x, world->spaceship_speed_x, sizeof(world->spaceship_speed_x));
+    memcpy(checkpoint->spaceship_speed_y, world->spaceship_speed_y, sizeof(world->spaceship_speed_y));
+    memcpy(checkpoint->camera_offset, world->camera_offset, sizeof(world->camera_offset));
+    memcpy(checkpoint->player_state, world->player_state, sizeof(world->player_state));
+    memcpy(checkpoint->finish_time, world->finish_time, sizeof(world->finish_time));
+    memcpy(checkpoint->near_miss, world->near_miss, sizeof(world->near_miss));
+    checkpoint->invincible = world->invincible;
+    checkpoint->used_invincibility = world->used_invincibility;
+    checkpoint->split_count = world->split_count;
+    memcpy(checkpoint->splits, world->splits, sizeof(world->splits));
+    memcpy(checkpoint->ghost_x, ghosts->x, sizeof(double) * ghosts->count);
+    memcpy(checkpoint->ghost_y, ghosts->y, sizeof(double) * ghosts->count);
+    memcpy(checkpoint->ghost_speed_x, ghosts->speed_x, sizeof(double) * ghosts->count);
+    memcpy(checkpoint->ghost_speed_y, ghosts->speed_y, sizeof(double) * ghosts->count);
+    memcpy(checkpoint->ghost_time, ghosts->time, sizeof(Uint64) * ghosts->count);
+    memcpy(checkpoint->ghost_step, ghosts->step, sizeof(size_t) * ghosts->count);
+    memcpy(checkpoint->ghost_state, ghosts->state, sizeof(Uint8) * ghosts->count);
+    checkpoint->recording_length = ghosts->recording.length;
+    checkpoint->recording_invalid = ghosts->recording_invalid;
+}
+
+/**
+ * \brief La fonction reprend le niveau chargé à un point de passage, sans rien recharger ni allouer. Le temps de jeu total continue : seule
+ * l'origine du niveau est déplacée, pour que les météorites mobiles et les fantômes retrouvent leurs positions du point de passage. La course
+ * enregistrée est tronquée au point de passage, dont elle a mené au même état.
+ * \param world les données du monde
+ * \param checkpoint le point de passage, du niveau courant
+ * \param practice indique si la course reprend en cours de niveau, et n'est alors plus conservée
+ */
+static void restore_checkpoint(world_t *world, const level_checkpoint_t *checkpoint, bool practice) {
+    ghosts_t *ghosts = &world->ghosts;
+    world->game_state = GAME_STATE_PLAYING;
+    world->screen_time = 0;
+    world->has_won = false;
+    world->level_start_time = world->playing_time - checkpoint->level_time;
+    memcpy(world->spaceship_x, checkpoint->spaceship_x, sizeof(world->spaceship_x));
+    memcpy(world->spaceship_y, checkpoint->spaceship_y, sizeof(world->spaceship_y));
+    memcpy(world->spaceship_speed_x, checkpoint->spaceship_speed_x, sizeof(world->spaceship_speed_x));
+    memcpy(world->spaceship_speed_y, checkpoint->spaceship_speed_y, sizeof(world->spaceship_speed_y));
+    memcpy(world->camera_offset, checkpoint->camera_offset, sizeof(world->camera_offset));
+    memcpy(world->player_state, checkpoint->player_state, sizeof(world->player_state));
+    memcpy(world->finish_time, checkpoint->finish_time, sizeof(world->finish_time));
+    memcpy(world->near_miss, checkpoint->near_miss, sizeof(world->near_miss));
+    world->invincible = checkpoint->invincible;
+    world->used_invincibility = checkpoint->used_invincibility;
+    world->split_count = checkpoint->split_count;
+    memcpy(world->splits, checkpoint->splits, sizeof(world->splits));
+    memcpy(ghosts->x, checkpoint->ghost_x, sizeof(double) * ghosts->count);
+    memcpy(ghosts->y, checkpoint->ghost_y, sizeof(double) * ghosts->count);
+    memcpy(ghosts->speed_x, checkpoint->ghost_speed_x, sizeof(double) * ghosts->count);
+    memcpy(ghosts->speed_y, checkpoint->ghost_speed_y, sizeof(double) * ghosts->count);
+    memcpy(ghosts->time, checkpoint->ghost_time, sizeof(Uint64) * ghosts->count);
+    memcpy(ghosts->step, checkpoint->ghost_step, sizeof(size_t) * ghosts->count);
+    memcpy(ghosts->state, checkpoint->ghost_state, sizeof(Uint8) * ghosts->count);
+    ghosts->recording.length = checkpoint->recording_length;
+    ghosts->recording_invalid = checkpoint->recording_invalid || practice;
+    world->practice = practice;
+    clear_particles(&world->particles);
+}
+
+/**
+ * \brief La fonction pose un point de passage à l'état courant du niveau, si tous les joueurs sont en course
+ * \param world les données du monde
+ */
+static void place_checkpoint(world_t *world) {
+    if (world->game_state != GAME_STATE_PLAYING) {
+        return;
+    }
+    for (int p = 0; p < world->player_count; p++) {
+        if (world->player_state[p] != PLAYER_RACING) {
+            return;
+        }
+    }
+    save_checkpoint(world, &world->checkpoint);
+    world->has_checkpoint = true;
+    LOG_INFO("Checkpoint at %.2f s", world->checkpoint.level_time / 1000.0);
+}
+
+/**
+ * \brief La fonction reprend le niveau chargé, en jeu ou depuis l'écran de défaite, au dernier point de passage ou à son début
+ * \param world les données du monde
+ * \param from_start indique si le niveau reprend à son début plutôt qu'au dernier point de passage
+ */
+static void retry_level(world_t *world, bool from_start) {
+    // Le niveau n'est chargé qu'en jeu et sur l'écran de défaite
+    if (!world->level_loaded) {
+        return;
+    }
+    TRACE_BEGIN(span);
+    Uint64 start = SDL_GetPerformanceCounter();
+    bool practice = !from_start && world->has_checkpoint;
+    const level_checkpoint_t *checkpoint = practice ? &world->checkpoint : &world->level_start;
+    restore_checkpoint(world, checkpoint, practice);
+    double duration = (SDL_GetPerformanceCounter() - start) * 1e6 / SDL_GetPerformanceFrequency();
+    TRACE_END(span, "retry_level");
+    for (int p = 0; p < world->player_count; p++) {
+        telemetry_event_t event = telemetry_event(world, TELEMETRY_RETRY, p);
+        record_telemetry_event(world->telemetry, &event);
+    }
+    LOG_INFO("Retry from %.2f s", checkpoint->level_time / 1000.0);
+    LOG_DEBUG("Niveau repris en %.1f µs", duration);
 }
 
 void transition_to_splash_screen(resources_t *resources, world_t *world) {
@@ -51,44 +300,115 @@ void transition_to_splash_screen(resources_t *resources, world_t *world) {
     world->splash_screen_sound_channel = play_sound(resources->splash_screen_sound);
 }
 
-void transition_to_playing(const char *exe_dir, resources_t *resources, world_t *world) {
+bool transition_to_playing(const char *exe_dir, resources_t *resources, world_t *world) {
     world->game_state = GAME_STATE_PLAYING;
-    world->camera_offset = INITIAL_CAMERA_OFFSET;
     world->has_won = false;
     world->invincible = false;
+    world->split_count = 0;
+    world->used_invincibility = false;
 
-    world->spaceship_rect = (rect_t){0.0, 0.0, SPACESHIP_SIZE, SPACESHIP_SIZE};
-    print_rect("spaceship", world->spaceship_rect);
-    world->spaceship_speed_x = 0.0;
-    world->spaceship_speed_y = 0.0;
-
-    init_level(exe_dir, resources, world);
+    // Les vaisseaux partent côte à côte, centrés sur la ligne de départ
+    for (int p = 0; p < world->player_count; p++) {
+        world->spaceship_x[p] = (p - (world->player_count - 1) / 2.0) * SPACESHIP_SIZE;
+        world->spaceship_y[p] = 0.0;
+        world->spaceship_speed_x[p] = 0.0;
+        world->spaceship_speed_y[p] = 0.0;
+        world->camera_offset[p] = INITIAL_CAMERA_OFFSET;
+        world->player_state[p] = PLAYER_RACING;
+        world->near_miss[p] = false;
+        world->finish_time[p] = 0;
+    }
+    print_rect("spaceship", spaceship_rect(world, 0));
+    clear_particles(&world->particles);
 
     stop_sound(world->splash_screen_sound_channel);
+    if (!init_level(exe_dir, resources, world)) {
+        // Sans niveau jouable, le jeu s'arrête plutôt que de simuler un niveau vide
+        clean_playing_data(world);
+        world->game_state = GAME_STATE_QUIT;
+        return false;
+    }
+    world->level_start_time = world->playing_time;
+    load_ghosts(&world->ghosts, world->current_level);
+    world->level_loaded = true;
+    world->has_checkpoint = false;
+    world->practice = false;
+    save_checkpoint(world, &world->level_start);
+    for (int p = 0; p < world->player_count; p++) {
+        telemetry_event_t event = telemetry_event(world, TELEMETRY_LEVEL_START, p);
+        record_telemetry_event(world->telemetry, &event);
+    }
+    return true;
+}
+
+/**
+ * \brief La fonction ajoute la course qui vient de terminer le niveau courant aux records, sauf si l'invincibilité a été utilisée
+ * \param world les données du monde
+ * \param ghost_saved indique si la course a été conservée parmi les fantômes du niveau
+ */
+static void record_level_run(world_t *world, bool ghost_saved) {
+    Uint64 level_time = world->playing_time - world->level_start_time;
+    // Les temps de passage non atteints, sur un niveau trop court, prennent le temps final
+    for (int split = world->split_count; split < RECORDS_SPLIT_COUNT; split++) {
+        world->splits[split] = level_time;
+    }
+    world->split_count = RECORDS_SPLIT_COUNT;
+    world->new_best = false;
+    if (!world->used_invincibility && !world->practice) {
+        record_t record = {.level = world->current_level, .time = level_time, .date = (Sint64)time(NULL)};
+        memcpy(record.splits, world->splits, sizeof(record.splits));
+        if (ghost_saved) {
+            format_ghost_run_reference(world->current_level, level_time, record.replay, sizeof(record.replay));
+        }
+        world->new_best = submit_record(world->records, &record);
+    }
+    const record_t *best = best_record(world->records, world->current_level);
+    world->best_time = best != NULL ? best->time : 0;
+    if (world->new_best) {
+        LOG_INFO("Level %d: %.2f s, new best!", world->current_level + 1, level_time / 1000.0);
+    } else if (best != NULL) {
+        LOG_INFO("Level %d: %.2f s, best %.2f s", world->current_level + 1, level_time / 1000.0, best->time / 1000.0);
+    }
+}
+
+/**
+ * \brief La fonction enregistre la course du joueur seul qui vient de terminer le niveau courant, parmi les fantômes et les records. Les
+ * courses à plusieurs ne sont pas conservées.
+ * \param world les données du monde
+ */
+static void save_level_run(world_t *world) {
+    if (world->player_count == 1) {
+        record_level_run(world, save_ghost_run(&world->ghosts, world->current_level, world->playing_time - world->level_start_time));
+    }
 }
 
 void transition_to_level_complete_screen(world_t *world) {
     world->game_state = GAME_STATE_LEVEL_COMPLETE_SCREEN;
     world->screen_time = 0;
+    save_level_run(world);
     clean_playing_data(world);
-    printf("Level %d complete!\n", world->current_level + 1);
+    LOG_INFO("Level %d complete!", world->current_level + 1);
 }
 
-void transition_to_end_screen_loss(resources_t *resources, world_t *world) {
+/**
+ * \brief La fonction passe à l'écran de défaite. Le niveau reste chargé, pour pouvoir être repris depuis cet écran ; il est libéré à la fin du jeu.
+ * \param world les données du monde
+ */
+void transition_to_end_screen_loss(world_t *world) {
     world->game_state = GAME_STATE_END_SCREEN;
     world->screen_time = 0;
     world->has_won = false;
-    clean_playing_data(world);
-    printf("You lost!\n");
-    play_sound(resources->loss_sound);
+    LOG_INFO("You lost!");
 }
 
 void transition_to_end_screen_win(resources_t *resources, world_t *world) {
     world->game_state = GAME_STATE_END_SCREEN;
     world->screen_time = 0;
     world->has_won = true;
-    free(world->meteorite_rects);
-    printf("You finished in %.2f s!\n", world->playing_time / 1000.0);
+    save_level_run(world);
+    clean_playing_data(world);
+    LOG_INFO("You finished in %.2f s!", world->playing_time / 1000.0);
+    mark_audio_event(&resources->audio);
     play_sound(resources->win_sound);
 }
 
@@ -97,108 +417,461 @@ void transition_to_quit(world_t *world) {
 }
 
 /**
- * \brief La fonction met à jour les données en tenant compte de la physique du monde
- * \param exe_dir le chemin de l'exécutable, utilisé pour charger les ressources
+ * \brief Cherche les collisions entre des vaisseaux et les météorites. Chaque vaisseau actif couvre une bande verticale ; les bandes sont
+ * triées puis fusionnées quand elles se chevauchent, comme les vues dans snapshot.c, pour que des vaisseaux éloignés ne mettent pas à jour
+ * toutes les météorites entre eux. Chaque groupe d'une bande est testé contre chacun des vaisseaux, sauf les groupes sans météorite qui se
+ * déplace pour les vaisseaux que le champ de distance place loin des météorites fixes.
  * \param resources les ressources
  * \param world les données du monde
+ * \param count le nombre de vaisseaux, au plus SHIP_MAX_COUNT
+ * \param x les abscisses des vaisseaux
+ * \param y les ordonnées des vaisseaux
+ * \param speed_x les vitesses horizontales des vaisseaux, qui choisissent leurs masques
+ * \param active les vaisseaux à tester
+ * \param hits l'indice de la météorite percutée par chaque vaisseau, ou -1
  */
-void update_data(const char *exe_dir, resources_t *resources, world_t *world) {
-    world->time_since_last_frame = SDL_GetTicks64() - world->last_frame_time;
-    world->last_frame_time = SDL_GetTicks64();
+static void ships_collide_meteorites(const resources_t *resources, world_t *world, int count, const double *x, const double *y,
+                                     const double *speed_x, const bool *active, Sint64 *hits) {
+    double min_y[SHIP_MAX_COUNT], max_y[SHIP_MAX_COUNT];
+    bool static_clear[SHIP_MAX_COUNT];
+    int band_count = 0;
+    for (int s = 0; s < count; s++) {
+        hits[s] = -1;
+        if (!active[s]) {
+            continue;
+        }
+        static_clear[s] = static_meteorite_distance(&world->distance_field, x[s], y[s]) > COLLISION_DISTANCE;
+        // Insertion à sa place dans les bandes triées par début
+        double band_min = y[s] - SPACESHIP_SIZE / 2, band_max = y[s] + SPACESHIP_SIZE / 2;
+        int i = band_count++;
+        while (i > 0 && min_y[i - 1] > band_min) {
+            min_y[i] = min_y[i - 1];
+            max_y[i] = max_y[i - 1];
+            i--;
+        }
+        min_y[i] = band_min;
+        max_y[i] = band_max;
+    }
+    int merged = 0;
+    for (int i = 0; i < band_count; i++) {
+        if (merged > 0 && min_y[i] <= max_y[merged - 1]) {
+            max_y[merged - 1] = MAX(max_y[merged - 1], max_y[i]);
+        } else {
+            min_y[merged] = min_y[i];
+            max_y[merged] = max_y[i];
+            merged++;
+        }
+    }
 
-    if (world->game_state == GAME_STATE_STARTED) {
-        transition_to_splash_screen(resources, world);
-    } else if (world->game_state == GAME_STATE_SPLASH_SCREEN) {
-        world->screen_time += world->time_since_last_frame;
-        if (world->screen_time >= 3000) {
-            transition_to_playing(exe_dir, resources, world);
+    meteorites_t *meteorites = &world->meteorites;
+    // Un groupe à cheval sur deux bandes n'est parcouru qu'une fois
+    size_t next_chunk = 0;
+    for (int b = 0; b < merged; b++) {
+        update_meteorites(meteorites, meteorite_time(world), min_y[b], max_y[b], world->level_width);
+        size_t c = MAX(find_meteorite_chunk(meteorites, min_y[b]), next_chunk);
+        for (; c < meteorites->chunk_count && meteorites->chunks[c].min_y <= max_y[b]; c++) {
+            meteorite_chunk_t *chunk = &meteorites->chunks[c];
+            for (int s = 0; s < count; s++) {
+                rect_t ship_rect = {x[s], y[s], SPACESHIP_SIZE, SPACESHIP_SIZE};
+                if (!active[s] || hits[s] >= 0 || (static_clear[s] && !chunk->moving) || chunk->max_y < ship_rect.y - ship_rect.h / 2 ||
+                    chunk->min_y > ship_rect.y + ship_rect.h / 2 || chunk->max_x < ship_rect.x - ship_rect.w / 2 ||
+                    chunk->min_x > ship_rect.x + ship_rect.w / 2) {
+                    continue;
+                }
+                for (size_t i = chunk->start; i < chunk->end; i++) {
+                    if (objects_collide(spaceship_mask(resources, speed_x[s]), ship_rect, meteorite_mask(resources, meteorites->angle[i]),
+                                        meteorite_rect(world, i))) {
+                        hits[s] = i;
+                        break;
+                    }
+                }
+            }
         }
-    } else if (world->game_state == GAME_STATE_PLAYING) {
-        world->playing_time += world->time_since_last_frame;
+        next_chunk = c;
+    }
+}
 
-        // Mise à jour de l'accélération, la vitesse et la position du vaisseau
+/**
+ * \brief La fonction arrête un joueur qui franchit la ligne d'arrivée
+ * \param world les données du monde
+ * \param player le numéro du joueur
+ */
+static void finish_player(world_t *world, int player) {
+    world->player_state[player] = PLAYER_FINISHED;
+    world->finish_time[player] = world->playing_time - world->level_start_time;
+    telemetry_event_t event = telemetry_event(world, TELEMETRY_LEVEL_FINISH, player);
+    record_telemetry_event(world->telemetry, &event);
+    emit_burst(&world->particles, world->spaceship_x[player], world->spaceship_y[player]);
+}
 
-        double space_acceleration_x = 0.0;
-        double space_acceleration_y = 0.0;
+/**
+ * \brief La fonction arrête un joueur qui percute une météorite
+ * \param resources les ressources
+ * \param world les données du monde
+ * \param player le numéro du joueur
+ * \param meteorite l'indice de la météorite percutée
+ */
+static void crash_player(resources_t *resources, world_t *world, int player, size_t meteorite) {
+    world->player_state[player] = PLAYER_CRASHED;
+    telemetry_event_t event = telemetry_event(world, TELEMETRY_DEATH, player);
+    event.meteorite = meteorite;
+    record_telemetry_event(world->telemetry, &event);
+    emit_debris(&world->particles, world->spaceship_x[player], world->spaceship_y[player]);
+    mark_audio_event(&resources->audio);
+    play_sound(resources->loss_sound);
+}
 
-        space_acceleration_y -= CRUSING_SPEED;
+/**
+ * \brief Teste les vaisseaux des joueurs contre la ligne d'arrivée, puis ceux des joueurs et des fantômes en course contre les météorites,
+ * ensemble, bande par bande. Les fantômes qui percutent une météorite, ce qui arrive quand le niveau a changé depuis leur course, sont arrêtés.
+ * \param resources les ressources
+ * \param world les données du monde
+ */
+static void collide_ships(resources_t *resources, world_t *world) {
+    for (int p = 0; p < world->player_count; p++) {
+        if (world->player_state[p] == PLAYER_RACING && objects_collide(spaceship_mask(resources, world->spaceship_speed_x[p]), spaceship_rect(world, p),
+                                                                       &resources->finish_line_mask, world->finish_line_rect)) {
+            finish_player(world, p);
+        }
+    }
 
-        // Gestion des mouvements avec les touches du clavier
-        const Uint8 *keystate = SDL_GetKeyboardState(NULL);
-        if (keystate[SDL_SCANCODE_LEFT] || keystate[SDL_SCANCODE_A] || keystate[SDL_SCANCODE_Q]) {
-            space_acceleration_x -= MOVING_SPEED;
+    // Les joueurs occupent les premiers emplacements, les fantômes les suivants
+    double x[SHIP_MAX_COUNT], y[SHIP_MAX_COUNT], speed_x[SHIP_MAX_COUNT];
+    bool active[SHIP_MAX_COUNT];
+    Sint64 hits[SHIP_MAX_COUNT];
+    int player_count = world->player_count, count = player_count + world->ghosts.count;
+    for (int p = 0; p < player_count; p++) {
+        x[p] = world->spaceship_x[p];
+        y[p] = world->spaceship_y[p];
+        speed_x[p] = world->spaceship_speed_x[p];
+        active[p] = world->player_state[p] == PLAYER_RACING && !world->invincible;
+    }
+    for (int g = 0; g < world->ghosts.count; g++) {
+        x[player_count + g] = world->ghosts.x[g];
+        y[player_count + g] = world->ghosts.y[g];
+        speed_x[player_count + g] = world->ghosts.speed_x[g];
+        active[player_count + g] = world->ghosts.state[g] == GHOST_RACING;
+    }
+    ships_collide_meteorites(resources, world, count, x, y, speed_x, active, hits);
+    for (int p = 0; p < player_count; p++) {
+        if (hits[p] >= 0) {
+            crash_player(resources, world, p, hits[p]);
         }
-        if (keystate[SDL_SCANCODE_RIGHT] || keystate[SDL_SCANCODE_D]) {
-            space_acceleration_x += MOVING_SPEED;
+    }
+    for (int g = 0; g < world->ghosts.count; g++) {
+        if (hits[player_count + g] >= 0) {
+            world->ghosts.state[g] = GHOST_CRASHED;
         }
-        if (keystate[SDL_SCANCODE_UP] || keystate[SDL_SCANCODE_W] || keystate[SDL_SCANCODE_Z]) {
-            space_acceleration_y -= MOVING_SPEED;
+    }
+}
+
+/**
+ * \brief Calcule la distance du vaisseau d'un joueur à la météorite la plus proche, qui règle le bourdonnement et compte les frôlements. Le
+ * champ de distance ne donne qu'un minorant pour les météorites fixes : au-delà du rayon, elles sont ignorées sans parcourir leurs groupes ;
+ * en deçà, les groupes proches sont tous parcourus pour une distance exacte. Sinon, seuls les groupes proches contenant des météorites qui
+ * se déplacent sont parcourus.
+ * \param world les données du monde
+ * \param player le numéro du joueur
+ * \param radius la distance au-delà de laquelle les météorites sont ignorées
+ * \return la distance entre les centres, au plus radius
+ */
+static double nearest_meteorite_distance(world_t *world, int player, double radius) {
+    rect_t ship_rect = spaceship_rect(world, player);
+    double bound = static_meteorite_distance(&world->distance_field, ship_rect.x, ship_rect.y);
+    bool near_static = bound < radius;
+    double nearest = radius;
+    meteorites_t *meteorites = &world->meteorites;
+    double min_y = ship_rect.y - nearest, max_y = ship_rect.y + nearest;
+    update_meteorites(meteorites, meteorite_time(world), min_y, max_y, world->level_width);
+    for (size_t c = find_meteorite_chunk(meteorites, min_y); c < meteorites->chunk_count && meteorites->chunks[c].min_y <= max_y; c++) {
+        meteorite_chunk_t *chunk = &meteorites->chunks[c];
+        if ((!chunk->moving && !near_static) || chunk->max_x < ship_rect.x - nearest || chunk->min_x > ship_rect.x + nearest) {
+            continue;
         }
-        if (keystate[SDL_SCANCODE_DOWN] || keystate[SDL_SCANCODE_S]) {
-            space_acceleration_y += MOVING_SPEED;
+        for (size_t i = chunk->start; i < chunk->end; i++) {
+            nearest = MIN(nearest, hypot(meteorites->x[i] - ship_rect.x, meteorites->y[i] - ship_rect.y));
         }
+    }
+    return nearest;
+}
 
-        space_acceleration_x -= world->spaceship_speed_x * DRAG_COEFFICIENT;
-        space_acceleration_y -= world->spaceship_speed_y * DRAG_COEFFICIENT;
+/**
+ * \brief Compte les frôlements d'un joueur : un frôlement commence sous NEAR_MISS_DISTANCE et n'est compté que lorsque le vaisseau s'est
+ * éloigné au-delà de NEAR_MISS_RELEASE, c'est-à-dire qu'il a survécu. Les frôlements en mode invincible ne comptent pas.
+ * \param world les données du monde
+ * \param player le numéro du joueur
+ * \param nearest la distance à la météorite la plus proche
+ */
+static void update_near_misses(world_t *world, int player, double nearest) {
+    if (!world->near_miss[player] && nearest < NEAR_MISS_DISTANCE) {
+        world->near_miss[player] = true;
+    } else if (world->near_miss[player] && nearest > NEAR_MISS_RELEASE) {
+        world->near_miss[player] = false;
+        if (!world->invincible) {
+            world->near_misses[player]++;
+            telemetry_event_t event = telemetry_event(world, TELEMETRY_NEAR_MISS, player);
+            record_telemetry_event(world->telemetry, &event);
+        }
+    }
+}
 
-        world->spaceship_speed_x += space_acceleration_x * world->time_since_last_frame;
-        world->spaceship_speed_y += space_acceleration_y * world->time_since_last_frame;
+/**
+ * \brief Touches de déplacement de chaque joueur à plusieurs (gauche, droite, haut, bas) : flèches, WASD (ZQSD sur un clavier AZERTY), TFGH et
+ * pavé numérique
+ */
+static const SDL_Scancode player_keys[PLAYER_MAX_COUNT][4] = {
+    {SDL_SCANCODE_LEFT, SDL_SCANCODE_RIGHT, SDL_SCANCODE_UP, SDL_SCANCODE_DOWN},
+    {SDL_SCANCODE_A, SDL_SCANCODE_D, SDL_SCANCODE_W, SDL_SCANCODE_S},
+    {SDL_SCANCODE_F, SDL_SCANCODE_H, SDL_SCANCODE_T, SDL_SCANCODE_G},
+    {SDL_SCANCODE_KP_4, SDL_SCANCODE_KP_6, SDL_SCANCODE_KP_8, SDL_SCANCODE_KP_5},
+};
 
-        world->spaceship_rect.x += world->spaceship_speed_x * world->time_since_last_frame;
-        world->spaceship_rect.y += world->spaceship_speed_y * world->time_since_last_frame;
+/**
+ * \brief La fonction lit l'état des touches de déplacement du clavier pour un joueur seul, qui peut utiliser toutes les dispositions
+ * \param keystate l'état du clavier
+ * \return le masque des touches enfoncées
+ */
+static Uint8 read_keyboard_input(const Uint8 *keystate) {
+    Uint8 input = 0;
+    if (keystate[SDL_SCANCODE_LEFT] || keystate[SDL_SCANCODE_A] || keystate[SDL_SCANCODE_Q]) {
+        input |= INPUT_LEFT;
+    }
+    if (keystate[SDL_SCANCODE_RIGHT] || keystate[SDL_SCANCODE_D]) {
+        input |= INPUT_RIGHT;
+    }
+    if (keystate[SDL_SCANCODE_UP] || keystate[SDL_SCANCODE_W] || keystate[SDL_SCANCODE_Z]) {
+        input |= INPUT_UP;
+    }
+    if (keystate[SDL_SCANCODE_DOWN] || keystate[SDL_SCANCODE_S]) {
+        input |= INPUT_DOWN;
+    }
+    return input;
+}
 
-        world->spaceship_rect.x =
-            CLAMP(world->spaceship_rect.x, -world->level_width / 2 + world->spaceship_rect.w / 2, world->level_width / 2 - world->spaceship_rect.w / 2);
+/**
+ * \brief La fonction lit la croix directionnelle et le stick gauche d'une manette
+ * \param controller la manette, ou NULL
+ * \return le masque des directions enfoncées
+ */
+static Uint8 read_controller_input(SDL_GameController *controller) {
+    if (controller == NULL) {
+        return 0;
+    }
+    int axis_x = SDL_GameControllerGetAxis(controller, SDL_CONTROLLER_AXIS_LEFTX), axis_y = SDL_GameControllerGetAxis(controller, SDL_CONTROLLER_AXIS_LEFTY);
+    Uint8 input = 0;
+    if (SDL_GameControllerGetButton(controller, SDL_CONTROLLER_BUTTON_DPAD_LEFT) || axis_x < -CONTROLLER_DEAD_ZONE) {
+        input |= INPUT_LEFT;
+    }
+    if (SDL_GameControllerGetButton(controller, SDL_CONTROLLER_BUTTON_DPAD_RIGHT) || axis_x > CONTROLLER_DEAD_ZONE) {
+        input |= INPUT_RIGHT;
+    }
+    if (SDL_GameControllerGetButton(controller, SDL_CONTROLLER_BUTTON_DPAD_UP) || axis_y < -CONTROLLER_DEAD_ZONE) {
+        input |= INPUT_UP;
+    }
+    if (SDL_GameControllerGetButton(controller, SDL_CONTROLLER_BUTTON_DPAD_DOWN) || axis_y > CONTROLLER_DEAD_ZONE) {
+        input |= INPUT_DOWN;
+    }
+    return input;
+}
 
-        // Mise à jour de la position de la caméra (décroissance exponentielle vets la position du vaisseau)
-        world->camera_offset +=
-            (-world->spaceship_rect.y + INITIAL_CAMERA_OFFSET - world->camera_offset) * (1.0 - exp(-CAMERA_APPROACH_RATE * world->time_since_last_frame));
+/**
+ * \brief La fonction lit les touches de déplacement de chaque joueur, au clavier et à la manette. Un joueur seul utilise toutes les touches ;
+ * à plusieurs, chacun a les siennes (player_keys) et la manette de son numéro.
+ * \param world les données du monde
+ * \param inputs les masques des touches enfoncées, un par joueur
+ */
+void read_player_inputs(const world_t *world, Uint8 *inputs) {
+    const Uint8 *keystate = SDL_GetKeyboardState(NULL);
+    if (world->player_count == 1) {
+        inputs[0] = read_keyboard_input(keystate) | read_controller_input(world->controllers[0]);
+        return;
+    }
+    for (int p = 0; p < world->player_count; p++) {
+        const SDL_Scancode *keys = player_keys[p];
+        inputs[p] = read_controller_input(world->controllers[p]);
+        inputs[p] |= (keystate[keys[0]] ? INPUT_LEFT : 0) | (keystate[keys[1]] ? INPUT_RIGHT : 0) | (keystate[keys[2]] ? INPUT_UP : 0) |
+                     (keystate[keys[3]] ? INPUT_DOWN : 0);
+    }
+}
 
-        do {
-            // Collision avec la ligne d'arrivée
-            if (objects_collide(resources->spaceship_surface, world->spaceship_rect, resources->finish_line_surface, world->finish_line_rect)) {
-                if (world->current_level == world->level_count - 1) {
-                    transition_to_end_screen_win(resources, world);
-                    break;
-                } else {
-                    transition_to_level_complete_screen(world);
-                    break;
-                }
-            }
+/**
+ * \brief La fonction fait avancer des vaisseaux d'un pas chacun, selon leurs touches enfoncées. Les vaisseaux sont stockés en tableaux et la
+ * boucle est sans branchement, pour que le joueur et tous les fantômes soient simulés par le même code vectorisable.
+ * \param count le nombre de vaisseaux
+ * \param inputs les masques des touches enfoncées
+ * \param durations les durées des pas, en ms (un pas nul laisse le vaisseau en place)
+ * \param level_width la largeur du niveau
+ * \param x les abscisses
+ * \param y les ordonnées
+ * \param speed_x les vitesses horizontales
+ * \param speed_y les vitesses verticales
+ */
+void move_spaceships(size_t count, const Uint8 *inputs, const double *durations, double level_width, double *restrict x, double *restrict y,
+                     double *restrict speed_x, double *restrict speed_y) {
+    double min_x = -level_width / 2 + SPACESHIP_SIZE / 2, max_x = level_width / 2 - SPACESHIP_SIZE / 2;
+    for (size_t i = 0; i < count; i++) {
+        double left = (inputs[i] & INPUT_LEFT) != 0, right = (inputs[i] & INPUT_RIGHT) != 0;
+        double up = (inputs[i] & INPUT_UP) != 0, down = (inputs[i] & INPUT_DOWN) != 0;
+        double acceleration_x = (right - left) * MOVING_SPEED - speed_x[i] * DRAG_COEFFICIENT;
+        double acceleration_y = (down - up) * MOVING_SPEED - CRUSING_SPEED - speed_y[i] * DRAG_COEFFICIENT;
+        speed_x[i] += acceleration_x * durations[i];
+        speed_y[i] += acceleration_y * durations[i];
+        x[i] = CLAMP(x[i] + speed_x[i] * durations[i], min_x, max_x);
+        y[i] += speed_y[i] * durations[i];
+    }
+}
 
-            if (!world->invincible) {
-                // Collision entre le vaisseau et les météorites
-                for (size_t i = 0; i < world->meteorites_count; i++) {
-                    if (objects_collide(resources->spaceship_surface, world->spaceship_rect, resources->meteorite_surface, world->meteorite_rects[i])) {
-                        transition_to_end_screen_loss(resources, world);
-                        break;
-                    }
-                }
+/**
+ * \brief La fonction termine le niveau quand plus aucun joueur n'est en course : il est réussi si au moins un joueur a franchi la ligne d'arrivée
+ * \param resources les ressources
+ * \param world les données du monde
+ */
+static void end_level_when_stopped(resources_t *resources, world_t *world) {
+    bool finished = false;
+    for (int p = 0; p < world->player_count; p++) {
+        if (world->player_state[p] == PLAYER_RACING) {
+            return;
+        }
+        finished |= world->player_state[p] == PLAYER_FINISHED;
+    }
+    if (!finished) {
+        transition_to_end_screen_loss(world);
+    } else if (world->current_level == world->level_count - 1) {
+        transition_to_end_screen_win(resources, world);
+    } else {
+        transition_to_level_complete_screen(world);
+    }
+}
+
+/**
+ * \brief La fonction met à jour les données en tenant compte de la physique du monde
+ * \param exe_dir le chemin de l'exécutable, utilisé pour charger les ressources
+ * \param resources les ressources
+ * \param world les données du monde
+ * \param inputs les masques des touches de déplacement enfoncées, un par joueur
+ */
+void update_data(const char *exe_dir, resources_t *resources, world_t *world, const Uint8 *inputs) {
+    if (world->fixed_frame_time != 0) {
+        world->time_since_last_frame = world->fixed_frame_time;
+        world->last_frame_time += world->fixed_frame_time;
+    } else {
+        world->time_since_last_frame = SDL_GetTicks64() - world->last_frame_time;
+        world->last_frame_time = SDL_GetTicks64();
+    }
+
+    if (world->game_state == GAME_STATE_STARTED) {
+        transition_to_splash_screen(resources, world);
+    } else if (world->game_state == GAME_STATE_SPLASH_SCREEN) {
+        world->screen_time += world->time_since_last_frame;
+        if (world->screen_time >= SCREEN_DURATION) {
+            transition_to_playing(exe_dir, resources, world);
+        }
+    } else if (world->game_state == GAME_STATE_PLAYING) {
+        world->playing_time += world->time_since_last_frame;
+        telemetry_event_t frame_event = telemetry_event(world, TELEMETRY_FRAME_SUMMARY, 0);
+        record_telemetry_frame(world->telemetry, &frame_event, world->time_since_last_frame);
+
+        // Mise à jour de l'accélération, la vitesse et la position des vaisseaux ; ceux des joueurs arrêtés ne bougent plus
+        double durations[PLAYER_MAX_COUNT];
+        for (int p = 0; p < world->player_count; p++) {
+            durations[p] = world->player_state[p] == PLAYER_RACING ? world->time_since_last_frame : 0.0;
+        }
+        move_spaceships(world->player_count, inputs, durations, world->level_width, world->spaceship_x, world->spaceship_y, world->spaceship_speed_x,
+                        world->spaceship_speed_y);
+        for (int p = 0; p < world->player_count; p++) {
+            if (world->player_state[p] == PLAYER_RACING) {
+                emit_exhaust(&world->particles, world->spaceship_x[p], world->spaceship_y[p] + SPACESHIP_SIZE / 2, world->spaceship_speed_x[p],
+                             world->spaceship_speed_y[p], CLAMP(-world->spaceship_speed_y[p] / MAX_USUAL_SPEED, 0.0, 1.0), durations[p]);
             }
-        } while (false);
+            // Mise à jour de la position de la caméra (décroissance exponentielle vets la position du vaisseau)
+            world->camera_offset[p] += (-world->spaceship_y[p] + INITIAL_CAMERA_OFFSET - world->camera_offset[p]) *
+                                       (1.0 - exp(-CAMERA_APPROACH_RATE * world->time_since_last_frame));
+        }
+
+        // Les fantômes rejoignent le temps de course du joueur, qui n'est enregistré que s'il joue seul
+        if (world->player_count == 1) {
+            record_ghost_step(&world->ghosts, inputs[0], world->time_since_last_frame);
+        }
+        update_ghosts(&world->ghosts, world->playing_time - world->level_start_time, world->level_width);
+
+        // Temps de passage à chaque quart du niveau
+        double progress = world->spaceship_y[0] / world->finish_line_rect.y;
+        while (world->player_count == 1 && world->split_count < RECORDS_SPLIT_COUNT - 1 && progress * RECORDS_SPLIT_COUNT >= world->split_count + 1) {
+            world->splits[world->split_count++] = world->playing_time - world->level_start_time;
+        }
+
+        collide_ships(resources, world);
+        end_level_when_stopped(resources, world);
     } else if (world->game_state == GAME_STATE_LEVEL_COMPLETE_SCREEN) {
         world->screen_time += world->time_since_last_frame;
-        if (world->screen_time >= 3000) {
+        if (world->screen_time >= SCREEN_DURATION) {
             world->current_level++;
             transition_to_playing(exe_dir, resources, world);
         }
     } else if (world->game_state == GAME_STATE_END_SCREEN) {
         world->screen_time += world->time_since_last_frame;
-        if (world->screen_time >= 3000) {
+        if (world->screen_time >= SCREEN_DURATION) {
             transition_to_quit(world);
         }
     }
+
+    // Les particules continuent d'évoluer sur les écrans de fin
+    update_particles(&world->particles, world->time_since_last_frame);
+
+    // Frôlements, et intensité des effets sonores, lue par le fil audio : celle du joueur le plus exposé
+    if (world->game_state == GAME_STATE_PLAYING) {
+        double nearest = AUDIO_HUM_RADIUS, speed = 0.0;
+        for (int p = 0; p < world->player_count; p++) {
+            if (world->player_state[p] == PLAYER_RACING) {
+                double distance = nearest_meteorite_distance(world, p, AUDIO_HUM_RADIUS);
+                update_near_misses(world, p, distance);
+                nearest = MIN(nearest, distance);
+                speed = MAX(speed, CLAMP(-world->spaceship_speed_y[p] / MAX_USUAL_SPEED, 0.0, 1.0));
+            }
+        }
+        set_audio_effects(&resources->audio, 1.0 - nearest / AUDIO_HUM_RADIUS, speed);
+    } else {
+        set_audio_effects(&resources->audio, 0.0, 0.0);
+    }
+}
+
+/**
+ * \brief La fonction indique si l'image du monde reste fixe jusqu'à une échéance, ce qui est le cas des écrans hors jeu une fois leurs
+ * particules éteintes
+ * \param world les données du monde
+ * \return le temps restant avant la fin de l'écran courant, en ms, ou 0 si l'image peut changer à chaque frame
+ */
+Uint64 idle_time_left(const world_t *world) {
+    bool screen = world->game_state == GAME_STATE_SPLASH_SCREEN || world->game_state == GAME_STATE_LEVEL_COMPLETE_SCREEN ||
+                  world->game_state == GAME_STATE_END_SCREEN;
+    if (!screen || live_particle_count(&world->particles) > 0 || world->screen_time >= SCREEN_DURATION) {
+        return 0;
+    }
+    return SCREEN_DURATION - world->screen_time;
+}
+
+/**
+ * \brief La fonction passe l'écran de démarrage, si c'est l'écran courant
+ * \param exe_dir le chemin de l'exécutable, utilisé pour charger les ressources
+ * \param resources les ressources
+ * \param world les données du monde
+ */
+void skip_splash_screen(const char *exe_dir, resources_t *resources, world_t *world) {
+    if (world->game_state == GAME_STATE_SPLASH_SCREEN) {
+        transition_to_playing(exe_dir, resources, world);
+    }
 }
 
 /**
- * \brief La fonction gère les évènements ayant eu lieu et qui n'ont pas encore été traités
+ * \brief La fonction gère les évènements ayant eu lieu et qui n'ont pas encore été traités.
+ * Elle ne fait que retirer les évènements de la file, qui est remplie par le fil d'affichage, et peut donc être appelée depuis le fil de simulation.
  * \param exe_dir le chemin de l'exécutable, utilisé pour charger les ressources
  * \param resources les ressources
  * \param world les données du monde
  */
 void handle_events(const char *exe_dir, resources_t *resources, world_t *world) {
     SDL_Event event;
-    while (SDL_PollEvent(&event)) {
+    while (SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT) > 0) {
         // Si l'utilisateur a cliqué sur le X de la fenêtre
         if (event.type == SDL_QUIT) {
             // On indique la fin du jeu
@@ -211,9 +884,55 @@ void handle_events(const char *exe_dir, resources_t *resources, world_t *world)
             }
             if (event.key.keysym.sym == SDLK_i && world->game_state == GAME_STATE_PLAYING) {
                 world->invincible = !world->invincible;
+                world->ghosts.recording_invalid = true;
+                world->used_invincibility = true;
+                telemetry_event_t telemetry_toggle = telemetry_event(world, TELEMETRY_INVINCIBILITY, 0);
+                record_telemetry_event(world->telemetry, &telemetry_toggle);
+            }
+            if (event.key.keysym.sym == SDLK_SPACE) {
+                skip_splash_screen(exe_dir, resources, world);
+            }
+            // Points de passage : C en pose un, R reprend au dernier, Retour arrière recommence le niveau
+            if (event.key.keysym.sym == SDLK_c && !event.key.repeat) {
+                place_checkpoint(world);
+            }
+            if (event.key.keysym.sym == SDLK_r && !event.key.repeat) {
+                retry_level(world, false);
+            }
+            if (event.key.keysym.sym == SDLK_BACKSPACE && !event.key.repeat) {
+                retry_level(world, true);
+            }
+            // Vue d'ensemble : - éloigne la caméra, = la rapproche
+            if (event.key.keysym.sym == SDLK_MINUS) {
+                world->zoom = MAX(world->zoom / OVERVIEW_ZOOM_STEP, OVERVIEW_MIN_ZOOM);
+            }
+            if (event.key.keysym.sym == SDLK_EQUALS) {
+                world->zoom = MIN(world->zoom * OVERVIEW_ZOOM_STEP, 1.0);
             }
-            if (event.key.keysym.sym == SDLK_SPACE && world->game_state == GAME_STATE_SPLASH_SCREEN) {
-                transition_to_playing(exe_dir, resources, world);
+            // Export immédiat de la chronologie (F9), écrite par son propre fil
+            if (event.key.keysym.sym == SDLK_F9) {
+                request_trace_export();
+            }
+        }
+        if (event.type == SDL_MOUSEWHEEL) {
+            world->zoom = CLAMP(world->zoom * pow(OVERVIEW_ZOOM_STEP, event.wheel.y), OVERVIEW_MIN_ZOOM, 1.0);
+        }
+        // Chaque manette branchée revient au premier joueur qui n'en a pas
+        if (event.type == SDL_CONTROLLERDEVICEADDED) {
+            for (int p = 0; p < PLAYER_MAX_COUNT; p++) {
+                if (world->controllers[p] == NULL) {
+                    world->controllers[p] = SDL_GameControllerOpen(event.cdevice.which);
+                    break;
+                }
+            }
+        }
+        if (event.type == SDL_CONTROLLERDEVICEREMOVED) {
+            SDL_GameController *controller = SDL_GameControllerFromInstanceID(event.cdevice.which);
+            for (int p = 0; p < PLAYER_MAX_COUNT; p++) {
+                if (controller != NULL && world->controllers[p] == controller) {
+                    SDL_GameControllerClose(controller);
+                    world->controllers[p] = NULL;
+                }
             }
         }
     }
@@ -231,30 +950,29 @@ bool rects_collide(rect_t rect_1, rect_t rect_2) {
 }
 
 /**
- * \brief Indique si deux objets sont en collision
- * \param surface_1 La première surface
+ * \brief Indique si deux objets sont en collision, d'après leurs masques de collision. Un objet tourné est testé avec son masque tourné, au
+ * même coût qu'un objet droit.
+ * \param mask_1 Le premier masque
  * \param rect_1 Le premier rect
- * \param surface_2 La deuxième surface
+ * \param mask_2 Le deuxième masque
  * \param rect_2 Le deuxième rect
  * \return true s'il y a collision, false sinon
  */
-bool objects_collide(SDL_Surface *surface_1, rect_t rect_1, SDL_Surface *surface_2, rect_t rect_2) {
+bool objects_collide(const collision_mask_t *mask_1, rect_t rect_1, const collision_mask_t *mask_2, rect_t rect_2) {
     if (!rects_collide(rect_1, rect_2)) {
         return false;
     }
-    // On itere chaque pixel de la surface 1, on calcule la position de ce pixel dans la systeme de coordonnée global, puis on le transforme dans la surface 2.
+    // On itere chaque pixel du masque 1, on calcule la position de ce pixel dans la systeme de coordonnée global, puis on le transforme dans le masque 2.
     // On dit qu'il y a collision si la somme des alpha des deux pixels est supérieur à 0xFF.
-    for (int sx_1 = 0; sx_1 < surface_1->w; sx_1++) {
-        for (int sy_1 = 0; sy_1 < surface_1->h; sy_1++) {
-            double x = rect_1.x + rect_1.w * ((double)sx_1 / surface_1->w - 0.5);
-            double y = rect_1.y + rect_1.h * ((double)sy_1 / surface_1->h - 0.5);
-            int sx_2 = round(((x - rect_2.x) / rect_2.w + 0.5) * surface_2->w);
-            int sy_2 = round(((y - rect_2.y) / rect_2.h + 0.5) * surface_2->h);
-            if (sx_2 >= 0 && sx_2 < surface_2->w && sy_2 >= 0 && sy_2 < surface_2->h) {
-                Uint32 pixel_1 = get_pixel_RGBA32(surface_1, sx_1, sy_1);
-                Uint32 pixel_2 = get_pixel_RGBA32(surface_2, sx_2, sy_2);
-                Uint8 alpha_1 = (pixel_1 >> 24) & 0xFF;
-                Uint8 alpha_2 = (pixel_2 >> 24) & 0xFF;
+    for (int sx_1 = 0; sx_1 < mask_1->w; sx_1++) {
+        for (int sy_1 = 0; sy_1 < mask_1->h; sy_1++) {
+            double x = rect_1.x + rect_1.w * ((double)sx_1 / mask_1->w - 0.5);
+            double y = rect_1.y + rect_1.h * ((double)sy_1 / mask_1->h - 0.5);
+            int sx_2 = round(((x - rect_2.x) / rect_2.w + 0.5) * mask_2->w);
+            int sy_2 = round(((y - rect_2.y) / rect_2.h + 0.5) * mask_2->h);
+            if (sx_2 >= 0 && sx_2 < mask_2->w && sy_2 >= 0 && sy_2 < mask_2->h) {
+                Uint8 alpha_1 = mask_1->alpha[(size_t)sy_1 * mask_1->w + sx_1];
+                Uint8 alpha_2 = mask_2->alpha[(size_t)sy_2 * mask_2->w + sx_2];
                 if (alpha_1 + alpha_2 > 0xFF) {
                     return true;
                 }
@@ -262,17 +980,15 @@ bool objects_collide(SDL_Surface *surface_1, rect_t rect_1, SDL_Surface *surface
         }
     }
     // Et vice versa.
-    for (int sx_2 = 0; sx_2 < surface_2->w; sx_2++) {
-        for (int sy_2 = 0; sy_2 < surface_2->h; sy_2++) {
-            double x = rect_2.x + rect_2.w * ((double)sx_2 / surface_2->w - 0.5);
-            double y = rect_2.y + rect_2.h * ((double)sy_2 / surface_2->h - 0.5);
-            int sx_1 = round(((x - rect_1.x) / rect_1.w + 0.5) * surface_1->w);
-            int sy_1 = round(((y - rect_1.y) / rect_1.h + 0.5) * surface_1->h);
-            if (sx_1 >= 0 && sx_1 < surface_1->w && sy_1 >= 0 && sy_1 < surface_1->h) {
-                Uint32 pixel_2 = get_pixel_RGBA32(surface_2, sx_2, sy_2);
-                Uint32 pixel_1 = get_pixel_RGBA32(surface_1, sx_1, sy_1);
-                Uint8 alpha_2 = (pixel_2 >> 24) & 0xFF;
-                Uint8 alpha_1 = (pixel_1 >> 24) & 0xFF;
+    for (int sx_2 = 0; sx_2 < mask_2->w; sx_2++) {
+        for (int sy_2 = 0; sy_2 < mask_2->h; sy_2++) {
+            double x = rect_2.x + rect_2.w * ((double)sx_2 / mask_2->w - 0.5);
+            double y = rect_2.y + rect_2.h * ((double)sy_2 / mask_2->h - 0.5);
+            int sx_1 = round(((x - rect_1.x) / rect_1.w + 0.5) * mask_1->w);
+            int sy_1 = round(((y - rect_1.y) / rect_1.h + 0.5) * mask_1->h);
+            if (sx_1 >= 0 && sx_1 < mask_1->w && sy_1 >= 0 && sy_1 < mask_1->h) {
+                Uint8 alpha_2 = mask_2->alpha[(size_t)sy_2 * mask_2->w + sx_2];
+                Uint8 alpha_1 = mask_1->alpha[(size_t)sy_1 * mask_1->w + sx_1];
                 if (alpha_2 + alpha_1 > 0xFF) {
                     return true;
                 }
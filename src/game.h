@@ -9,8 +9,17 @@
 #ifndef __GAME_H__
 #define __GAME_H__
 
+#include "arena.h"
+#include "collision.h"
 #include "constants.h"
+#include "distance_field.h"
+#include "ghosts.h"
+#include "meteorites.h"
+#include "overview.h"
+#include "particles.h"
+#include "records.h"
 #include "resources.h"
+#include "telemetry.h"
 #include <stdbool.h>
 
 typedef struct rect_s {
@@ -33,6 +42,61 @@ enum game_state_e {
 };
 typedef enum game_state_e game_state_t;
 
+/**
+ * \brief Touches de déplacement, combinées en masque de bits
+ */
+enum input_e {
+    INPUT_LEFT = 1 << 0,
+    INPUT_RIGHT = 1 << 1,
+    INPUT_UP = 1 << 2,
+    INPUT_DOWN = 1 << 3,
+};
+
+/**
+ * \brief Nombre maximal de joueurs sur le même écran
+ */
+#define PLAYER_MAX_COUNT 4
+
+/**
+ * \brief États d'un joueur pendant un niveau
+ */
+enum player_state_e {
+    PLAYER_RACING,   /*!< En course */
+    PLAYER_FINISHED, /*!< Ligne d'arrivée franchie */
+    PLAYER_CRASHED,  /*!< Arrêté par une météorite */
+};
+
+/**
+ * \brief Point de passage : l'état d'un niveau chargé qui change pendant la course. Les météorites, leurs groupes et le champ de distance ne sont
+ * pas copiés mais restent ceux du niveau chargé, les positions des météorites mobiles ne dépendant que du temps de course ; les courses des
+ * fantômes restent aussi en place, seul leur avancement est copié.
+ */
+typedef struct level_checkpoint_s {
+    int level;         /*!< Niveau du point de passage */
+    Uint64 level_time; /*!< Temps de course, en ms depuis le début du niveau */
+    double spaceship_x[PLAYER_MAX_COUNT];
+    double spaceship_y[PLAYER_MAX_COUNT];
+    double spaceship_speed_x[PLAYER_MAX_COUNT];
+    double spaceship_speed_y[PLAYER_MAX_COUNT];
+    double camera_offset[PLAYER_MAX_COUNT];
+    Uint8 player_state[PLAYER_MAX_COUNT];
+    Uint64 finish_time[PLAYER_MAX_COUNT];
+    bool near_miss[PLAYER_MAX_COUNT];
+    bool invincible;
+    bool used_invincibility;
+    int split_count;
+    Uint64 splits[RECORDS_SPLIT_COUNT];
+    double ghost_x[GHOST_MAX_COUNT];
+    double ghost_y[GHOST_MAX_COUNT];
+    double ghost_speed_x[GHOST_MAX_COUNT];
+    double ghost_speed_y[GHOST_MAX_COUNT];
+    Uint64 ghost_time[GHOST_MAX_COUNT];
+    size_t ghost_step[GHOST_MAX_COUNT];
+    Uint8 ghost_state[GHOST_MAX_COUNT];
+    size_t recording_length; /*!< Longueur de la course du joueur enregistrée jusqu'ici, début de la course reprise */
+    bool recording_invalid;
+} level_checkpoint_t;
+
 /**
  * \brief Représentation du monde du jeu
  */
@@ -41,35 +105,83 @@ typedef struct world_s {
     game_state_t game_state;
     Uint64 last_frame_time;       /*!< Temps de la dernière frame rendue */
     Uint64 time_since_last_frame; /*!< Temps écoulé depuis la dernière frame */
+    Uint64 fixed_frame_time;      /*!< Durée fixe d'une frame, pour une simulation déterministe, ou 0 pour utiliser l'horloge */
     Uint64 screen_time;
     int splash_screen_sound_channel;
-    Uint64 playing_time;  /*!< Temps écoulé */
-    int current_level;    /*!< Niveau actuel du joueur */
-    double level_width;   /*!< Largeur du niveau */
-    double level_height;  /*!< Hauteur du niveau */
-    double camera_offset; /*!< Décalage de la caméra */
-    double spaceship_speed_x;
-    double spaceship_speed_y;
-    rect_t spaceship_rect;
-    rect_t finish_line_rect; /*!< La ligne d'arrivée */
-    size_t meteorites_count;
-    rect_t *meteorite_rects; /*!< Tableau de météorites */
-    bool invincible;         /*!< Indique si le joueur est dans un mode invincible */
-    bool has_won;            /*!< Indique si le joueur a gagné */
+    Uint64 playing_time;                  /*!< Temps écoulé */
+    Uint64 level_start_time;              /*!< Temps écoulé au début du niveau courant */
+    int current_level;                    /*!< Niveau actuel du joueur */
+    double level_width;                   /*!< Largeur du niveau */
+    double level_height;                  /*!< Hauteur du niveau */
+    arena_t level_arena;                  /*!< Mémoire des données du niveau, rendue d'un coup à chaque changement de niveau */
+    Uint32 *level_pixels;                 /*!< Pixels du niveau chargé, comparés ligne par ligne lors d'un rechargement */
+    int player_count;                     /*!< Nombre de joueurs, de 1 à PLAYER_MAX_COUNT */
+    double spaceship_x[PLAYER_MAX_COUNT]; /*!< Vaisseaux des joueurs, stockés en tableaux comme ceux des fantômes */
+    double spaceship_y[PLAYER_MAX_COUNT];
+    double spaceship_speed_x[PLAYER_MAX_COUNT];
+    double spaceship_speed_y[PLAYER_MAX_COUNT];
+    double camera_offset[PLAYER_MAX_COUNT];            /*!< Décalage de la caméra de chaque joueur */
+    Uint8 player_state[PLAYER_MAX_COUNT];              /*!< États des joueurs (enum player_state_e) */
+    Uint64 finish_time[PLAYER_MAX_COUNT];              /*!< Temps de course des joueurs arrivés, en ms depuis le début du niveau */
+    SDL_GameController *controllers[PLAYER_MAX_COUNT]; /*!< Manettes ouvertes, une par joueur, ou NULL */
+    rect_t finish_line_rect;                           /*!< La ligne d'arrivée */
+    meteorites_t meteorites;                           /*!< Météorites du niveau */
+    distance_field_t distance_field;                   /*!< Distances aux météorites fixes du niveau */
+    overview_t overview;                               /*!< Carte de densité du niveau, pour la vue d'ensemble */
+    double zoom;                                       /*!< Zoom des vues, de OVERVIEW_MIN_ZOOM à 1 */
+    int near_misses[PLAYER_MAX_COUNT];                 /*!< Nombre de météorites frôlées par chaque joueur depuis le début de la partie */
+    bool near_miss[PLAYER_MAX_COUNT];                  /*!< Indique si le vaisseau d'un joueur est en train de frôler une météorite */
+    bool invincible;                                   /*!< Indique si le joueur est dans un mode invincible */
+    bool has_won;                                      /*!< Indique si le joueur a gagné */
+    ghosts_t ghosts;                                   /*!< Fantômes des meilleures courses du niveau */
+    particles_t particles;                             /*!< Particules des effets visuels */
+    telemetry_t *telemetry;                            /*!< Enregistrement des évènements de partie, ou NULL */
+    records_t *records;                                /*!< Records personnels, ou NULL */
+    Uint64 splits[RECORDS_SPLIT_COUNT];                /*!< Temps de passage du niveau courant, en ms depuis son début */
+    int split_count;                                   /*!< Nombre de temps de passage déjà atteints */
+    bool used_invincibility;                           /*!< Indique si l'invincibilité a été utilisée pendant le niveau courant */
+    Uint64 best_time;                                  /*!< Record du dernier niveau terminé, en ms, ou 0 */
+    bool new_best;                                     /*!< Indique si le dernier niveau terminé a battu le record */
+    bool level_loaded;                                 /*!< Indique si le niveau courant est chargé : en jeu, et sur l'écran de fin après une défaite */
+    level_checkpoint_t level_start;                    /*!< État du niveau courant juste après son chargement, pour le recommencer */
+    level_checkpoint_t checkpoint;                     /*!< Dernier point de passage posé pendant le niveau courant */
+    bool has_checkpoint;                               /*!< Indique si un point de passage a été posé pendant le niveau courant */
+    bool practice;                                     /*!< La course a repris d'un point de passage et ne sera pas conservée */
 } world_t;
 
 void print_rect(char *name, rect_t rect);
 
-void init_data(const char *exe_dir, world_t *world);
+rect_t meteorite_rect(const world_t *world, size_t i);
+
+rect_t spaceship_rect(const world_t *world, int player);
+
+double spaceship_bank_angle(double speed_x);
+
+double meteorite_time(const world_t *world);
+
+void init_data(const char *exe_dir, resources_t *resources, world_t *world);
 
 void clean_data(world_t *world);
 
-void update_data(const char *exe_dir, resources_t *resources, world_t *world);
+bool transition_to_playing(const char *exe_dir, resources_t *resources, world_t *world);
+
+void clean_playing_data(world_t *world);
+
+void read_player_inputs(const world_t *world, Uint8 *inputs);
+
+void move_spaceships(size_t count, const Uint8 *inputs, const double *durations, double level_width, double *restrict x, double *restrict y,
+                     double *restrict speed_x, double *restrict speed_y);
+
+void update_data(const char *exe_dir, resources_t *resources, world_t *world, const Uint8 *inputs);
+
+Uint64 idle_time_left(const world_t *world);
+
+void skip_splash_screen(const char *exe_dir, resources_t *resources, world_t *world);
 
 void handle_events(const char *exe_dir, resources_t *resources, world_t *world);
 
 bool rects_collide(rect_t rect_1, rect_t rect_2);
 
-bool objects_collide(SDL_Surface *surface_1, rect_t rect_1, SDL_Surface *surface_2, rect_t rect_2);
+bool objects_collide(const collision_mask_t *mask_1, rect_t rect_1, const collision_mask_t *mask_2, rect_t rect_2);
 
 #endif
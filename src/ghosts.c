@@ -0,0 +1,317 @@
+/**
+ * \file ghosts.c
+ * \brief Fichier contenant les fantômes, vaisseaux reconstruits à partir des entrées des meilleures courses précédentes
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#include "ghosts.h"
+#include "game.h"
+#include "replay.h"
+#include "utilities.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * \brief La fonction construit le chemin du fichier des courses d'un niveau
+ * \param ghosts les fantômes
+ * \param level le numéro du niveau
+ * \return le chemin, à libérer
+ */
+static char *ghost_file_path(const ghosts_t *ghosts, int level) {
+    char name[32];
+    sprintf(name, GHOST_FILE_NAME, level);
+    return concat_paths(ghosts->directory, name);
+}
+
+/**
+ * \brief La fonction écrit la référence d'une course conservée : le nom du fichier des courses de son niveau, relatif au répertoire des
+ * fantômes, suivi de '#' et de la durée de la course. La durée désigne la ligne "run <durée>" de la course, qui ne change pas quand le fichier
+ * est réécrit pour d'autres courses, alors que sa position dans le fichier change.
+ * \param level le numéro du niveau
+ * \param time la durée de la course, en ms
+ * \param reference la référence écrite, tronquée à size octets
+ * \param size la taille de reference
+ */
+void format_ghost_run_reference(int level, Uint64 time, char *reference, size_t size) {
+    char name[32];
+    sprintf(name, GHOST_FILE_NAME, level);
+    snprintf(reference, size, "%s#%llu", name, (unsigned long long)time);
+}
+
+/**
+ * \brief La fonction agrandit les tableaux d'une course. En cas d'échec, la course garde sa capacité
+ * \param run la course
+ * \param capacity la nouvelle capacité, en pas
+ * \return true si la course a été agrandie, false sinon
+ */
+static bool reserve_ghost_steps(ghost_run_t *run, size_t capacity) {
+    Uint8 *inputs = realloc(run->inputs, capacity);
+    if (inputs != NULL) {
+        run->inputs = inputs;
+    }
+    Uint16 *durations = realloc(run->durations, sizeof(Uint16) * capacity);
+    if (durations != NULL) {
+        run->durations = durations;
+    }
+    if (inputs == NULL || durations == NULL) {
+        // Un seul des tableaux a pu changer de taille : le plus petit des deux fait foi
+        run->capacity = MIN(run->capacity, capacity);
+        return false;
+    }
+    run->capacity = capacity;
+    return true;
+}
+
+/**
+ * \brief La fonction ajoute un pas à une course
+ * \param run la course
+ * \param input le masque des touches enfoncées
+ * \param duration la durée du pas, en ms
+ * \return true si le pas a été ajouté, false si la mémoire manque
+ */
+static bool append_ghost_step(ghost_run_t *run, Uint8 input, Uint16 duration) {
+    if (run->length == run->capacity && !reserve_ghost_steps(run, MIN(MAX(run->capacity * 2, 1024), GHOST_RECORDING_CAPACITY))) {
+        return false;
+    }
+    run->inputs[run->length] = input;
+    run->durations[run->length] = duration;
+    run->length++;
+    return true;
+}
+
+/**
+ * \brief La fonction libère une course
+ * \param run la course
+ */
+static void clean_ghost_run(ghost_run_t *run) {
+    free(run->inputs);
+    free(run->durations);
+    *run = (ghost_run_t){0};
+}
+
+/**
+ * \brief La fonction initialise les fantômes, sans course
+ * \param ghosts les fantômes
+ * \param directory le répertoire des courses enregistrées, ou NULL pour désactiver les fantômes
+ */
+void init_ghosts(ghosts_t *ghosts, const char *directory) {
+    ghosts->directory = directory;
+    ghosts->count = 0;
+    ghosts->recording = (ghost_run_t){0};
+    ghosts->recording_invalid = false;
+}
+
+/**
+ * \brief La fonction charge les meilleures courses d'un niveau et place leurs fantômes au départ. L'enregistrement de la course du joueur est
+ * réservé ici, pour que la partie n'alloue plus de mémoire.
+ * Le fichier est un texte où chaque course commence par une ligne "run <durée>", suivie de lignes "<pas> <durée d'un pas> <touches>" qui
+ * maintiennent des touches pendant un nombre de pas.
+ * \param ghosts les fantômes
+ * \param level le numéro du niveau
+ */
+void load_ghosts(ghosts_t *ghosts, int level) {
+    for (int i = 0; i < ghosts->count; i++) {
+        clean_ghost_run(&ghosts->runs[i]);
+    }
+    ghosts->count = 0;
+    ghosts->recording.length = 0;
+    ghosts->recording_invalid = false;
+    if (ghosts->directory == NULL) {
+        return;
+    }
+    if (ghosts->recording.capacity < GHOST_RECORDING_CAPACITY && !reserve_ghost_steps(&ghosts->recording, GHOST_RECORDING_CAPACITY)) {
+        // La course du joueur ne pourra pas être conservée, mais les fantômes restent chargés
+        fprintf(stderr, "Mémoire insuffisante pour enregistrer la course\n");
+        ghosts->recording_invalid = true;
+    }
+    char *path = ghost_file_path(ghosts, level);
+    FILE *file = fopen(path, "r");
+    free(path);
+    if (file == NULL) {
+        // Aucune course enregistrée pour ce niveau
+        return;
+    }
+    ghost_run_t *run = NULL;
+    bool skipping = false;
+    char line[256];
+    while (fgets(line, sizeof(line), file) != NULL) {
+        unsigned long long time;
+        unsigned long steps, duration;
+        char keys[16];
+        if (line[0] == '#' || line[0] == '\n') {
+            continue;
+        } else if (sscanf(line, "run %llu", &time) == 1) {
+            if (ghosts->count == GHOST_MAX_COUNT) {
+                break;
+            }
+            run = &ghosts->runs[ghosts->count++];
+            *run = (ghost_run_t){.time = time};
+            skipping = false;
+        } else if ((run != NULL || skipping) && sscanf(line, "%lu %lu %15s", &steps, &duration, keys) == 3) {
+            if (skipping) {
+                continue;
+            }
+            // Une course enregistrée ne dépasse jamais l'enregistrement réservé : au-delà, le fichier est corrompu
+            if (steps > GHOST_RECORDING_CAPACITY - run->length || duration > UINT16_MAX) {
+                fprintf(stderr, "Course invalide dans les fantômes : %s", line);
+                clean_ghost_run(run);
+                ghosts->count--;
+                run = NULL;
+                skipping = true;
+                continue;
+            }
+            Uint8 input = parse_replay_keys(keys);
+            for (unsigned long i = 0; i < steps; i++) {
+                if (!append_ghost_step(run, input, duration)) {
+                    fprintf(stderr, "Mémoire insuffisante pour les fantômes\n");
+                    clean_ghost_run(run);
+                    ghosts->count--;
+                    run = NULL;
+                    skipping = true;
+                    break;
+                }
+            }
+        } else {
+            fprintf(stderr, "Ligne invalide dans les fantômes : %s", line);
+        }
+    }
+    fclose(file);
+
+    for (int i = 0; i < ghosts->count; i++) {
+        ghosts->x[i] = 0.0;
+        ghosts->y[i] = 0.0;
+        ghosts->speed_x[i] = 0.0;
+        ghosts->speed_y[i] = 0.0;
+        ghosts->time[i] = 0;
+        ghosts->step[i] = 0;
+        ghosts->state[i] = GHOST_RACING;
+    }
+}
+
+/**
+ * \brief La fonction enregistre un pas de la course du joueur, dans l'enregistrement réservé par load_ghosts
+ * \param ghosts les fantômes
+ * \param input le masque des touches enfoncées
+ * \param duration la durée du pas, en ms
+ */
+void record_ghost_step(ghosts_t *ghosts, Uint8 input, Uint64 duration) {
+    if (ghosts->directory == NULL) {
+        return;
+    }
+    if (ghosts->recording.length == ghosts->recording.capacity) {
+        ghosts->recording_invalid = true;
+        return;
+    }
+    ghosts->recording.inputs[ghosts->recording.length] = input;
+    ghosts->recording.durations[ghosts->recording.length] = MIN(duration, UINT16_MAX);
+    ghosts->recording.length++;
+}
+
+/**
+ * \brief La fonction fait avancer les fantômes jusqu'à un temps de course donné. Ils avancent par lots : à chaque passe, chaque fantôme qui a
+ * un pas à rattraper en applique un, et tous les pas de la passe sont calculés par un seul appel à la physique du vaisseau, sur les tableaux.
+ * \param ghosts les fantômes
+ * \param time le temps de course du joueur, en ms
+ * \param level_width la largeur du niveau
+ */
+void update_ghosts(ghosts_t *ghosts, Uint64 time, double level_width) {
+    Uint8 inputs[GHOST_MAX_COUNT];
+    double durations[GHOST_MAX_COUNT];
+    bool advanced = true;
+    while (advanced) {
+        advanced = false;
+        for (int i = 0; i < ghosts->count; i++) {
+            const ghost_run_t *run = &ghosts->runs[i];
+            // Un pas de durée nulle laisse le fantôme immobile
+            inputs[i] = 0;
+            durations[i] = 0.0;
+            if (ghosts->state[i] != GHOST_RACING) {
+                continue;
+            }
+            if (ghosts->step[i] == run->length) {
+                ghosts->state[i] = GHOST_FINISHED;
+            } else if (ghosts->time[i] + run->durations[ghosts->step[i]] <= time) {
+                inputs[i] = run->inputs[ghosts->step[i]];
+                durations[i] = run->durations[ghosts->step[i]];
+                ghosts->time[i] += run->durations[ghosts->step[i]];
+                ghosts->step[i]++;
+                advanced = true;
+            }
+        }
+        if (advanced) {
+            move_spaceships(ghosts->count, inputs, durations, level_width, ghosts->x, ghosts->y, ghosts->speed_x, ghosts->speed_y);
+        }
+    }
+}
+
+/**
+ * \brief La fonction ajoute la course du joueur, terminée, aux meilleures courses du niveau et réécrit leur fichier
+ * \param ghosts les fantômes
+ * \param level le numéro du niveau
+ * \param time la durée de la course, en ms
+ * \return true si la course est conservée, false sinon
+ */
+bool save_ghost_run(ghosts_t *ghosts, int level, Uint64 time) {
+    if (ghosts->directory == NULL || ghosts->recording_invalid || ghosts->recording.length == 0) {
+        return false;
+    }
+    int position = 0;
+    while (position < ghosts->count && ghosts->runs[position].time <= time) {
+        position++;
+    }
+    if (position == GHOST_MAX_COUNT) {
+        // Plus lente que toutes les courses conservées
+        return false;
+    }
+    if (ghosts->count == GHOST_MAX_COUNT) {
+        clean_ghost_run(&ghosts->runs[--ghosts->count]);
+    }
+    memmove(&ghosts->runs[position + 1], &ghosts->runs[position], sizeof(ghost_run_t) * (ghosts->count - position));
+    // La course conservée est réduite à sa longueur, l'enregistrement étant réservé pour une course longue
+    ghost_run_t *saved_run = &ghosts->runs[position];
+    *saved_run = ghosts->recording;
+    saved_run->time = time;
+    // Si la réduction échoue, la course garde simplement ses tableaux réservés
+    reserve_ghost_steps(saved_run, saved_run->length);
+    ghosts->count++;
+    ghosts->recording = (ghost_run_t){0};
+
+    char *path = ghost_file_path(ghosts, level);
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        fprintf(stderr, "Erreur pendant l'écriture des fantômes %s\n", path);
+        free(path);
+        return false;
+    }
+    fprintf(file, "# Courses du niveau %d, de la plus rapide à la plus lente\n", level + 1);
+    for (int i = 0; i < ghosts->count; i++) {
+        const ghost_run_t *run = &ghosts->runs[i];
+        fprintf(file, "run %llu\n", (unsigned long long)run->time);
+        // Les pas identiques consécutifs sont regroupés sur une ligne
+        for (size_t start = 0, end; start < run->length; start = end) {
+            for (end = start + 1; end < run->length && run->inputs[end] == run->inputs[start] && run->durations[end] == run->durations[start]; end++) {
+            }
+            char keys[8];
+            format_replay_keys(run->inputs[start], keys);
+            fprintf(file, "%zu %u %s\n", end - start, run->durations[start], keys);
+        }
+    }
+    fclose(file);
+    free(path);
+    return true;
+}
+
+/**
+ * \brief La fonction libère les courses et la course en cours d'enregistrement
+ * \param ghosts les fantômes
+ */
+void clean_ghosts(ghosts_t *ghosts) {
+    for (int i = 0; i < ghosts->count; i++) {
+        clean_ghost_run(&ghosts->runs[i]);
+    }
+    ghosts->count = 0;
+    clean_ghost_run(&ghosts->recording);
+}
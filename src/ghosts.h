@@ -0,0 +1,89 @@
+/**
+ * \file ghosts.h
+ * \brief Fichier contenant les fantômes, vaisseaux reconstruits à partir des entrées des meilleures courses précédentes
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#ifndef __GHOSTS_H__
+#define __GHOSTS_H__
+
+#include <SDL.h>
+#include <stdbool.h>
+
+/**
+ * \brief Nombre maximal de fantômes, et de courses conservées par niveau
+ */
+#define GHOST_MAX_COUNT 64
+
+/**
+ * \brief Nombre de pas réservés pour l'enregistrement de la course du joueur (plus de 4 minutes à 240 images par seconde). Une course plus longue
+ * n'est pas conservée.
+ */
+#define GHOST_RECORDING_CAPACITY 65536
+
+/**
+ * \brief Nom du fichier des courses d'un niveau, dans le répertoire des fantômes
+ */
+#define GHOST_FILE_NAME "level_%d.ghosts"
+
+/**
+ * \brief Opacité des fantômes
+ */
+#define GHOST_ALPHA 0.3
+
+/**
+ * \brief États d'un fantôme
+ */
+enum ghost_state_e {
+    GHOST_RACING,   /*!< En course */
+    GHOST_FINISHED, /*!< Course terminée, toutes ses entrées ayant été appliquées */
+    GHOST_CRASHED,  /*!< Entré en collision avec une météorite, le niveau ayant changé depuis la course */
+};
+typedef enum ghost_state_e ghost_state_t;
+
+/**
+ * \brief Course enregistrée : les entrées et la durée de chaque pas de simulation
+ */
+typedef struct ghost_run_s {
+    Uint64 time; /*!< Durée de la course, en ms */
+    size_t length;
+    size_t capacity;
+    Uint8 *inputs;     /*!< Masques des touches enfoncées, un par pas */
+    Uint16 *durations; /*!< Durées des pas, en ms */
+} ghost_run_t;
+
+/**
+ * \brief Fantômes du niveau courant, simulés ensemble sous forme de structure de tableaux
+ */
+typedef struct ghosts_s {
+    const char *directory; /*!< Répertoire des courses enregistrées, ou NULL si les fantômes sont désactivés */
+    int count;
+    ghost_run_t runs[GHOST_MAX_COUNT]; /*!< Courses, de la plus rapide à la plus lente */
+    double x[GHOST_MAX_COUNT];
+    double y[GHOST_MAX_COUNT];
+    double speed_x[GHOST_MAX_COUNT];
+    double speed_y[GHOST_MAX_COUNT];
+    Uint64 time[GHOST_MAX_COUNT]; /*!< Temps de course simulé, en ms */
+    size_t step[GHOST_MAX_COUNT]; /*!< Prochain pas de la course */
+    Uint8 state[GHOST_MAX_COUNT];
+    ghost_run_t recording;  /*!< Course du joueur en cours d'enregistrement, réservée au début du niveau */
+    bool recording_invalid; /*!< La course en cours a utilisé l'invincibilité ou est trop longue, et ne sera pas conservée */
+} ghosts_t;
+
+void init_ghosts(ghosts_t *ghosts, const char *directory);
+
+void load_ghosts(ghosts_t *ghosts, int level);
+
+void record_ghost_step(ghosts_t *ghosts, Uint8 input, Uint64 duration);
+
+void update_ghosts(ghosts_t *ghosts, Uint64 time, double level_width);
+
+bool save_ghost_run(ghosts_t *ghosts, int level, Uint64 time);
+
+void format_ghost_run_reference(int level, Uint64 time, char *reference, size_t size);
+
+void clean_ghosts(ghosts_t *ghosts);
+
+#endif
@@ -11,115 +11,558 @@
 #include "game.h"
 #include "sdl2-light.h"
 #include "sdl2-ttf-light.h"
+#include "snapshot.h"
 #include "utilities.h"
 
-double camera_scale(double screen_w, double screen_h, world_t *world) {
-    return MIN(screen_w, screen_h * MAX_SCREEN_RATIO) / world->level_width;
+double camera_scale(double screen_w, double screen_h, double level_width, double zoom) {
+    return MIN(screen_w, screen_h * MAX_SCREEN_RATIO) / level_width * zoom;
 }
 
-rect_t camera_transform(double screen_w, double screen_h, world_t *world, rect_t rect) {
-    double scale = camera_scale(screen_w, screen_h, world);
-    return (rect_t){rect.x * scale + screen_w / 2, (rect.y + world->camera_offset) * scale + screen_h / 2, rect.w * scale, rect.h * scale};
+rect_t camera_transform(double screen_w, double screen_h, double level_width, double zoom, double camera_offset, rect_t rect) {
+    double scale = camera_scale(screen_w, screen_h, level_width, zoom);
+    return (rect_t){rect.x * scale + screen_w / 2, (rect.y + camera_offset) * scale + screen_h / 2, rect.w * scale, rect.h * scale};
 }
 
-void draw_texture(SDL_Renderer *renderer, SDL_Texture *texture, rect_t rect) {
+/**
+ * \brief La fonction donne l'opacité des météorites dessinées une à une loin des vaisseaux, selon leur taille à l'écran : 1 au zoom normal,
+ * 0 dans la vue d'ensemble où seule la carte de densité les représente, et un fondu entre les deux
+ * \param scale l'échelle de la caméra, en pixels par unité du niveau
+ * \return l'opacité, entre 0 et 1
+ */
+double meteorite_sprite_fade(double scale) {
+    return CLAMP((METEORITE_SIZE * scale - OVERVIEW_TEXTURE_PIXELS) / (OVERVIEW_SPRITE_PIXELS - OVERVIEW_TEXTURE_PIXELS), 0.0, 1.0);
+}
+
+/**
+ * \brief La fonction donne la partie de l'écran d'un joueur : l'écran entier pour un joueur seul, deux colonnes côte à côte pour deux joueurs,
+ * une grille de deux sur deux au-delà
+ * \param player le numéro du joueur
+ * \param player_count le nombre de joueurs
+ * \param screen_w la largeur de l'écran
+ * \param screen_h la hauteur de l'écran
+ * \return la vue du joueur, en pixels
+ */
+SDL_Rect player_viewport(int player, int player_count, int screen_w, int screen_h) {
+    if (player_count <= 2) {
+        int w = screen_w / player_count;
+        return (SDL_Rect){player * w, 0, w, screen_h};
+    }
+    int w = screen_w / 2, h = screen_h / 2;
+    return (SDL_Rect){player % 2 * w, player / 2 * h, w, h};
+}
+
+/**
+ * \brief La fonction dessine un sprite avec sa version la plus proche de sa taille à l'écran
+ * \param renderer le renderer
+ * \param sprite le sprite
+ * \param rect le rect à l'écran, centré
+ */
+void draw_sprite(SDL_Renderer *renderer, const sprite_t *sprite, rect_t rect) {
     SDL_FRect sdl_rect = {rect.x - rect.w / 2, rect.y - rect.h / 2, rect.w, rect.h};
-    SDL_RenderCopyF(renderer, texture, NULL, &sdl_rect);
+    SDL_RenderCopyF(renderer, sprite_texture(sprite, rect.w, rect.h), NULL, &sdl_rect);
 }
 
 /**
- * \brief La fonction applique la texture du fond sur le renderer lié à l'écran de jeu
+ * \brief La fonction dessine un sprite tourné autour de son centre, avec sa version la plus proche de sa taille à l'écran
+ * \param renderer le renderer
+ * \param sprite le sprite
+ * \param rect le rect à l'écran, centré
+ * \param angle l'angle, en degrés dans le sens horaire
+ */
+void draw_sprite_rotated(SDL_Renderer *renderer, const sprite_t *sprite, rect_t rect, double angle) {
+    SDL_FRect sdl_rect = {rect.x - rect.w / 2, rect.y - rect.h / 2, rect.w, rect.h};
+    SDL_RenderCopyExF(renderer, sprite_texture(sprite, rect.w, rect.h), NULL, &sdl_rect, angle, NULL, SDL_FLIP_NONE);
+}
+
+/**
+ * \brief La fonction donne l'opacité d'une météorite proche des vaisseaux dans la vue d'ensemble : 1 près d'un vaisseau en course, puis un
+ * fondu sur la fin du rayon de détail
+ * \param snapshot l'instantané du monde
+ * \param x l'abscisse de la météorite
+ * \param y l'ordonnée de la météorite
+ * \return l'opacité, entre 0 et 1
+ */
+static double meteorite_detail_fade(const snapshot_t *snapshot, double x, double y) {
+    double nearest = INFINITY;
+    for (int p = 0; p < snapshot->player_count; p++) {
+        if (snapshot->player_state[p] != PLAYER_CRASHED) {
+            nearest = MIN(nearest, hypot(x - snapshot->spaceship_rect[p].x, y - snapshot->spaceship_rect[p].y));
+        }
+    }
+    return CLAMP((OVERVIEW_DETAIL_RADIUS - nearest) / (OVERVIEW_DETAIL_RADIUS * OVERVIEW_DETAIL_FADE), 0.0, 1.0);
+}
+
+/**
+ * \brief La fonction dessine les météorites visibles, copiées dans l'instantané par la simulation. Les météorites copiées pour les vues des
+ * autres joueurs sont ignorées. En s'éloignant, les météorites loin des vaisseaux s'effacent au profit de la carte de densité.
+ * \param renderer le renderer
+ * \param screen_w la largeur de la vue
+ * \param screen_h la hauteur de la vue
+ * \param snapshot l'instantané du monde
+ * \param camera_offset le décalage de la caméra de la vue
+ * \param sprite le sprite des météorites
+ */
+void draw_meteorites(SDL_Renderer *renderer, double screen_w, double screen_h, const snapshot_t *snapshot, double camera_offset, const sprite_t *sprite) {
+    double fade = meteorite_sprite_fade(camera_scale(screen_w, screen_h, snapshot->level_width, snapshot->zoom));
+    Uint8 alpha = 255;
+    for (size_t i = 0; i < snapshot->meteorites_count; i++) {
+        rect_t rect = {snapshot->meteorite_x[i], snapshot->meteorite_y[i], METEORITE_SIZE, METEORITE_SIZE};
+        rect_t screen_rect = camera_transform(screen_w, screen_h, snapshot->level_width, snapshot->zoom, camera_offset, rect);
+        if (screen_rect.y + screen_rect.h / 2 < 0.0 || screen_rect.y - screen_rect.h / 2 > screen_h) {
+            continue;
+        }
+        if (fade < 1.0) {
+            Uint8 meteorite_alpha = MAX(fade, meteorite_detail_fade(snapshot, rect.x, rect.y)) * 255;
+            if (meteorite_alpha == 0) {
+                continue;
+            }
+            // L'opacité ne change qu'au bord du rayon de détail : le sprite n'est modifié qu'à ce moment
+            if (meteorite_alpha != alpha) {
+                alpha = meteorite_alpha;
+                set_sprite_alpha_mod(sprite, alpha);
+            }
+        }
+        draw_sprite_rotated(renderer, sprite, screen_rect, snapshot->meteorite_angle[i]);
+    }
+    if (alpha != 255) {
+        set_sprite_alpha_mod(sprite, 255);
+    }
+}
+
+/**
+ * \brief Couleur de la carte de densité, proche de celle des météorites ; son opacité est la densité de chaque bloc
+ */
+static const SDL_Color overview_color = {150, 135, 120, 255};
+
+/**
+ * \brief La fonction recharge la texture de la carte de densité quand l'instantané en porte une nouvelle version, c'est-à-dire au chargement
+ * ou au rechargement du niveau, que la vue d'ensemble soit affichée ou non : la texture n'est jamais créée au milieu d'une partie. Une texture
+ * de même taille est réécrite sur place.
+ * \param renderer le renderer
+ * \param resources les ressources, qui portent la texture
+ * \param snapshot l'instantané du monde
+ */
+static void refresh_overview_texture(SDL_Renderer *renderer, resources_t *resources, const snapshot_t *snapshot) {
+    if (resources->overview_version == snapshot->overview_version) {
+        return;
+    }
+    int w, h;
+    if (resources->overview_texture != NULL) {
+        SDL_QueryTexture(resources->overview_texture, NULL, NULL, &w, &h);
+        if (w != snapshot->overview_width || h != snapshot->overview_height) {
+            clean_texture(resources->overview_texture);
+            resources->overview_texture = NULL;
+        }
+    }
+    if (resources->overview_texture == NULL) {
+        resources->overview_texture =
+            SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STREAMING, snapshot->overview_width, snapshot->overview_height);
+        if (resources->overview_texture == NULL) {
+            return;
+        }
+        SDL_SetTextureBlendMode(resources->overview_texture, SDL_BLENDMODE_BLEND);
+        SDL_SetTextureScaleMode(resources->overview_texture, SDL_ScaleModeLinear);
+    }
+    void *pixels;
+    int pitch;
+    if (SDL_LockTexture(resources->overview_texture, NULL, &pixels, &pitch) != 0) {
+        return;
+    }
+    Uint64 cell_count = (Uint64)snapshot->overview_block * snapshot->overview_block;
+    for (int y = 0; y < snapshot->overview_height; y++) {
+        Uint8 *row = (Uint8 *)pixels + (size_t)y * pitch;
+        const Uint32 *counts = snapshot->overview_counts + (size_t)y * snapshot->overview_width;
+        for (int x = 0; x < snapshot->overview_width; x++) {
+            row[x * 4] = overview_color.r;
+            row[x * 4 + 1] = overview_color.g;
+            row[x * 4 + 2] = overview_color.b;
+            row[x * 4 + 3] = (Uint64)counts[x] * 255 / cell_count;
+        }
+    }
+    SDL_UnlockTexture(resources->overview_texture);
+    resources->overview_version = snapshot->overview_version;
+}
+
+/**
+ * \brief La fonction dessine la carte de densité du niveau, en un seul appel de dessin quel que soit le nombre de météorites. Elle n'est
+ * dessinée qu'une fois les météorites assez petites à l'écran, et apparaît à mesure qu'elles s'effacent.
+ * \param renderer le renderer
+ * \param screen_w la largeur de la vue
+ * \param screen_h la hauteur de la vue
+ * \param resources les ressources
+ * \param snapshot l'instantané du monde
+ * \param camera_offset le décalage de la caméra de la vue
+ */
+static void draw_overview(SDL_Renderer *renderer, double screen_w, double screen_h, resources_t *resources, const snapshot_t *snapshot,
+                          double camera_offset) {
+    double fade = meteorite_sprite_fade(camera_scale(screen_w, screen_h, snapshot->level_width, snapshot->zoom));
+    if (fade >= 1.0 || snapshot->overview_counts == NULL) {
+        return;
+    }
+    if (resources->overview_texture == NULL) {
+        return;
+    }
+    // La carte commence au bord haut de la première ligne du niveau et couvre des blocs entiers
+    double block = snapshot->overview_block, map_w = snapshot->overview_width * block, map_h = snapshot->overview_height * block;
+    double top = -snapshot->level_height + 0.5, left = -snapshot->level_width / 2;
+    rect_t map_rect = {left + map_w / 2, top + map_h / 2, map_w, map_h};
+    rect_t screen_rect = camera_transform(screen_w, screen_h, snapshot->level_width, snapshot->zoom, camera_offset, map_rect);
+    SDL_SetTextureAlphaMod(resources->overview_texture, (1.0 - fade) * 255);
+    SDL_FRect sdl_rect = {screen_rect.x - screen_rect.w / 2, screen_rect.y - screen_rect.h / 2, screen_rect.w, screen_rect.h};
+    SDL_RenderCopyF(renderer, resources->overview_texture, NULL, &sdl_rect);
+}
+
+/**
+ * \brief Couleurs des particules de chaque sorte
+ */
+static const SDL_Color particle_colors[PARTICLE_KIND_COUNT] = {{255, 170, 60, 255}, {170, 160, 150, 255}, {255, 230, 120, 255}};
+
+/**
+ * \brief Modes de mélange des particules de chaque sorte : la traînée et la gerbe s'additionnent, les débris couvrent le fond
+ */
+static const SDL_BlendMode particle_blend_modes[PARTICLE_KIND_COUNT] = {SDL_BLENDMODE_ADD, SDL_BLENDMODE_BLEND, SDL_BLENDMODE_ADD};
+
+/**
+ * \brief La fonction dessine les particules visibles, copiées dans l'instantané par la simulation. Toutes les particules d'une sorte sont
+ * envoyées en un seul appel de dessin, sous forme de quadrilatères colorés qui rétrécissent et s'effacent avec l'âge.
+ * \param renderer le renderer
+ * \param screen_w la largeur de la vue
+ * \param screen_h la hauteur de la vue
+ * \param snapshot l'instantané du monde
+ * \param camera_offset le décalage de la caméra de la vue
+ * \param resources les ressources, qui portent les tampons de sommets, NULL si leur allocation a échoué
+ */
+void draw_particles(SDL_Renderer *renderer, double screen_w, double screen_h, const snapshot_t *snapshot, double camera_offset, resources_t *resources) {
+    if (resources->particle_vertices == NULL) {
+        return;
+    }
+    float scale = camera_scale(screen_w, screen_h, snapshot->level_width, snapshot->zoom);
+    float center_x = screen_w / 2, center_y = camera_offset * scale + screen_h / 2;
+    SDL_BlendMode blend_mode;
+    SDL_GetRenderDrawBlendMode(renderer, &blend_mode);
+    for (int kind = 0; kind < PARTICLE_KIND_COUNT; kind++) {
+        int count = snapshot->particle_count[kind];
+        if (count == 0) {
+            continue;
+        }
+        const float *x = snapshot->particle_x[kind], *y = snapshot->particle_y[kind], *life = snapshot->particle_life[kind];
+        float *restrict vertices = resources->particle_vertices;
+        SDL_Color *restrict colors = resources->particle_colors;
+        for (int i = 0; i < count; i++) {
+            float half_size = PARTICLE_SIZE * scale * (0.5f + 0.5f * life[i]) / 2;
+            float left = x[i] * scale + center_x - half_size, right = x[i] * scale + center_x + half_size;
+            float top = y[i] * scale + center_y - half_size, bottom = y[i] * scale + center_y + half_size;
+            float *quad = vertices + i * 8;
+            quad[0] = left;
+            quad[1] = top;
+            quad[2] = right;
+            quad[3] = top;
+            quad[4] = right;
+            quad[5] = bottom;
+            quad[6] = left;
+            quad[7] = bottom;
+            SDL_Color color = particle_colors[kind];
+            color.a = life[i] * 255;
+            colors[i * 4] = colors[i * 4 + 1] = colors[i * 4 + 2] = colors[i * 4 + 3] = color;
+        }
+        // Sans texture, la géométrie utilise le mode de mélange du renderer
+        SDL_SetRenderDrawBlendMode(renderer, particle_blend_modes[kind]);
+        SDL_RenderGeometryRaw(renderer, NULL, vertices, sizeof(float) * 2, colors, sizeof(SDL_Color), NULL, 0, count * 4, resources->particle_indices,
+                              count * 6, sizeof(int));
+    }
+    SDL_SetRenderDrawBlendMode(renderer, blend_mode);
+}
+
+/**
+ * \brief La fonction applique la texture du fond, répétée verticalement, sur le renderer lié à l'écran de jeu, en un seul appel de dessin
  * \param renderer le renderer
  * \param screen_w la largeur de l'écran
  * \param screen_h la hauteur de l'écran
- * \param world les données du monde
+ * \param level_width la largeur du niveau
  * \param scroll_offset le décalage de la caméra
  * \param texture la texture liée au fond
  */
-void draw_background(SDL_Renderer *renderer, double screen_w, double screen_h, world_t *world, SDL_Texture *texture, double scroll_offset) {
-    double scale = camera_scale(screen_w, screen_h, world);
+void draw_background(SDL_Renderer *renderer, double screen_w, double screen_h, double level_width, SDL_Texture *texture, double scroll_offset) {
+    // Le fond ne suit pas le zoom de la vue d'ensemble
+    double scale = camera_scale(screen_w, screen_h, level_width, 1.0);
     int w, h;
     SDL_QueryTexture(texture, NULL, NULL, &w, &h);
     double rect_height = screen_w * h / w;
     double initial_rect_y = scroll_offset * scale + screen_h / 2 - rect_height / 2;
-    double start_rect_y = positive_fmod(initial_rect_y, rect_height) - rect_height;
-    int n = MIN(ceil(screen_h / rect_height) + 2, screen_h * 2); // Limiter le nombre d'itérations pour s'assurer de ne pas créer une boucle infinie
-    // On dessine plusieurs copies de la texture pour créer un effet de défilement continu et remplir tout l'écran
-    for (int i = 0; i < n; i++) {
-        SDL_FRect rect = {0.0, start_rect_y + rect_height * i, screen_w, rect_height};
-        SDL_RenderCopyF(renderer, texture, NULL, &rect);
+    // Ordonnée du haut de la répétition de la texture qui couvre le haut de l'écran
+    double tile_y = positive_fmod(initial_rect_y, rect_height) - rect_height;
+
+    // Un seul quadrilatère couvrant l'écran, dont les coordonnées de texture défilent. SDL2 ne répète pas les textures au-delà de [0, 1], le
+    // quadrilatère est donc coupé à chaque raccord de la texture, mais tous les morceaux sont envoyés en un seul appel de dessin.
+    SDL_Vertex vertices[BACKGROUND_MAX_TILES * 4];
+    int indices[BACKGROUND_MAX_TILES * 6];
+    int vertex_count = 0, index_count = 0;
+    for (double y = 0.0; y < screen_h && vertex_count < BACKGROUND_MAX_TILES * 4; tile_y += rect_height) {
+        double next_y = MIN(tile_y + rect_height, screen_h);
+        if (next_y <= y) {
+            continue;
+        }
+        float top_v = (y - tile_y) / rect_height, bottom_v = (next_y - tile_y) / rect_height;
+        SDL_Color color = {255, 255, 255, 255};
+        vertices[vertex_count] = (SDL_Vertex){{0.0, y}, color, {0.0, top_v}};
+        vertices[vertex_count + 1] = (SDL_Vertex){{screen_w, y}, color, {1.0, top_v}};
+        vertices[vertex_count + 2] = (SDL_Vertex){{screen_w, next_y}, color, {1.0, bottom_v}};
+        vertices[vertex_count + 3] = (SDL_Vertex){{0.0, next_y}, color, {0.0, bottom_v}};
+        int quad_indices[6] = {0, 1, 2, 0, 2, 3};
+        for (int i = 0; i < 6; i++) {
+            indices[index_count++] = vertex_count + quad_indices[i];
+        }
+        vertex_count += 4;
+        y = next_y;
+    }
+    SDL_RenderGeometry(renderer, texture, vertices, vertex_count, indices, index_count);
+}
+
+/**
+ * \brief La fonction dessine le fond et ses couches supplémentaires, chacune défilant plus vite que la précédente pour un effet de parallaxe
+ * \param renderer le renderer
+ * \param screen_w la largeur de l'écran
+ * \param screen_h la hauteur de l'écran
+ * \param level_width la largeur du niveau
+ * \param resources les ressources
+ * \param camera_offset le décalage de la caméra
+ */
+void draw_parallax_background(SDL_Renderer *renderer, double screen_w, double screen_h, double level_width, resources_t *resources,
+                              double camera_offset) {
+    double speed = BACKGROUND_SPEED;
+    draw_background(renderer, screen_w, screen_h, level_width, resources->background_texture, camera_offset * speed);
+    for (int layer = 0; layer < BACKGROUND_LAYER_COUNT; layer++) {
+        speed *= BACKGROUND_LAYER_SPEED_FACTOR;
+        if (resources->background_layer_textures[layer] != NULL) {
+            draw_background(renderer, screen_w, screen_h, level_width, resources->background_layer_textures[layer], camera_offset * speed);
+        }
+    }
+}
+
+/**
+ * \brief La fonction dessine, sous le message d'un écran de fin de niveau, le record du niveau terminé
+ * \param renderer le renderer
+ * \param screen_w la largeur de l'écran
+ * \param screen_h la hauteur de l'écran
+ * \param resources les ressources
+ * \param snapshot l'instantané du monde
+ */
+static void draw_best_time(SDL_Renderer *renderer, double screen_w, double screen_h, resources_t *resources, const snapshot_t *snapshot) {
+    if (snapshot->best_time == 0) {
+        return;
     }
+    char message[32];
+    sprintf(message, "%s: %.2f s", snapshot->new_best ? "New best" : "Best", snapshot->best_time / 1000.0);
+    draw_text(renderer, screen_w / 2, screen_h / 2 + resources->glyphs.height, true, &resources->glyphs, message);
 }
 
 /**
- * \brief La fonction rafraichit l'écran en fonction de l'état des données du monde
+ * \brief La fonction dessine le vaisseau d'un joueur et sa flamme
+ * \param renderer le renderer
+ * \param screen_w la largeur de la vue
+ * \param screen_h la hauteur de la vue
+ * \param resources les ressources
+ * \param snapshot l'instantané du monde
+ * \param camera_offset le décalage de la caméra de la vue
+ * \param player le numéro du joueur
+ */
+static void draw_spaceship(SDL_Renderer *renderer, double screen_w, double screen_h, resources_t *resources, const snapshot_t *snapshot,
+                           double camera_offset, int player) {
+    rect_t spaceship_rect = snapshot->spaceship_rect[player];
+    double angle = snapshot->spaceship_angle[player], level_width = snapshot->level_width, zoom = snapshot->zoom;
+    set_sprite_alpha_mod(&resources->spaceship_sprite, (snapshot->invincible ? 0.5 : 1.0) * 255);
+    draw_sprite_rotated(renderer, &resources->spaceship_sprite, camera_transform(screen_w, screen_h, level_width, zoom, camera_offset, spaceship_rect), angle);
+
+    // La flamme s'incline avec le vaisseau, autour de son centre
+    double flame_intensity = CLAMP(-snapshot->spaceship_speed_y[player] / MAX_USUAL_SPEED, 0.0, 1.0);
+    double flame_rect_w = spaceship_rect.w * FLAME_SCALE * flame_intensity;
+    double flame_rect_h = flame_rect_w * resources->flame_surface->h / resources->flame_surface->w;
+    double flame_offset = spaceship_rect.h / 2 + flame_rect_h / 2, flame_angle = angle * M_PI / 180.0;
+    rect_t flame_rect = {spaceship_rect.x - flame_offset * sin(flame_angle), spaceship_rect.y + flame_offset * cos(flame_angle), flame_rect_w, flame_rect_h};
+    set_sprite_alpha_mod(&resources->flame_sprite, flame_intensity * (snapshot->invincible ? 0.5 : 1.0) * 255);
+    draw_sprite_rotated(renderer, &resources->flame_sprite, camera_transform(screen_w, screen_h, level_width, zoom, camera_offset, flame_rect), angle);
+}
+
+/**
+ * \brief La fonction dessine la scène de jeu vue par un joueur, sans le texte : fond, particules, vaisseaux, ligne d'arrivée et météorites
+ * \param renderer le renderer
+ * \param screen_w la largeur de la vue
+ * \param screen_h la hauteur de la vue
+ * \param resources les ressources
+ * \param snapshot l'instantané du monde
+ * \param player le numéro du joueur
+ */
+static void draw_scene(SDL_Renderer *renderer, double screen_w, double screen_h, resources_t *resources, const snapshot_t *snapshot, int player) {
+    double camera_offset = snapshot->camera_offset[player], level_width = snapshot->level_width, zoom = snapshot->zoom;
+    draw_parallax_background(renderer, screen_w, screen_h, level_width, resources, camera_offset);
+
+    draw_particles(renderer, screen_w, screen_h, snapshot, camera_offset, resources);
+
+    // Fantômes translucides, sous les vaisseaux des joueurs
+    set_sprite_alpha_mod(&resources->spaceship_sprite, GHOST_ALPHA * 255);
+    for (int g = 0; g < snapshot->ghost_count; g++) {
+        rect_t ghost_rect = {snapshot->ghost_x[g], snapshot->ghost_y[g], SPACESHIP_SIZE, SPACESHIP_SIZE};
+        draw_sprite_rotated(renderer, &resources->spaceship_sprite, camera_transform(screen_w, screen_h, level_width, zoom, camera_offset, ghost_rect),
+                            snapshot->ghost_angle[g]);
+    }
+
+    // Les vaisseaux détruits ont laissé place à leurs débris ; celui du joueur de la vue passe devant les autres
+    for (int p = 0; p < snapshot->player_count; p++) {
+        if (p != player && snapshot->player_state[p] != PLAYER_CRASHED) {
+            draw_spaceship(renderer, screen_w, screen_h, resources, snapshot, camera_offset, p);
+        }
+    }
+    if (snapshot->player_state[player] != PLAYER_CRASHED) {
+        draw_spaceship(renderer, screen_w, screen_h, resources, snapshot, camera_offset, player);
+    }
+
+    draw_sprite(renderer, &resources->finish_line_sprite,
+                camera_transform(screen_w, screen_h, level_width, zoom, camera_offset, snapshot->finish_line_rect));
+
+    draw_overview(renderer, screen_w, screen_h, resources, snapshot, camera_offset);
+    draw_meteorites(renderer, screen_w, screen_h, snapshot, camera_offset, &resources->meteorite_sprite);
+}
+
+/**
+ * \brief La fonction dessine les particules dans la vue de chaque joueur, sur les écrans de fin
+ * \param renderer le renderer
+ * \param screen_w la largeur de l'écran
+ * \param screen_h la hauteur de l'écran
+ * \param resources les ressources
+ * \param snapshot l'instantané du monde
+ */
+static void draw_player_particles(SDL_Renderer *renderer, int screen_w, int screen_h, resources_t *resources, const snapshot_t *snapshot) {
+    for (int p = 0; p < snapshot->player_count; p++) {
+        SDL_Rect viewport = player_viewport(p, snapshot->player_count, screen_w, screen_h);
+        SDL_RenderSetViewport(renderer, &viewport);
+        draw_particles(renderer, viewport.w, viewport.h, snapshot, snapshot->camera_offset[p], resources);
+    }
+    SDL_RenderSetViewport(renderer, NULL);
+}
+
+/**
+ * \brief La fonction dessine le texte de la vue de chaque joueur : temps, frôlements, temps de passage et état du joueur
+ * \param renderer le renderer
+ * \param screen_w la largeur de l'écran
+ * \param screen_h la hauteur de l'écran
+ * \param resources les ressources
+ * \param snapshot l'instantané du monde
+ */
+static void draw_player_huds(SDL_Renderer *renderer, int screen_w, int screen_h, resources_t *resources, const snapshot_t *snapshot) {
+    char text[64];
+    for (int p = 0; p < snapshot->player_count; p++) {
+        SDL_Rect viewport = player_viewport(p, snapshot->player_count, screen_w, screen_h);
+        double x = viewport.x + 10, y = viewport.y + 10;
+        sprintf(text, "Time: %.2f s", snapshot->playing_time / 1000.0);
+        // Affichage en haut à gauche
+        draw_text(renderer, x, y, false, &resources->glyphs, text);
+        sprintf(text, "Near misses: %d", snapshot->near_misses[p]);
+        draw_text(renderer, x, y + resources->glyphs.height, false, &resources->glyphs, text);
+        if (snapshot->split >= 0) {
+            sprintf(text, "Split %d: %+.2f s", snapshot->split + 1, snapshot->split_delta / 1000.0);
+            draw_text(renderer, x, y + 2 * resources->glyphs.height, false, &resources->glyphs, text);
+        }
+
+        // Un joueur arrêté attend les autres
+        double center_x = viewport.x + viewport.w / 2.0, center_y = viewport.y + viewport.h / 2.0;
+        if (snapshot->player_state[p] == PLAYER_CRASHED) {
+            draw_text(renderer, center_x, center_y, true, &resources->glyphs, "Crashed");
+        } else if (snapshot->player_state[p] == PLAYER_FINISHED) {
+            sprintf(text, "Finished: %.2f s", snapshot->finish_time[p] / 1000.0);
+            draw_text(renderer, center_x, center_y, true, &resources->glyphs, text);
+        }
+    }
+}
+
+/**
+ * \brief La fonction donne le joueur arrivé le premier au dernier niveau joué
+ * \param snapshot l'instantané du monde
+ * \return le numéro du joueur, ou -1 si aucun n'est arrivé
+ */
+static int fastest_player(const snapshot_t *snapshot) {
+    int fastest = -1;
+    for (int p = 0; p < snapshot->player_count; p++) {
+        if (snapshot->player_state[p] == PLAYER_FINISHED && (fastest < 0 || snapshot->finish_time[p] < snapshot->finish_time[fastest])) {
+            fastest = p;
+        }
+    }
+    return fastest;
+}
+
+/**
+ * \brief La fonction dessine un instantané du monde. L'affichage est mis à jour par l'appelant avec update_screen
  * \param exe_dir le chemin de l'exécutable, utilisé pour charger les ressources
- * \param window la fenêtre de jeu
  * \param renderer le renderer lié à l'écran de jeu
- * \param world les données du monde
+ * \param resolution la résolution dynamique de la scène, ou NULL pour la dessiner à la résolution de l'écran
  * \param resources les ressources
+ * \param snapshot l'instantané du monde
  */
-void draw_graphics(const char *exe_dir, SDL_Window *window, SDL_Renderer *renderer, resources_t *resources, world_t *world) {
+void draw_graphics(const char *exe_dir, SDL_Renderer *renderer, resolution_t *resolution, resources_t *resources, const snapshot_t *snapshot) {
     clear_renderer(renderer);
 
+    // Tout est dessiné en pixels de la sortie, plus nombreux que ceux de la fenêtre sur un écran à haute densité
     int screen_w_int, screen_h_int;
-    SDL_GetWindowSize(window, &screen_w_int, &screen_h_int);
+    SDL_GetRendererOutputSize(renderer, &screen_w_int, &screen_h_int);
     double screen_w = screen_w_int, screen_h = screen_h_int;
 
-    refresh_font(exe_dir, resources, screen_w * FONT_SIZE);
+    refresh_font(exe_dir, renderer, resources, screen_w * FONT_SIZE);
 
-    if (world->game_state == GAME_STATE_SPLASH_SCREEN) {
-        draw_background(renderer, screen_w, screen_h, world, resources->splash_screen_texture, 0.0);
+    if (snapshot->game_state == GAME_STATE_SPLASH_SCREEN) {
+        draw_background(renderer, screen_w, screen_h, snapshot->level_width, resources->splash_screen_texture, 0.0);
     }
 
-    if (world->game_state == GAME_STATE_LEVEL_COMPLETE_SCREEN) {
-        draw_background(renderer, screen_w, screen_h, world, resources->background_texture, 0);
+    if (snapshot->game_state == GAME_STATE_LEVEL_COMPLETE_SCREEN) {
+        draw_background(renderer, screen_w, screen_h, snapshot->level_width, resources->background_texture, 0);
 
         char message[32];
-        sprintf(message, "Level %d complete!", world->current_level + 1);
-        draw_text(renderer, screen_w / 2, screen_h / 2, true, resources->font, message);
+        sprintf(message, "Level %d complete!", snapshot->current_level + 1);
+        draw_player_particles(renderer, screen_w_int, screen_h_int, resources, snapshot);
+        draw_text(renderer, screen_w / 2, screen_h / 2, true, &resources->glyphs, message);
+        draw_best_time(renderer, screen_w, screen_h, resources, snapshot);
     }
 
-    if (world->game_state == GAME_STATE_END_SCREEN) {
-        draw_background(renderer, screen_w, screen_h, world, resources->background_texture, 0);
+    if (snapshot->game_state == GAME_STATE_END_SCREEN) {
+        draw_background(renderer, screen_w, screen_h, snapshot->level_width, resources->background_texture, 0);
+        draw_player_particles(renderer, screen_w_int, screen_h_int, resources, snapshot);
 
-        if (world->has_won) {
-            draw_text(renderer, screen_w / 2, screen_h / 2, true, resources->font, "You won!");
+        if (snapshot->has_won && snapshot->player_count > 1) {
+            char message[32];
+            sprintf(message, "Player %d won!", fastest_player(snapshot) + 1);
+            draw_text(renderer, screen_w / 2, screen_h / 2, true, &resources->glyphs, message);
+        } else if (snapshot->has_won) {
+            draw_text(renderer, screen_w / 2, screen_h / 2, true, &resources->glyphs, "You won!");
+            draw_best_time(renderer, screen_w, screen_h, resources, snapshot);
         } else {
-            draw_text(renderer, screen_w / 2, screen_h / 2, true, resources->font, "You lost!");
+            draw_text(renderer, screen_w / 2, screen_h / 2, true, &resources->glyphs, "You lost!");
+            draw_text(renderer, screen_w / 2, screen_h / 2 + resources->glyphs.height, true, &resources->glyphs, "Press R to retry");
         }
     }
 
-    if (world->game_state == GAME_STATE_PLAYING) {
-        draw_background(renderer, screen_w, screen_h, world, resources->background_texture, world->camera_offset * BACKGROUND_SPEED);
-
-        SDL_SetTextureAlphaMod(resources->spaceship_texture, (world->invincible ? 0.5 : 1.0) * 255);
-        draw_texture(renderer, resources->spaceship_texture, camera_transform(screen_w, screen_h, world, world->spaceship_rect));
-
-        double flame_intensity = CLAMP(-world->spaceship_speed_y / MAX_USUAL_SPEED, 0.0, 1.0);
-        double flame_rect_w = world->spaceship_rect.w * FLAME_SCALE * flame_intensity;
-        double flame_rect_h = flame_rect_w * resources->flame_surface->h / resources->flame_surface->w;
-        rect_t flame_rect = {world->spaceship_rect.x, world->spaceship_rect.y + world->spaceship_rect.h / 2 + flame_rect_h / 2, flame_rect_w, flame_rect_h};
-        SDL_SetTextureAlphaMod(resources->flame_texture, flame_intensity * (world->invincible ? 0.5 : 1.0) * 255);
-        draw_texture(renderer, resources->flame_texture, camera_transform(screen_w, screen_h, world, flame_rect));
-
-        draw_texture(renderer, resources->finish_line_texture, camera_transform(screen_w, screen_h, world, world->finish_line_rect));
-
-        for (size_t i = 0; i < world->meteorites_count; i++) {
-            draw_texture(renderer, resources->meteorite_texture, camera_transform(screen_w, screen_h, world, world->meteorite_rects[i]));
+    if (snapshot->game_state == GAME_STATE_PLAYING) {
+        if (snapshot->overview_counts != NULL) {
+            refresh_overview_texture(renderer, resources, snapshot);
+        }
+        // La scène est dessinée à l'échelle de la résolution dynamique, le texte reste à la résolution de l'écran
+        int scene_w, scene_h;
+        bool scaled = begin_scene(resolution, renderer, screen_w_int, screen_h_int, &scene_w, &scene_h);
+        for (int p = 0; p < snapshot->player_count; p++) {
+            SDL_Rect viewport = player_viewport(p, snapshot->player_count, scene_w, scene_h);
+            SDL_RenderSetViewport(renderer, &viewport);
+            draw_scene(renderer, viewport.w, viewport.h, resources, snapshot, p);
+        }
+        if (scaled) {
+            end_scene(resolution, renderer);
+        } else {
+            SDL_RenderSetViewport(renderer, NULL);
         }
 
-        /* Mise à jour du temps écoulé et affichage */
-        {
-            char timeText[64];
-            sprintf(timeText, "Time: %.2f s", world->playing_time / 1000.0);
-            // Affichage en haut à gauche
-            draw_text(renderer, 10, 10, false, resources->font, timeText);
+        draw_player_huds(renderer, screen_w_int, screen_h_int, resources, snapshot);
+        if (resolution != NULL && resolution->show) {
+            char text[32];
+            sprintf(text, "Scale: %.0f%%", resolution->scale * 100.0);
+            draw_text(renderer, 10, screen_h - 10 - resources->glyphs.height, false, &resources->glyphs, text);
         }
     }
-
-    // Met à jour l'affichage
-    update_screen(renderer);
 }
 
 void wait_for_next_frame(world_t *world) {
@@ -11,15 +11,34 @@
 
 #include "constants.h"
 #include "game.h"
+#include "resolution.h"
 #include "resources.h"
 #include "sdl2-light.h"
+#include "snapshot.h"
 #include <SDL2/SDL_ttf.h>
 
-void draw_texture(SDL_Renderer *renderer, SDL_Texture *texture, rect_t rect);
+double camera_scale(double screen_w, double screen_h, double level_width, double zoom);
 
-void draw_background(SDL_Renderer *renderer, double screen_w, double screen_h, world_t *world, SDL_Texture *texture, double scroll_offset);
+rect_t camera_transform(double screen_w, double screen_h, double level_width, double zoom, double camera_offset, rect_t rect);
 
-void draw_graphics(const char *exe_dir, SDL_Window *window, SDL_Renderer *renderer, resources_t *resources, world_t *world);
+double meteorite_sprite_fade(double scale);
+
+SDL_Rect player_viewport(int player, int player_count, int screen_w, int screen_h);
+
+void draw_sprite(SDL_Renderer *renderer, const sprite_t *sprite, rect_t rect);
+
+void draw_sprite_rotated(SDL_Renderer *renderer, const sprite_t *sprite, rect_t rect, double angle);
+
+void draw_meteorites(SDL_Renderer *renderer, double screen_w, double screen_h, const snapshot_t *snapshot, double camera_offset, const sprite_t *sprite);
+
+void draw_particles(SDL_Renderer *renderer, double screen_w, double screen_h, const snapshot_t *snapshot, double camera_offset, resources_t *resources);
+
+void draw_background(SDL_Renderer *renderer, double screen_w, double screen_h, double level_width, SDL_Texture *texture, double scroll_offset);
+
+void draw_parallax_background(SDL_Renderer *renderer, double screen_w, double screen_h, double level_width, resources_t *resources,
+                              double camera_offset);
+
+void draw_graphics(const char *exe_dir, SDL_Renderer *renderer, resolution_t *resolution, resources_t *resources, const snapshot_t *snapshot);
 
 void wait_for_next_frame(world_t *world);
 
@@ -0,0 +1,145 @@
+/**
+ * \file latency.c
+ * \brief Fichier contenant la mesure de la latence des entrées, de l'évènement clavier jusqu'à la physique et jusqu'à l'affichage
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#include "latency.h"
+#include "utilities.h"
+
+/**
+ * \brief La fonction horodate les évènements clavier au moment où ils sont ajoutés à la file de la SDL
+ * \param data la mesure de latence
+ * \param event l'évènement
+ * \return 0 (la valeur est ignorée par la SDL)
+ */
+static int input_event_watch(void *data, SDL_Event *event) {
+    input_latency_t *latency = data;
+    if ((event->type == SDL_KEYDOWN || event->type == SDL_KEYUP) && !event->key.repeat) {
+        int head = SDL_AtomicGet(&latency->head);
+        // Si la file est pleine, l'évènement n'est pas mesuré
+        if (head - SDL_AtomicGet(&latency->tail) < INPUT_EVENT_QUEUE_SIZE) {
+            latency->event_counters[head % INPUT_EVENT_QUEUE_SIZE] = SDL_GetPerformanceCounter();
+            SDL_AtomicSet(&latency->head, head + 1);
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief La fonction initialise la mesure de latence et commence à horodater les évènements clavier
+ * \param latency la mesure de latence
+ */
+void init_input_latency(input_latency_t *latency) {
+    memset(latency, 0, sizeof(*latency));
+    SDL_AddEventWatch(input_event_watch, latency);
+}
+
+/**
+ * \brief La fonction ajoute une latence, ou toute autre durée, à un histogramme
+ * \param histogram l'histogramme
+ * \param counter la durée, en ticks de SDL_GetPerformanceCounter
+ */
+void record_latency(latency_histogram_t *histogram, Uint64 counter) {
+    double ms = counter * 1000.0 / SDL_GetPerformanceFrequency();
+    histogram->count++;
+    histogram->total_ms += ms;
+    histogram->max_ms = MAX(histogram->max_ms, ms);
+    histogram->buckets[MIN((size_t)(ms / LATENCY_BUCKET_WIDTH), LATENCY_BUCKET_COUNT - 1)]++;
+}
+
+/**
+ * \brief La fonction marque le début d'un pas de simulation. Elle doit être appelée avant de retirer les évènements de la file de la SDL, pour que
+ * tous les évènements horodatés jusqu'ici soient bien appliqués par ce pas.
+ * \param latency la mesure de latence
+ */
+void begin_input_step(input_latency_t *latency) {
+    latency->step_head = SDL_AtomicGet(&latency->head);
+}
+
+/**
+ * \brief La fonction mesure la latence jusqu'à la physique des évènements appliqués par le pas qui vient de se terminer
+ * \param latency la mesure de latence
+ * \param sequence le numéro de l'instantané qui sera publié pour ce pas
+ * \return l'horodatage du plus ancien évènement pas encore affiché, ou 0 s'il n'y en a pas
+ */
+Uint64 finish_input_step(input_latency_t *latency, int sequence) {
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (latency->pending_counter != 0 && SDL_AtomicGet(&latency->presented_sequence) >= latency->pending_sequence) {
+        latency->pending_counter = 0;
+    }
+    for (int i = SDL_AtomicGet(&latency->tail); i != latency->step_head; i++) {
+        Uint64 event_counter = latency->event_counters[i % INPUT_EVENT_QUEUE_SIZE];
+        record_latency(&latency->physics, now - event_counter);
+        if (latency->pending_counter == 0) {
+            latency->pending_counter = event_counter;
+            latency->pending_sequence = sequence;
+        }
+    }
+    SDL_AtomicSet(&latency->tail, latency->step_head);
+    return latency->pending_counter;
+}
+
+/**
+ * \brief La fonction mesure la latence jusqu'à l'affichage, juste après la présentation d'un instantané
+ * \param latency la mesure de latence
+ * \param input_counter l'horodatage du plus ancien évènement pris en compte par l'instantané et pas encore affiché, ou 0
+ * \param sequence le numéro de l'instantané présenté
+ */
+void record_input_present(input_latency_t *latency, Uint64 input_counter, int sequence) {
+    if (input_counter != 0 && input_counter != latency->last_presented_counter) {
+        record_latency(&latency->present, SDL_GetPerformanceCounter() - input_counter);
+        latency->last_presented_counter = input_counter;
+    }
+    SDL_AtomicSet(&latency->presented_sequence, sequence);
+}
+
+/**
+ * \brief La fonction donne un centile d'un histogramme non vide, arrondi à la borne supérieure de son intervalle
+ * \param histogram l'histogramme
+ * \param percent le centile, de 1 à 100
+ * \return la latence du centile, en ms, au plus la latence maximale
+ */
+double latency_percentile(const latency_histogram_t *histogram, int percent) {
+    Uint64 rank = (histogram->count * percent + 99) / 100, seen = 0;
+    size_t bucket = 0;
+    while (bucket < LATENCY_BUCKET_COUNT - 1 && seen + histogram->buckets[bucket] < rank) {
+        seen += histogram->buckets[bucket++];
+    }
+    return MIN((bucket + 1) * LATENCY_BUCKET_WIDTH, histogram->max_ms);
+}
+
+/**
+ * \brief La fonction affiche un histogramme de latences
+ * \param name le nom de la mesure
+ * \param histogram l'histogramme
+ */
+void report_latency(const char *name, const latency_histogram_t *histogram) {
+    if (histogram->count == 0) {
+        printf("  %s : aucune mesure\n", name);
+        return;
+    }
+    printf("  %s : %llu mesures, moyenne %.2f ms, p99 %.1f ms, max %.2f ms\n", name, (unsigned long long)histogram->count,
+           histogram->total_ms / histogram->count, latency_percentile(histogram, 99), histogram->max_ms);
+}
+
+/**
+ * \brief La fonction affiche les mesures de latence. Elle doit être appelée une fois les deux fils arrêtés
+ * \param latency la mesure de latence
+ * \param late_input indique si les entrées étaient échantillonnées tardivement
+ */
+void report_input_latency(input_latency_t *latency, bool late_input) {
+    printf("Latence des entrées (échantillonnage tardif %s) :\n", late_input ? "activé" : "désactivé");
+    report_latency("évènement -> physique", &latency->physics);
+    report_latency("évènement -> affichage", &latency->present);
+}
+
+/**
+ * \brief La fonction arrête l'horodatage des évènements clavier
+ * \param latency la mesure de latence
+ */
+void clean_input_latency(input_latency_t *latency) {
+    SDL_DelEventWatch(input_event_watch, latency);
+}
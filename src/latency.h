@@ -0,0 +1,78 @@
+/**
+ * \file latency.h
+ * \brief Fichier contenant la mesure de la latence des entrées, de l'évènement clavier jusqu'à la physique et jusqu'à l'affichage
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#ifndef __LATENCY_H__
+#define __LATENCY_H__
+
+#include <SDL.h>
+#include <stdbool.h>
+
+/**
+ * \brief Capacité de la file des horodatages d'évènements clavier (puissance de 2)
+ */
+#define INPUT_EVENT_QUEUE_SIZE 256
+
+/**
+ * \brief Nombre d'intervalles de l'histogramme des latences
+ */
+#define LATENCY_BUCKET_COUNT 1000
+
+/**
+ * \brief Largeur d'un intervalle de l'histogramme des latences, en millisecondes
+ */
+#define LATENCY_BUCKET_WIDTH 0.1
+
+/**
+ * \brief Histogramme de latences
+ */
+typedef struct latency_histogram_s {
+    Uint64 count;
+    double total_ms;
+    double max_ms;
+    Uint32 buckets[LATENCY_BUCKET_COUNT]; /*!< Le dernier intervalle regroupe toutes les latences trop grandes */
+} latency_histogram_t;
+
+/**
+ * \brief Mesure de la latence des entrées
+ *
+ * Les évènements clavier sont horodatés au moment où ils entrent dans la file de la SDL (fil d'affichage), puis transmis au fil de simulation par une
+ * file sans verrou. La simulation mesure la latence jusqu'au pas de physique qui les applique, et l'affichage jusqu'à la présentation du premier
+ * instantané qui en tient compte.
+ */
+typedef struct input_latency_s {
+    Uint64 event_counters[INPUT_EVENT_QUEUE_SIZE]; /*!< Horodatages des évènements, en ticks de SDL_GetPerformanceCounter */
+    SDL_atomic_t head;                             /*!< Écrit par le fil d'affichage */
+    SDL_atomic_t tail;                             /*!< Écrit par le fil de simulation */
+    int step_head;                                 /*!< Fin des évènements appliqués par le pas de physique en cours */
+    Uint64 pending_counter;                        /*!< Plus ancien évènement appliqué mais pas encore affiché */
+    int pending_sequence;                          /*!< Premier instantané contenant cet évènement */
+    SDL_atomic_t presented_sequence;               /*!< Dernier instantané présenté, écrit par le fil d'affichage */
+    Uint64 last_presented_counter;                 /*!< Dernier évènement dont la latence d'affichage a été mesurée */
+    latency_histogram_t physics;                   /*!< Latences jusqu'à la physique, écrites par le fil de simulation */
+    latency_histogram_t present;                   /*!< Latences jusqu'à l'affichage, écrites par le fil d'affichage */
+} input_latency_t;
+
+void record_latency(latency_histogram_t *histogram, Uint64 counter);
+
+double latency_percentile(const latency_histogram_t *histogram, int percent);
+
+void report_latency(const char *name, const latency_histogram_t *histogram);
+
+void init_input_latency(input_latency_t *latency);
+
+void begin_input_step(input_latency_t *latency);
+
+Uint64 finish_input_step(input_latency_t *latency, int sequence);
+
+void record_input_present(input_latency_t *latency, Uint64 input_counter, int sequence);
+
+void report_input_latency(input_latency_t *latency, bool late_input);
+
+void clean_input_latency(input_latency_t *latency);
+
+#endif
@@ -8,36 +8,86 @@
 
 #include "level.h"
 #include "constants.h"
+#include "logger.h"
+#include "overview.h"
+#include "trace.h"
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 
+/**
+ * \brief Charge l'image d'un niveau, depuis le répertoire des niveaux s'il est défini, sinon depuis les ressources
+ * \param exe_dir le chemin de l'exécutable, utilisé pour charger les ressources
+ * \param resources les ressources
+ * \param level le numéro du niveau
+ * \param level_surface_out si non NULL, la surface du niveau sera stockée ici
+ * \param success si non NULL, mis à true si le niveau a été chargé avec succès, false sinon
+ */
+static void load_level_image(const char *exe_dir, resources_t *resources, int level, SDL_Surface **level_surface_out, bool *success) {
+    char level_path[30];
+    if (resources->levels_dir != NULL) {
+        sprintf(level_path, "level_%d.png", level);
+        load_image(NULL, resources->levels_dir, level_path, level_surface_out, success);
+    } else {
+        sprintf(level_path, "resources/level_%d.png", level);
+        load_resource_image(exe_dir, resources, NULL, level_path, level_surface_out, success);
+    }
+}
+
 /**
  * \brief Initialise l'information sur les niveaux du jeu
  * \param exe_dir le chemin de l'exécutable, utilisé pour charger les ressources
+ * \param resources les ressources
  * \param world les données du monde
  */
-void init_levels(const char *exe_dir, world_t *world) {
+void init_levels(const char *exe_dir, resources_t *resources, world_t *world) {
+    TRACE_BEGIN(span);
     bool success = true;
     for (world->level_count = 0; success; world->level_count++) {
-        char level_path[30];
-        sprintf(level_path, "resources/level_%d.png", world->level_count);
-        load_image(NULL, exe_dir, level_path, NULL, &success);
+        load_level_image(exe_dir, resources, world->level_count, NULL, &success);
     }
     world->level_count--;
+    TRACE_END(span, "init_levels");
 }
 
 /**
- * \brief Initialise les éléments du niveau selon le niveau courant
- * \param exe_dir le chemin de l'exécutable, utilisé pour charger les ressources
+ * \brief Décode un pixel du niveau. Un pixel blanc est une météorite fixe ; un autre pixel coloré opaque est une météorite mobile, dont le rouge
+ * code l'amplitude (4 bits de poids fort) et la phase (4 bits de poids faible) de l'oscillation, le vert la vitesse de dérive et le bleu la
+ * vitesse de rotation (entiers signés sur 8 bits).
+ * \param pixel le pixel, au format RGBA8888
+ * \param drift_speed la vitesse de dérive horizontale
+ * \param amplitude l'amplitude d'oscillation horizontale
+ * \param phase la phase d'oscillation
+ * \param angular_speed la vitesse de rotation, en degrés par seconde
+ * \return true si le pixel est une météorite, false sinon
+ */
+static bool decode_meteorite(Uint32 pixel, double *drift_speed, double *amplitude, double *phase, double *angular_speed) {
+    Uint8 red = (pixel >> 24) & 0xFF;
+    Uint8 green = (pixel >> 16) & 0xFF;
+    Uint8 blue = (pixel >> 8) & 0xFF;
+    if ((pixel & 0xFFFFFF) == 0xFFFFFF) {
+        *drift_speed = *amplitude = *phase = *angular_speed = 0.0;
+        return true;
+    }
+    if ((pixel & 0xFF) != 0xFF || (red | green | blue) == 0) {
+        return false;
+    }
+    *amplitude = (red >> 4) / 15.0 * METEORITE_MAX_AMPLITUDE;
+    *phase = (red & 0x0F) / 16.0 * 2.0 * M_PI;
+    *drift_speed = (Sint8)green / 127.0 * METEORITE_MAX_DRIFT_SPEED;
+    *angular_speed = (Sint8)blue / 127.0 * METEORITE_MAX_ANGULAR_SPEED;
+    return true;
+}
+
+/**
+ * \brief Construit les éléments du niveau à partir de son image. Une première passe compte les météorites, pour allouer toutes les données du
+ * niveau dans son arène, à la taille exacte. Le champ de distance est calculé une fois les météorites placées.
  * \param resources les ressources
  * \param world les données du monde
+ * \param level_surface l'image du niveau
+ * \return true si le niveau a été construit, false si la mémoire manque pour son arène
  */
-void init_level(const char *exe_dir, resources_t *resources, world_t *world) {
-    char level_path[30];
-    sprintf(level_path, "resources/level_%d.png", world->current_level);
-    SDL_Surface *level_surface;
-    load_image(NULL, exe_dir, level_path, &level_surface, NULL);
-
+static bool build_level(resources_t *resources, world_t *world, SDL_Surface *level_surface) {
     world->level_width = level_surface->w;
     world->level_height = level_surface->h;
 
@@ -45,16 +95,141 @@ void init_level(const char *exe_dir, resources_t *resources, world_t *world) {
                                        world->level_width * resources->finish_line_surface->h / resources->finish_line_surface->w};
     print_rect("ligne", world->finish_line_rect);
 
-    world->meteorites_count = 0;
-    world->meteorite_rects = malloc(sizeof(rect_t) * level_surface->w * level_surface->h);
-    for (size_t x = 0; x < (size_t)level_surface->w; x++) {
-        for (size_t y = 0; y < (size_t)level_surface->h; y++) {
-            if ((get_pixel_RGBA32(level_surface, x, y) & 0xFFFFFF) == 0xFFFFFF) {
-                world->meteorite_rects[world->meteorites_count] =
-                    (rect_t){(double)x - world->level_width / 2 + 0.5, -(double)(level_surface->h - y - 1), METEORITE_SIZE, METEORITE_SIZE};
-                print_rect("meteorite", world->meteorite_rects[world->meteorites_count]);
-                world->meteorites_count++;
+    size_t meteorite_count = 0;
+    for (size_t y = 0; y < (size_t)level_surface->h; y++) {
+        for (size_t x = 0; x < (size_t)level_surface->w; x++) {
+            double drift_speed, amplitude, phase, angular_speed;
+            meteorite_count += decode_meteorite(get_pixel_RGBA32(level_surface, x, y), &drift_speed, &amplitude, &phase, &angular_speed);
+        }
+    }
+    size_t pixels_size = sizeof(Uint32) * level_surface->w * level_surface->h;
+    size_t arena_size = arena_allocation_size(pixels_size) + meteorites_arena_size(meteorite_count) +
+                        distance_field_arena_size(level_surface->w, level_surface->h) +
+                        overview_arena_size(level_surface->w, level_surface->h, resources->max_texture_width, resources->max_texture_height);
+    if (!reserve_arena(&world->level_arena, arena_size)) {
+        LOG_ERROR("Mémoire insuffisante pour le niveau %dx%d (%zu Mio)", level_surface->w, level_surface->h, arena_size >> 20);
+        return false;
+    }
+    // L'arène étant réservée à la taille exacte, les allocations suivantes ne peuvent pas échouer
+    world->level_pixels = arena_alloc(&world->level_arena, pixels_size);
+    init_meteorites(&world->meteorites, &world->level_arena, meteorite_count);
+    init_distance_field(&world->distance_field, &world->level_arena, level_surface->w, level_surface->h);
+    init_overview(&world->overview, &world->level_arena, level_surface->w, level_surface->h, resources->max_texture_width,
+                  resources->max_texture_height);
+    // Parcours ligne par ligne, pour que les météorites soient triées par ordonnée
+    for (size_t y = 0; y < (size_t)level_surface->h; y++) {
+        for (size_t x = 0; x < (size_t)level_surface->w; x++) {
+            Uint32 pixel = get_pixel_RGBA32(level_surface, x, y);
+            world->level_pixels[y * level_surface->w + x] = pixel;
+            double drift_speed, amplitude, phase, angular_speed;
+            if (!decode_meteorite(pixel, &drift_speed, &amplitude, &phase, &angular_speed)) {
+                continue;
             }
+            double meteorite_x = (double)x - world->level_width / 2 + 0.5;
+            double meteorite_y = -(double)(level_surface->h - y - 1);
+            add_meteorite(&world->meteorites, meteorite_x, meteorite_y, drift_speed, amplitude, phase, angular_speed);
+            world->distance_field.occupied[y * level_surface->w + x] = drift_speed == 0.0 && amplitude == 0.0;
+            add_overview_cell(&world->overview, x, y);
+            print_rect("meteorite", (rect_t){meteorite_x, meteorite_y, METEORITE_SIZE, METEORITE_SIZE});
         }
     }
+    build_meteorite_chunks(&world->meteorites, world->level_width);
+    compute_distance_field(&world->distance_field);
+    return true;
+}
+
+/**
+ * \brief Initialise les éléments du niveau selon le niveau courant
+ * \param exe_dir le chemin de l'exécutable, utilisé pour charger les ressources
+ * \param resources les ressources
+ * \param world les données du monde
+ * \return true si le niveau a été chargé, false si son image n'a pas pu être lue ou si la mémoire manque
+ */
+bool init_level(const char *exe_dir, resources_t *resources, world_t *world) {
+    TRACE_BEGIN(span);
+    SDL_Surface *level_surface = NULL;
+    bool success;
+    load_level_image(exe_dir, resources, world->current_level, &level_surface, &success);
+    if (!success) {
+        LOG_ERROR("Impossible de charger le niveau %d : %s", world->current_level + 1, IMG_GetError());
+        TRACE_END(span, "init_level");
+        return false;
+    }
+    success = build_level(resources, world, level_surface);
+    clean_surface(level_surface);
+    TRACE_END(span, "init_level");
+    return success;
+}
+
+/**
+ * \brief Recharge le niveau courant en cours de partie. Si sa taille n'a pas changé, seules les lignes modifiées sont retirées puis réinsérées
+ * dans les météorites, et le champ de distance n'est recalculé qu'autour d'elles ; sinon le niveau est reconstruit. Le vaisseau, la caméra et le temps de
+ * jeu sont conservés.
+ * \param resources les ressources
+ * \param world les données du monde
+ * \param level_surface la nouvelle image du niveau
+ * \return true si le niveau est jouable, false si sa reconstruction a échoué faute de mémoire
+ */
+bool reload_level(resources_t *resources, world_t *world, SDL_Surface *level_surface) {
+    TRACE_BEGIN(span);
+    if (level_surface->w != world->level_width || level_surface->h != world->level_height) {
+        clean_meteorites(&world->meteorites);
+        clean_distance_field(&world->distance_field);
+        clean_overview(&world->overview);
+        bool success = build_level(resources, world, level_surface);
+        if (success) {
+            LOG_INFO("Niveau %d reconstruit", world->current_level + 1);
+        }
+        TRACE_END(span, "reload_level");
+        return success;
+    }
+
+    int changed_rows = 0;
+    // Groupe de lignes modifiées pas encore reporté dans le champ de distance, ou -1
+    int band_first = -1, band_last = -1;
+    for (size_t y = 0; y < (size_t)level_surface->h; y++) {
+        Uint32 *row = world->level_pixels + y * level_surface->w;
+        bool changed = false;
+        for (size_t x = 0; x < (size_t)level_surface->w && !changed; x++) {
+            changed = get_pixel_RGBA32(level_surface, x, y) != row[x];
+        }
+        if (!changed) {
+            continue;
+        }
+        changed_rows++;
+        // Deux groupes dont les zones recalculées ne se touchent pas sont reportés séparément, sans recalculer ce qui les sépare
+        if (band_first >= 0 && (int)y - band_last > 2 * DISTANCE_FIELD_SATURATION / DISTANCE_FIELD_RESOLUTION) {
+            update_distance_field(&world->distance_field, band_first, band_last + 1);
+            band_first = -1;
+        }
+        band_first = band_first >= 0 ? band_first : (int)y;
+        band_last = y;
+
+        double meteorite_y = -(double)(level_surface->h - y - 1);
+        remove_meteorite_row(&world->meteorites, meteorite_y, world->level_width);
+        for (size_t x = 0; x < (size_t)level_surface->w; x++) {
+            double drift_speed, amplitude, phase, angular_speed;
+            if (decode_meteorite(row[x], &drift_speed, &amplitude, &phase, &angular_speed)) {
+                remove_overview_cell(&world->overview, x, y);
+            }
+            row[x] = get_pixel_RGBA32(level_surface, x, y);
+            bool meteorite = decode_meteorite(row[x], &drift_speed, &amplitude, &phase, &angular_speed);
+            if (meteorite) {
+                add_overview_cell(&world->overview, x, y);
+                double meteorite_x = (double)x - world->level_width / 2 + 0.5;
+                if (!insert_meteorite(&world->meteorites, meteorite_x, meteorite_y, drift_speed, amplitude, phase, angular_speed, world->level_width)) {
+                    LOG_ERROR("Mémoire insuffisante : météorite (%zu, %zu) ignorée", x, y);
+                    meteorite = false;
+                }
+            }
+            world->distance_field.occupied[y * level_surface->w + x] = meteorite && drift_speed == 0.0 && amplitude == 0.0;
+        }
+    }
+    if (changed_rows > 0) {
+        update_distance_field(&world->distance_field, band_first, band_last + 1);
+        world->overview.version++;
+    }
+    LOG_INFO("Niveau %d rechargé : %d ligne(s) modifiée(s)", world->current_level + 1, changed_rows);
+    TRACE_END(span, "reload_level");
+    return true;
 }
@@ -11,8 +11,10 @@
 
 #include "game.h"
 
-void init_levels(const char *exe_dir, world_t *world);
+void init_levels(const char *exe_dir, resources_t *resources, world_t *world);
 
-void init_level(const char *exe_dir, resources_t *resources, world_t *world);
+bool init_level(const char *exe_dir, resources_t *resources, world_t *world);
+
+bool reload_level(resources_t *resources, world_t *world, SDL_Surface *level_surface);
 
 #endif
\ No newline at end of file
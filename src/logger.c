@@ -0,0 +1,169 @@
+/**
+ * \file logger.c
+ * \brief Fichier contenant le journal des messages de diagnostic, écrits sur la console par un fil en arrière-plan
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#include "logger.h"
+#include <stdarg.h>
+#include <stdio.h>
+
+/**
+ * \brief Le journal du programme, partagé par tous les fils
+ */
+static logger_t logger;
+
+/**
+ * \brief La fonction écrit un message sur la console : la sortie d'erreur pour les avertissements et les erreurs, la sortie standard sinon
+ * \param level le niveau du message
+ * \param message le message
+ */
+static void write_log_message(log_level_t level, const char *message) {
+    fprintf(level >= LOG_LEVEL_WARNING ? stderr : stdout, "%s\n", message);
+}
+
+/**
+ * \brief La fonction écrit les messages remplis de la file, dans l'ordre, jusqu'au premier emplacement encore en cours de remplissage
+ */
+static void drain_log_entries(void) {
+    int count = 0;
+    while (true) {
+        log_entry_t *entry = &logger.entries[logger.tail % LOGGER_QUEUE_SIZE];
+        if (SDL_AtomicGet(&entry->sequence) != logger.tail + 1) {
+            break;
+        }
+        write_log_message(entry->level, entry->message);
+        // L'emplacement est rendu aux producteurs pour le tour suivant de la file
+        SDL_AtomicSet(&entry->sequence, logger.tail + LOGGER_QUEUE_SIZE);
+        logger.tail++;
+        count++;
+    }
+    SDL_AtomicAdd(&logger.written, count);
+    if (count > 0) {
+        fflush(stdout);
+        fflush(stderr);
+    }
+}
+
+/**
+ * \brief La boucle du fil d'écriture : il vide la file à intervalles réguliers, jusqu'à l'arrêt du journal et l'épuisement de la file
+ * \param data inutilisé
+ * \return 0
+ */
+static int logger_thread(void *data) {
+    (void)data;
+    while (true) {
+        bool running = SDL_AtomicGet(&logger.running);
+        drain_log_entries();
+        if (!running) {
+            break;
+        }
+        SDL_Delay(LOGGER_FLUSH_INTERVAL);
+    }
+    return 0;
+}
+
+/**
+ * \brief La fonction démarre le journal et son fil d'écriture. Avant le démarrage, et si le fil ne peut pas être créé, les messages sont écrits
+ * directement par le fil appelant.
+ * \return true si le journal a démarré, false sinon
+ */
+bool start_logger(void) {
+    for (int i = 0; i < LOGGER_QUEUE_SIZE; i++) {
+        SDL_AtomicSet(&logger.entries[i].sequence, i);
+    }
+    SDL_AtomicSet(&logger.head, 0);
+    logger.tail = 0;
+    SDL_AtomicSet(&logger.written, 0);
+    SDL_AtomicSet(&logger.dropped, 0);
+    SDL_AtomicSet(&logger.suppressed, 0);
+    SDL_AtomicSet(&logger.running, 1);
+    logger.thread = SDL_CreateThread(logger_thread, "logger", NULL);
+    if (logger.thread == NULL) {
+        SDL_AtomicSet(&logger.running, 0);
+        fprintf(stderr, "Erreur lors de la creation du fil du journal : %s\n", SDL_GetError());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * \brief La fonction indique si un appel a dépassé son débit dans la fenêtre courante. Les accès concurrents peuvent laisser passer quelques
+ * messages de trop, ce qui est sans conséquence.
+ * \param site la limitation du débit de l'appel
+ * \return true si le message doit être supprimé
+ */
+static bool log_rate_exceeded(log_site_t *site) {
+    int window = (int)(SDL_GetTicks64() / LOGGER_RATE_WINDOW);
+    if (SDL_AtomicGet(&site->window) != window) {
+        SDL_AtomicSet(&site->window, window);
+        SDL_AtomicSet(&site->count, 0);
+    }
+    return SDL_AtomicAdd(&site->count, 1) >= LOGGER_RATE_LIMIT;
+}
+
+/**
+ * \brief La fonction ajoute un message à la file, ou l'abandonne si la file est pleine ou si l'appel a dépassé son débit. Elle peut être appelée
+ * depuis n'importe quel fil : chaque producteur réserve une position en avançant la tête par une comparaison-échange, remplit son emplacement
+ * puis le publie en avançant son numéro de séquence.
+ * \param site la limitation du débit de l'appel
+ * \param level le niveau du message
+ * \param format le format du message, comme pour printf
+ */
+void log_message(log_site_t *site, log_level_t level, const char *format, ...) {
+    va_list arguments;
+    // Les erreurs passent toujours, un échec n'étant jamais répété au point d'inonder la console
+    if (level < LOG_LEVEL_ERROR && log_rate_exceeded(site)) {
+        SDL_AtomicAdd(&logger.suppressed, 1);
+        return;
+    }
+    if (!SDL_AtomicGet(&logger.running)) {
+        char message[LOGGER_MESSAGE_SIZE];
+        va_start(arguments, format);
+        vsnprintf(message, sizeof(message), format, arguments);
+        va_end(arguments);
+        write_log_message(level, message);
+        return;
+    }
+
+    int position = SDL_AtomicGet(&logger.head);
+    log_entry_t *entry;
+    while (true) {
+        entry = &logger.entries[position % LOGGER_QUEUE_SIZE];
+        int difference = SDL_AtomicGet(&entry->sequence) - position;
+        if (difference == 0 && SDL_AtomicCAS(&logger.head, position, position + 1)) {
+            break;
+        }
+        if (difference < 0) {
+            // L'emplacement n'a pas encore été lu au tour précédent : la file est pleine
+            SDL_AtomicAdd(&logger.dropped, 1);
+            return;
+        }
+        position = SDL_AtomicGet(&logger.head);
+    }
+    entry->level = level;
+    va_start(arguments, format);
+    vsnprintf(entry->message, sizeof(entry->message), format, arguments);
+    va_end(arguments);
+    SDL_AtomicSet(&entry->sequence, position + 1);
+}
+
+/**
+ * \brief La fonction écrit les messages restants, arrête le fil d'écriture et indique les messages perdus. Les messages suivants sont écrits
+ * directement.
+ */
+void stop_logger(void) {
+    if (!SDL_AtomicGet(&logger.running)) {
+        return;
+    }
+    SDL_AtomicSet(&logger.running, 0);
+    SDL_WaitThread(logger.thread, NULL);
+    // Un producteur a pu réserver un emplacement juste avant l'arrêt
+    drain_log_entries();
+    int dropped = SDL_AtomicGet(&logger.dropped), suppressed = SDL_AtomicGet(&logger.suppressed);
+    if (dropped > 0 || suppressed > 0) {
+        fprintf(stderr, "Journal : %d message(s) abandonné(s), file pleine, et %d supprimé(s) par la limitation du débit\n", dropped, suppressed);
+    }
+}
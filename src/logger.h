@@ -0,0 +1,113 @@
+/**
+ * \file logger.h
+ * \brief Fichier contenant le journal des messages de diagnostic, écrits sur la console par un fil en arrière-plan
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#ifndef __LOGGER_H__
+#define __LOGGER_H__
+
+#include <SDL.h>
+#include <stdbool.h>
+
+/**
+ * \brief Nombre de messages de la file entre les fils qui écrivent dans le journal et le fil d'écriture
+ */
+#define LOGGER_QUEUE_SIZE 1024
+
+/**
+ * \brief Taille maximale d'un message, zéro final compris ; les messages plus longs sont tronqués
+ */
+#define LOGGER_MESSAGE_SIZE 256
+
+/**
+ * \brief Intervalle (en ms) entre deux vidages de la file par le fil d'écriture
+ */
+#define LOGGER_FLUSH_INTERVAL 50
+
+/**
+ * \brief Durée (en ms) de la fenêtre de limitation du débit de chaque appel
+ */
+#define LOGGER_RATE_WINDOW 1000
+
+/**
+ * \brief Nombre maximal de messages d'un même appel par fenêtre, les suivants étant supprimés
+ */
+#define LOGGER_RATE_LIMIT 20
+
+/**
+ * \brief Niveaux des messages, du plus bavard au plus grave
+ */
+enum log_level_e {
+    LOG_LEVEL_DEBUG,   /*!< Détails pour le développement */
+    LOG_LEVEL_INFO,    /*!< Déroulement de la partie */
+    LOG_LEVEL_WARNING, /*!< Problème sans conséquence sur la partie */
+    LOG_LEVEL_ERROR,   /*!< Échec d'une opération */
+};
+typedef enum log_level_e log_level_t;
+
+/**
+ * \brief Niveau en dessous duquel les messages sont retirés à la compilation, réglé par meson selon le type de build
+ */
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL LOG_LEVEL_DEBUG
+#endif
+
+/**
+ * \brief Limitation du débit d'un appel au journal
+ */
+typedef struct log_site_s {
+    SDL_atomic_t window; /*!< Numéro de la fenêtre courante */
+    SDL_atomic_t count;  /*!< Nombre de messages dans la fenêtre courante */
+} log_site_t;
+
+/**
+ * \brief Message de la file
+ */
+typedef struct log_entry_s {
+    SDL_atomic_t sequence; /*!< Position de file attendue : égale à la position quand l'emplacement est libre, suivante quand il est rempli */
+    log_level_t level;
+    char message[LOGGER_MESSAGE_SIZE];
+} log_entry_t;
+
+/**
+ * \brief Journal. Les messages passent des fils qui écrivent dans le journal au fil d'écriture par une file circulaire sans verrou, à plusieurs
+ * producteurs et un seul consommateur : un message n'est qu'un formatage en mémoire et quelques opérations atomiques, sans appel système.
+ */
+typedef struct logger_s {
+    log_entry_t entries[LOGGER_QUEUE_SIZE];
+    SDL_atomic_t head; /*!< Prochaine position réservée par un producteur */
+    int tail;          /*!< Prochaine position lue, propriété du fil d'écriture */
+    SDL_atomic_t running;
+    SDL_atomic_t written;    /*!< Nombre de messages écrits */
+    SDL_atomic_t dropped;    /*!< Nombre de messages abandonnés, la file étant pleine */
+    SDL_atomic_t suppressed; /*!< Nombre de messages supprimés par la limitation du débit */
+    SDL_Thread *thread;
+} logger_t;
+
+/**
+ * \brief Ajoute un message au journal, avec un format de printf et sans retour à la ligne final. Chaque appel a sa propre limitation du débit ;
+ * les appels d'un niveau inférieur à LOG_MIN_LEVEL sont retirés à la compilation.
+ */
+#define LOG(level, ...)                                                                                                                                        \
+    do {                                                                                                                                                       \
+        if ((level) >= LOG_MIN_LEVEL) {                                                                                                                        \
+            static log_site_t log_site;                                                                                                                        \
+            log_message(&log_site, (level), __VA_ARGS__);                                                                                                      \
+        }                                                                                                                                                      \
+    } while (false)
+
+#define LOG_DEBUG(...) LOG(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define LOG_INFO(...) LOG(LOG_LEVEL_INFO, __VA_ARGS__)
+#define LOG_WARNING(...) LOG(LOG_LEVEL_WARNING, __VA_ARGS__)
+#define LOG_ERROR(...) LOG(LOG_LEVEL_ERROR, __VA_ARGS__)
+
+bool start_logger(void);
+
+void log_message(log_site_t *site, log_level_t level, const char *format, ...) SDL_PRINTF_VARARG_FUNC(3);
+
+void stop_logger(void);
+
+#endif
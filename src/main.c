@@ -6,9 +6,19 @@
  * \date 1er mai 2025
  */
 
+#include "allocations.h"
+#include "benchmark.h"
+#include "capture.h"
 #include "constants.h"
+#include "cpu_usage.h"
 #include "game.h"
 #include "graphics.h"
+#include "level.h"
+#include "logger.h"
+#include "offscreen.h"
+#include "options.h"
+#include "simulation.h"
+#include "trace.h"
 #include <libgen.h>
 
 /**
@@ -18,14 +28,21 @@
  * \param renderer le renderer
  * \param resources les ressources
  * \param world le monde
+ * \param low_latency_audio ouvrir l'audio avec un petit tampon
  */
-void init(const char *exe_dir, SDL_Window **window, SDL_Renderer **renderer, resources_t *resources, world_t *world) {
+void init(const char *exe_dir, SDL_Window **window, SDL_Renderer **renderer, resources_t *resources, world_t *world, bool low_latency_audio) {
     init_sdl(window, renderer, INITIAL_SCREEN_WIDTH, INITIAL_SCREEN_HEIGHT);
     init_ttf();
-    init_mix();
+    init_mix(low_latency_audio);
     SDL_SetWindowTitle(*window, "Spacecorridor"); // Définir le titre de la fenêtre
-    init_resources(exe_dir, *renderer, resources);
-    init_data(exe_dir, world);
+    if (!init_resources(exe_dir, *renderer, resources)) {
+        clean_resources(resources);
+        clean_mix();
+        clean_ttf();
+        clean_sdl(*renderer, *window);
+        exit(1);
+    }
+    init_data(exe_dir, resources, world);
 }
 
 /**
@@ -47,11 +64,26 @@ void clean(SDL_Window *window, SDL_Renderer *renderer, resources_t *resources, w
  * \brief programme principal qui implémente la boucle du jeu
  */
 int main(int argc, char **argv) {
+    // comptage des allocations dans les builds de débogage, avant toute allocation de SDL
+    init_allocation_hook();
     if (argc == 0) {
         fprintf(stderr, "Chemin du programme requis\n");
         exit(1);
     }
 
+    options_t options;
+    parse_options(argc, argv, &options);
+
+    // journal des diagnostics, écrit sur la console par un fil en arrière-plan jusqu'à la sortie du programme
+    start_logger();
+    atexit(stop_logger);
+
+    // chronologie des fils, écrite à la sortie du programme, avant l'arrêt du journal
+    if (options.trace_path != NULL && start_trace(options.trace_path)) {
+        name_trace_thread("main");
+        atexit(stop_trace);
+    }
+
     world_t world;
     resources_t resources;
     SDL_Renderer *renderer;
@@ -61,25 +93,196 @@ int main(int argc, char **argv) {
     char *exe_path = strdup(argv[0]);
     char *exe_dir = strdup(dirname(exe_path));
     free(exe_path);
-    init(exe_dir, &window, &renderer, &resources, &world);
 
+    // dessin hors écran, sans fenêtre
+    if (options.offscreen_dir != NULL) {
+        int status = run_offscreen(exe_dir, &options);
+        free(exe_dir);
+        return status;
+    }
+
+    // banc d'essai sans fenêtre, niveau par niveau
+    if (options.benchmark_dir != NULL) {
+        int status = run_benchmark(exe_dir, &options);
+        free(exe_dir);
+        return status;
+    }
+
+    init(exe_dir, &window, &renderer, &resources, &world, options.low_latency_audio);
+
+    // surveillance des niveaux, rechargés pendant la partie
+    level_watcher_t level_watcher;
+    bool watching = false;
+    if (options.levels_dir != NULL) {
+        resources.levels_dir = options.levels_dir;
+        init_levels(exe_dir, &resources, &world);
+        watching = start_level_watcher(&level_watcher, options.levels_dir);
+    }
+
+    // fantômes des meilleures courses, chargés au début de chaque niveau
+    init_ghosts(&world.ghosts, options.ghosts_dir);
+
+    // joueurs sur le même écran, chacun dans sa vue
+    world.player_count = options.players;
+
+    // enregistrement de la partie, lu depuis le renderer et écrit par un fil en arrière-plan
+    capture_t capture;
+    bool recording = false;
+    if (options.record_path != NULL) {
+        int output_w, output_h;
+        SDL_GetRendererOutputSize(renderer, &output_w, &output_h);
+        size_t path_length = strlen(options.record_path);
+        bool video = path_length >= 4 && strcmp(options.record_path + path_length - 4, ".y4m") == 0;
+        recording = start_capture(&capture, options.record_path, video ? CAPTURE_FORMAT_Y4M : CAPTURE_FORMAT_PNG, output_w, output_h, true,
+                                  options.record_fps);
+        // l'enregistrement lit chaque image du renderer, les écrans fixes doivent donc être redessinés à chaque frame
+        options.no_idle = true;
+    }
+
+    // enregistrement des évènements de partie, écrits par un fil en arrière-plan
+    static telemetry_t telemetry;
+    bool telemetry_enabled = false;
+    if (options.telemetry_dir != NULL) {
+        telemetry_enabled =
+            start_telemetry(&telemetry, options.telemetry_dir, options.telemetry_binary ? TELEMETRY_FORMAT_BINARY : TELEMETRY_FORMAT_NDJSON);
+        world.telemetry = telemetry_enabled ? &telemetry : NULL;
+    }
+
+    // records personnels, lus au démarrage et écrits par un fil en arrière-plan
+    static records_t records;
+    bool records_enabled = false;
+    if (options.records_path != NULL) {
+        records_enabled = start_records(&records, options.records_path);
+        world.records = records_enabled ? &records : NULL;
+    }
+
+    // la simulation tourne dans son propre fil, le fil principal ne fait que pomper les évènements et afficher les instantanés
+    simulation_t simulation;
+    start_simulation(&simulation, exe_dir, &options, &resources, &world, watching ? &level_watcher : NULL);
+
+    int playing_frames = 0, drawn_level = -1, drawn_w = 0, drawn_h = 0; // frames de jeu consécutives, pour la vérification des allocations
+    int drawn_overview_version = 0; // un niveau rechargé recrée la texture de sa carte, et recommence le décompte
+
+    // Les écrans fixes ne sont redessinés que lorsque leur image change : changement d'état, de taille de la fenêtre ou évènement de la fenêtre
+    game_state_t drawn_state = GAME_STATE_QUIT;
+    bool drawn_idle = false, drawn_has_won = false, redraw = false;
+    int woken_sequence = 0;
+
+    cpu_usage_t cpu_usage;
+    init_cpu_usage(&cpu_usage);
+
+    // résolution de la scène de jeu, adaptée au temps de dessin mesuré
+    resolution_t resolution;
+    init_resolution(&resolution, options.frame_budget, options.profile);
     while (true) {
-        // gestion des évènements
-        handle_events(exe_dir, &resources, &world);
+        // remplissage de la file d'évènements, traitée par la simulation
+        TRACE_BEGIN(pump_span);
+        SDL_PumpEvents();
+        TRACE_END(pump_span, "pump_events");
 
-        // mise à jour des données liée à la physique du monde
-        update_data(exe_dir, &resources, &world);
-        if (world.game_state == GAME_STATE_QUIT) { // tant que le jeu n'est pas fini
+        int screen_w, screen_h;
+        SDL_GetWindowSize(window, &screen_w, &screen_h);
+        set_simulation_screen_size(&simulation, screen_w, screen_h);
+
+        bool fresh;
+        const snapshot_t *snapshot = acquire_snapshot(&simulation.snapshots, &fresh);
+        if (snapshot->game_state == GAME_STATE_QUIT) { // tant que le jeu n'est pas fini
             break;
         }
 
-        // rafraichissement de l'écran
-        draw_graphics(exe_dir, window, renderer, &resources, &world);
+        if (options.profile) {
+            sample_cpu_usage(&cpu_usage, snapshot->game_state);
+        }
+
+        // rafraichissement de l'écran, uniquement s'il y a un nouvel instantané, et sur un écran fixe uniquement si son image a changé
+        bool idle = snapshot->idle && !options.no_idle;
+        bool changed = !idle || !drawn_idle || snapshot->game_state != drawn_state || snapshot->has_won != drawn_has_won || screen_w != drawn_w ||
+                       screen_h != drawn_h;
+        if ((fresh && changed) || redraw) {
+            redraw = false;
+            drawn_state = snapshot->game_state;
+            drawn_idle = idle;
+            drawn_has_won = snapshot->has_won;
+            bool same_level = snapshot->game_state == GAME_STATE_PLAYING && snapshot->current_level == drawn_level &&
+                              snapshot->overview_version == drawn_overview_version;
+            playing_frames = same_level && screen_w == drawn_w && screen_h == drawn_h ? playing_frames + 1 : 0;
+            drawn_level = snapshot->game_state == GAME_STATE_PLAYING ? snapshot->current_level : -1;
+            drawn_overview_version = snapshot->overview_version;
+            drawn_w = screen_w;
+            drawn_h = screen_h;
+            Uint64 allocations = allocation_count();
+            Uint64 draw_start = SDL_GetPerformanceCounter();
+            TRACE_BEGIN(draw_span);
+            draw_graphics(exe_dir, renderer, &resolution, &resources, snapshot);
+            TRACE_END(draw_span, "draw_graphics");
+            Uint64 draw_time = SDL_GetPerformanceCounter() - draw_start;
+            if (playing_frames > ALLOCATION_CHECK_WARMUP_FRAMES) {
+                expect_no_allocation(allocations, "l'affichage");
+            }
+            if (recording) {
+                TRACE_BEGIN(capture_span);
+                capture_renderer(&capture, renderer);
+                TRACE_END(capture_span, "capture_renderer");
+            }
+            if (options.late_input) {
+                // dernier remplissage de la file d'évènements avant la présentation, qui peut bloquer longtemps
+                SDL_PumpEvents();
+            }
+            Uint64 present_start = SDL_GetPerformanceCounter();
+            TRACE_BEGIN(present_span);
+            update_screen(renderer);
+            TRACE_END(present_span, "present");
+            // Le renderer n'attend pas la synchronisation verticale : la présentation mesure le travail du GPU en attente
+            draw_time += SDL_GetPerformanceCounter() - present_start;
+            record_frame_time(&resolution, draw_time * 1000.0 / SDL_GetPerformanceFrequency());
+            record_input_present(&simulation.input_latency, snapshot->input_counter, snapshot->sequence);
+        }
+
+        TRACE_BEGIN(wait_span);
+        if (idle && snapshot->sequence != woken_sequence) {
+            // Attente du prochain évènement ou de la fin de l'écran, puis réveil de la simulation pour qu'elle le traite
+            bool woken = SDL_WaitEventTimeout(NULL, (int)snapshot->idle_time_left);
+            redraw = woken && SDL_PeepEvents(NULL, 0, SDL_PEEKEVENT, SDL_WINDOWEVENT, SDL_WINDOWEVENT) > 0;
+            wake_simulation(&simulation);
+            woken_sequence = snapshot->sequence;
+        } else if (!fresh) {
+            SDL_Delay(1);
+        }
+        TRACE_END(wait_span, "wait");
+    }
+
+    stop_simulation(&simulation);
+    if (watching) {
+        stop_level_watcher(&level_watcher);
+    }
+    if (telemetry_enabled) {
+        stop_telemetry(&telemetry);
+        if (options.profile) {
+            printf("Télémétrie : %d évènements écrits, %d abandonnés\n", SDL_AtomicGet(&telemetry.written), SDL_AtomicGet(&telemetry.dropped));
+        }
+    }
+    if (records_enabled) {
+        stop_records(&records);
+        if (options.profile) {
+            printf("Records : %d courses écrites, %d abandonnées, %d compactions du journal\n", SDL_AtomicGet(&records.written),
+                   SDL_AtomicGet(&records.dropped), SDL_AtomicGet(&records.compactions));
+        }
+    }
+    if (recording) {
+        stop_capture(&capture);
+        printf("Enregistrement : %d images encodées, %d abandonnées\n", SDL_AtomicGet(&capture.encoded), SDL_AtomicGet(&capture.dropped));
+    }
 
-        wait_for_next_frame(&world);
+    if (options.profile) {
+        stop_audio(&resources.audio);
+        report_audio_latency(&resources.audio);
+        report_cpu_usage(&cpu_usage, !options.no_idle);
+        report_resolution(&resolution);
+        report_particles(&world.particles);
     }
 
     // nettoyage final
+    clean_resolution(&resolution);
     clean(window, renderer, &resources, &world);
     free(exe_dir);
 
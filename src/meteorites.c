@@ -0,0 +1,421 @@
+/**
+ * \file meteorites.c
+ * \brief Fichier contenant le stockage des météorites en tableaux contigus et leur mise à jour par groupes
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#include "meteorites.h"
+#include "constants.h"
+#include "utilities.h"
+#include <math.h>
+#include <string.h>
+
+/**
+ * \brief Nombre de tableaux de la structure de tableaux
+ */
+#define METEORITE_ARRAY_COUNT 8
+
+/**
+ * \brief Décalage entier ajouté avant de tronquer, pour que la troncature donne la partie entière des valeurs négatives ; les nombres de tours
+ * restent bien en dessous en valeur absolue
+ */
+#define METEORITE_WRAP_OFFSET 1073741824.0
+
+/**
+ * \brief La fonction fait pointer les tableaux vers leurs parties du bloc contigu
+ * \param meteorites les météorites
+ * \param block le bloc, de METEORITE_ARRAY_COUNT * capacity doubles
+ */
+static void set_meteorite_arrays(meteorites_t *meteorites, double *block) {
+    size_t capacity = meteorites->capacity;
+    meteorites->x = block;
+    meteorites->y = block + capacity;
+    meteorites->angle = block + capacity * 2;
+    meteorites->base_x = block + capacity * 3;
+    meteorites->drift_speed = block + capacity * 4;
+    meteorites->oscillation_cos = block + capacity * 5;
+    meteorites->oscillation_sin = block + capacity * 6;
+    meteorites->angular_speed = block + capacity * 7;
+}
+
+/**
+ * \brief La fonction donne la place qu'occupe dans l'arène le stockage d'un nombre donné de météorites
+ * \param count le nombre de météorites
+ * \return la taille à réserver dans l'arène
+ */
+size_t meteorites_arena_size(size_t count) {
+    size_t block_count = MAX((count + METEORITE_CHUNK_SIZE - 1) / METEORITE_CHUNK_SIZE, 1);
+    return arena_allocation_size(sizeof(double) * METEORITE_ARRAY_COUNT * block_count * METEORITE_CHUNK_SIZE) +
+           arena_allocation_size(sizeof(meteorite_chunk_t) * block_count) + arena_allocation_size(sizeof(size_t) * block_count);
+}
+
+/**
+ * \brief La fonction alloue le stockage des météorites dans l'arène du niveau. Chaque groupe occupant son propre bloc, les listes des groupes et
+ * des blocs libres ont autant d'emplacements qu'il y a de blocs.
+ * \param meteorites les météorites
+ * \param arena l'arène du niveau
+ * \param capacity le nombre de météorites prévu, le stockage grandissant au besoin
+ */
+void init_meteorites(meteorites_t *meteorites, arena_t *arena, size_t capacity) {
+    meteorites->arena = arena;
+    meteorites->count = 0;
+    meteorites->capacity = MAX((capacity + METEORITE_CHUNK_SIZE - 1) / METEORITE_CHUNK_SIZE, 1) * METEORITE_CHUNK_SIZE;
+    meteorites->next_block = 0;
+    // Un seul bloc contigu, découpé en tableaux
+    set_meteorite_arrays(meteorites, arena_alloc(arena, sizeof(double) * METEORITE_ARRAY_COUNT * meteorites->capacity));
+    meteorites->chunk_count = 0;
+    meteorites->chunks = arena_alloc(arena, sizeof(meteorite_chunk_t) * (meteorites->capacity / METEORITE_CHUNK_SIZE));
+    meteorites->free_block_count = 0;
+    meteorites->free_blocks = arena_alloc(arena, sizeof(size_t) * (meteorites->capacity / METEORITE_CHUNK_SIZE));
+}
+
+/**
+ * \brief La fonction double la capacité du stockage, dans une nouvelle partie de l'arène. Les indices des météorites ne changent pas ; l'ancien
+ * stockage n'est rendu qu'à la réinitialisation de l'arène.
+ * \param meteorites les météorites
+ * \return true si le stockage a grandi, false si la mémoire manque, le stockage restant alors inchangé
+ */
+static bool grow_meteorites(meteorites_t *meteorites) {
+    double *arrays[METEORITE_ARRAY_COUNT] = {meteorites->x,           meteorites->y,          meteorites->angle,
+                                             meteorites->base_x,      meteorites->drift_speed, meteorites->oscillation_cos,
+                                             meteorites->oscillation_sin, meteorites->angular_speed};
+    size_t capacity = meteorites->capacity * 2;
+    double *block = arena_alloc(meteorites->arena, sizeof(double) * METEORITE_ARRAY_COUNT * capacity);
+    meteorite_chunk_t *chunks = arena_alloc(meteorites->arena, sizeof(meteorite_chunk_t) * (capacity / METEORITE_CHUNK_SIZE));
+    size_t *free_blocks = arena_alloc(meteorites->arena, sizeof(size_t) * (capacity / METEORITE_CHUNK_SIZE));
+    // Les allocations déjà faites sont rendues avec l'arène
+    if (block == NULL || chunks == NULL || free_blocks == NULL) {
+        return false;
+    }
+    meteorites->capacity = capacity;
+    for (size_t a = 0; a < METEORITE_ARRAY_COUNT; a++) {
+        memcpy(block + a * capacity, arrays[a], sizeof(double) * meteorites->next_block);
+    }
+    set_meteorite_arrays(meteorites, block);
+    memcpy(chunks, meteorites->chunks, sizeof(meteorite_chunk_t) * meteorites->chunk_count);
+    meteorites->chunks = chunks;
+    memcpy(free_blocks, meteorites->free_blocks, sizeof(size_t) * meteorites->free_block_count);
+    meteorites->free_blocks = free_blocks;
+    return true;
+}
+
+/**
+ * \brief La fonction déplace des météorites d'une position à une autre dans tous les tableaux
+ * \param meteorites les météorites
+ * \param destination l'indice de destination
+ * \param source l'indice de source
+ * \param n le nombre de météorites
+ */
+static void move_meteorites(meteorites_t *meteorites, size_t destination, size_t source, size_t n) {
+    double *arrays[METEORITE_ARRAY_COUNT] = {meteorites->x,           meteorites->y,          meteorites->angle,
+                                             meteorites->base_x,      meteorites->drift_speed, meteorites->oscillation_cos,
+                                             meteorites->oscillation_sin, meteorites->angular_speed};
+    for (size_t a = 0; a < METEORITE_ARRAY_COUNT; a++) {
+        memmove(arrays[a] + destination, arrays[a] + source, sizeof(double) * n);
+    }
+}
+
+/**
+ * \brief La fonction crée un groupe vide dans un bloc libre, à une position donnée de la liste des groupes
+ * \param meteorites les météorites
+ * \param c la position du nouveau groupe
+ * \return le nouveau groupe, ou NULL si le stockage n'a pas pu grandir
+ */
+static meteorite_chunk_t *insert_meteorite_chunk(meteorites_t *meteorites, size_t c) {
+    size_t start;
+    if (meteorites->free_block_count > 0) {
+        start = meteorites->free_blocks[--meteorites->free_block_count];
+    } else {
+        if (meteorites->next_block + METEORITE_CHUNK_SIZE > meteorites->capacity && !grow_meteorites(meteorites)) {
+            return NULL;
+        }
+        start = meteorites->next_block;
+        meteorites->next_block += METEORITE_CHUNK_SIZE;
+    }
+    memmove(&meteorites->chunks[c + 1], &meteorites->chunks[c], sizeof(meteorite_chunk_t) * (meteorites->chunk_count - c));
+    meteorites->chunk_count++;
+    meteorites->chunks[c] = (meteorite_chunk_t){.start = start, .end = start};
+    return &meteorites->chunks[c];
+}
+
+/**
+ * \brief La fonction retire un groupe vide et rend son bloc
+ * \param meteorites les météorites
+ * \param c la position du groupe
+ */
+static void remove_meteorite_chunk(meteorites_t *meteorites, size_t c) {
+    meteorites->free_blocks[meteorites->free_block_count++] = meteorites->chunks[c].start;
+    meteorites->chunk_count--;
+    memmove(&meteorites->chunks[c], &meteorites->chunks[c + 1], sizeof(meteorite_chunk_t) * (meteorites->chunk_count - c));
+}
+
+/**
+ * \brief La fonction écrit une météorite à un emplacement
+ * \param meteorites les météorites
+ * \param i l'emplacement
+ * \param x l'abscisse initiale
+ * \param y l'ordonnée
+ * \param drift_speed la vitesse de dérive horizontale
+ * \param amplitude l'amplitude d'oscillation horizontale
+ * \param phase la phase d'oscillation
+ * \param angular_speed la vitesse de rotation, en degrés par seconde
+ */
+static void set_meteorite(meteorites_t *meteorites, size_t i, double x, double y, double drift_speed, double amplitude, double phase,
+                          double angular_speed) {
+    meteorites->x[i] = x;
+    meteorites->y[i] = y;
+    meteorites->angle[i] = 0.0;
+    meteorites->base_x[i] = x;
+    meteorites->drift_speed[i] = drift_speed;
+    // A sin(ωt + φ) = A cos(φ) sin(ωt) + A sin(φ) cos(ωt) : la mise à jour n'a plus qu'un sinus et un cosinus par groupe
+    meteorites->oscillation_cos[i] = amplitude * cos(phase);
+    meteorites->oscillation_sin[i] = amplitude * sin(phase);
+    meteorites->angular_speed[i] = angular_speed;
+}
+
+/**
+ * \brief La fonction ajoute une météorite à la fin du stockage. Les météorites doivent être ajoutées par ordonnée croissante, et
+ * build_meteorite_chunks doit être appelée une fois toutes les météorites ajoutées
+ * \param meteorites les météorites
+ * \param x l'abscisse initiale
+ * \param y l'ordonnée
+ * \param drift_speed la vitesse de dérive horizontale
+ * \param amplitude l'amplitude d'oscillation horizontale
+ * \param phase la phase d'oscillation
+ * \param angular_speed la vitesse de rotation, en degrés par seconde
+ */
+void add_meteorite(meteorites_t *meteorites, double x, double y, double drift_speed, double amplitude, double phase, double angular_speed) {
+    meteorite_chunk_t *chunk = meteorites->chunk_count > 0 ? &meteorites->chunks[meteorites->chunk_count - 1] : NULL;
+    if (chunk == NULL || chunk->end - chunk->start == METEORITE_CHUNK_SIZE) {
+        chunk = insert_meteorite_chunk(meteorites, meteorites->chunk_count);
+    }
+    set_meteorite(meteorites, chunk->end++, x, y, drift_speed, amplitude, phase, angular_speed);
+    meteorites->count++;
+}
+
+/**
+ * \brief La fonction calcule les positions et les angles d'une plage de météorites. Boucle sans branchement ni appel, vectorisée par GCC à
+ * partir de -O3 : la partie entière d'une valeur positive est une simple conversion, au lieu de floor qui ne se vectorise pas sans SSE4.1. Les
+ * tableaux sont des paramètres restrict, seule forme sous laquelle GCC les sait disjoints pour toute la boucle.
+ * \param start le premier indice
+ * \param end l'indice suivant le dernier
+ * \param time l'instant, en secondes
+ * \param level_width la largeur du niveau
+ * \param x les abscisses à calculer
+ * \param angle les angles à calculer
+ * \param base_x les abscisses initiales
+ * \param drift_speed les vitesses de dérive
+ * \param oscillation_cos les amplitudes multipliées par le cosinus de la phase
+ * \param oscillation_sin les amplitudes multipliées par le sinus de la phase
+ * \param angular_speed les vitesses de rotation
+ */
+static void update_meteorite_range(size_t start, size_t end, double time, double level_width, double *restrict x, double *restrict angle,
+                                   const double *restrict base_x, const double *restrict drift_speed, const double *restrict oscillation_cos,
+                                   const double *restrict oscillation_sin, const double *restrict angular_speed) {
+    double oscillation_sine = sin(METEORITE_OSCILLATION_FREQUENCY * time), oscillation_cosine = cos(METEORITE_OSCILLATION_FREQUENCY * time);
+    for (size_t i = start; i < end; i++) {
+        double turns = (base_x[i] + drift_speed[i] * time) / level_width + 0.5;
+        double wrapped = turns - ((double)(int)(turns + METEORITE_WRAP_OFFSET) - METEORITE_WRAP_OFFSET);
+        x[i] = (wrapped - 0.5) * level_width + oscillation_cos[i] * oscillation_sine + oscillation_sin[i] * oscillation_cosine;
+        double rotations = angular_speed[i] * time / 360.0;
+        angle[i] = 360.0 * (rotations - ((double)(int)(rotations + METEORITE_WRAP_OFFSET) - METEORITE_WRAP_OFFSET));
+    }
+}
+
+/**
+ * \brief La fonction calcule les positions des météorites d'un groupe à un instant donné.
+ * Les positions ne dépendent que du temps, un groupe ignoré pendant plusieurs frames reste donc exact.
+ * \param meteorites les météorites
+ * \param chunk le groupe
+ * \param time l'instant, en secondes
+ * \param level_width la largeur du niveau
+ */
+static void update_meteorite_chunk(meteorites_t *meteorites, meteorite_chunk_t *chunk, double time, double level_width) {
+    update_meteorite_range(chunk->start, chunk->end, time, level_width, meteorites->x, meteorites->angle, meteorites->base_x, meteorites->drift_speed,
+                           meteorites->oscillation_cos, meteorites->oscillation_sin, meteorites->angular_speed);
+
+    // La réduction reste scalaire : MIN et MAX ne se vectorisent pas sans -ffast-math, à cause des NaN
+    double min_x = INFINITY, max_x = -INFINITY;
+    for (size_t i = chunk->start; i < chunk->end; i++) {
+        min_x = MIN(min_x, meteorites->x[i]);
+        max_x = MAX(max_x, meteorites->x[i]);
+    }
+
+    chunk->min_x = min_x - METEORITE_SIZE / 2;
+    chunk->max_x = max_x + METEORITE_SIZE / 2;
+    chunk->updated_time = time;
+}
+
+/**
+ * \brief La fonction recalcule l'état d'un groupe après un changement de ses météorites
+ * \param meteorites les météorites
+ * \param chunk le groupe, non vide
+ * \param level_width la largeur du niveau
+ */
+static void refresh_meteorite_chunk(meteorites_t *meteorites, meteorite_chunk_t *chunk, double level_width) {
+    chunk->dynamic = false;
+    chunk->moving = false;
+    for (size_t i = chunk->start; i < chunk->end; i++) {
+        if (meteorites->drift_speed[i] != 0.0 || meteorites->oscillation_cos[i] != 0.0 || meteorites->oscillation_sin[i] != 0.0) {
+            chunk->moving = true;
+        }
+        if (chunk->moving || meteorites->angular_speed[i] != 0.0) {
+            chunk->dynamic = true;
+        }
+    }
+    // Les ordonnées sont triées et ne changent pas
+    chunk->min_y = meteorites->y[chunk->start] - METEORITE_SIZE / 2;
+    chunk->max_y = meteorites->y[chunk->end - 1] + METEORITE_SIZE / 2;
+    update_meteorite_chunk(meteorites, chunk, chunk->updated_time, level_width);
+}
+
+/**
+ * \brief La fonction calcule les boîtes englobantes initiales des groupes formés par add_meteorite
+ * \param meteorites les météorites
+ * \param level_width la largeur du niveau
+ */
+void build_meteorite_chunks(meteorites_t *meteorites, double level_width) {
+    for (size_t c = 0; c < meteorites->chunk_count; c++) {
+        refresh_meteorite_chunk(meteorites, &meteorites->chunks[c], level_width);
+    }
+}
+
+/**
+ * \brief La fonction cherche le premier groupe dont la boîte englobante atteint une ordonnée donnée
+ * \param meteorites les météorites
+ * \param min_y l'ordonnée minimale
+ * \return l'indice du premier groupe tel que max_y >= min_y, ou le nombre de groupes s'il n'y en a pas
+ */
+size_t find_meteorite_chunk(const meteorites_t *meteorites, double min_y) {
+    size_t low = 0, high = meteorites->chunk_count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (meteorites->chunks[middle].max_y < min_y) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+/**
+ * \brief La fonction insère une météorite à sa place dans l'ordre des ordonnées. Seul le groupe concerné est modifié, après avoir été coupé en
+ * deux s'il est plein.
+ * \param meteorites les météorites
+ * \param x l'abscisse initiale
+ * \param y l'ordonnée
+ * \param drift_speed la vitesse de dérive horizontale
+ * \param amplitude l'amplitude d'oscillation horizontale
+ * \param phase la phase d'oscillation
+ * \param angular_speed la vitesse de rotation, en degrés par seconde
+ * \param level_width la largeur du niveau
+ * \return true si la météorite a été insérée, false si le stockage n'a pas pu grandir
+ */
+bool insert_meteorite(meteorites_t *meteorites, double x, double y, double drift_speed, double amplitude, double phase, double angular_speed,
+                      double level_width) {
+    // Premier groupe dont la dernière météorite n'est pas au-dessus de la nouvelle
+    size_t c = find_meteorite_chunk(meteorites, y + METEORITE_SIZE / 2);
+    if (meteorites->chunk_count == 0) {
+        if (insert_meteorite_chunk(meteorites, 0) == NULL) {
+            return false;
+        }
+    } else if (c == meteorites->chunk_count) {
+        c--;
+    }
+
+    meteorite_chunk_t *chunk = &meteorites->chunks[c];
+    if (chunk->end - chunk->start == METEORITE_CHUNK_SIZE) {
+        // Groupe plein : la moitié haute part dans un nouveau groupe
+        meteorite_chunk_t *upper_chunk = insert_meteorite_chunk(meteorites, c + 1);
+        if (upper_chunk == NULL) {
+            return false;
+        }
+        chunk = &meteorites->chunks[c];
+        size_t half = METEORITE_CHUNK_SIZE / 2;
+        move_meteorites(meteorites, upper_chunk->start, chunk->start + half, METEORITE_CHUNK_SIZE - half);
+        upper_chunk->end = upper_chunk->start + METEORITE_CHUNK_SIZE - half;
+        upper_chunk->updated_time = chunk->updated_time;
+        chunk->end = chunk->start + half;
+        refresh_meteorite_chunk(meteorites, chunk, level_width);
+        refresh_meteorite_chunk(meteorites, upper_chunk, level_width);
+        if (y >= meteorites->y[upper_chunk->start]) {
+            chunk = upper_chunk;
+        }
+    }
+
+    size_t i = chunk->start;
+    while (i < chunk->end && meteorites->y[i] <= y) {
+        i++;
+    }
+    move_meteorites(meteorites, i + 1, i, chunk->end - i);
+    set_meteorite(meteorites, i, x, y, drift_speed, amplitude, phase, angular_speed);
+    chunk->end++;
+    meteorites->count++;
+    refresh_meteorite_chunk(meteorites, chunk, level_width);
+    return true;
+}
+
+/**
+ * \brief La fonction retire toutes les météorites d'une ligne du niveau. Seuls les groupes qui contiennent la ligne sont modifiés, et les
+ * groupes vidés rendent leur bloc.
+ * \param meteorites les météorites
+ * \param y l'ordonnée de la ligne
+ * \param level_width la largeur du niveau
+ */
+void remove_meteorite_row(meteorites_t *meteorites, double y, double level_width) {
+    size_t c = find_meteorite_chunk(meteorites, y);
+    while (c < meteorites->chunk_count && meteorites->chunks[c].min_y <= y) {
+        meteorite_chunk_t *chunk = &meteorites->chunks[c];
+        size_t kept = chunk->start;
+        for (size_t i = chunk->start; i < chunk->end; i++) {
+            if (meteorites->y[i] != y) {
+                move_meteorites(meteorites, kept++, i, 1);
+            }
+        }
+        size_t removed = chunk->end - kept;
+        meteorites->count -= removed;
+        chunk->end = kept;
+        if (chunk->end == chunk->start) {
+            remove_meteorite_chunk(meteorites, c);
+            continue;
+        }
+        if (removed > 0) {
+            refresh_meteorite_chunk(meteorites, chunk, level_width);
+        }
+        c++;
+    }
+}
+
+/**
+ * \brief La fonction met à jour les météorites mobiles des groupes qui intersectent une bande horizontale du niveau.
+ * Les autres groupes ne sont pas touchés.
+ * \param meteorites les météorites
+ * \param time l'instant, en secondes
+ * \param min_y l'ordonnée minimale de la bande
+ * \param max_y l'ordonnée maximale de la bande
+ * \param level_width la largeur du niveau
+ */
+void update_meteorites(meteorites_t *meteorites, double time, double min_y, double max_y, double level_width) {
+    for (size_t c = find_meteorite_chunk(meteorites, min_y); c < meteorites->chunk_count && meteorites->chunks[c].min_y <= max_y; c++) {
+        meteorite_chunk_t *chunk = &meteorites->chunks[c];
+        if (chunk->dynamic && chunk->updated_time != time) {
+            update_meteorite_chunk(meteorites, chunk, time, level_width);
+        }
+    }
+}
+
+/**
+ * \brief La fonction oublie le stockage des météorites, qui est rendu avec l'arène du niveau
+ * \param meteorites les météorites
+ */
+void clean_meteorites(meteorites_t *meteorites) {
+    meteorites->x = NULL;
+    meteorites->chunks = NULL;
+    meteorites->free_blocks = NULL;
+    meteorites->count = 0;
+    meteorites->chunk_count = 0;
+    meteorites->free_block_count = 0;
+}
@@ -0,0 +1,78 @@
+/**
+ * \file meteorites.h
+ * \brief Fichier contenant le stockage des météorites en tableaux contigus et leur mise à jour par groupes
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#ifndef __METEORITES_H__
+#define __METEORITES_H__
+
+#include "arena.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * \brief Groupe de météorites consécutives, unité de mise à jour et de recherche de collisions
+ *
+ * Chaque groupe occupe son propre bloc de METEORITE_CHUNK_SIZE emplacements dans les tableaux : une insertion ou une suppression ne déplace que
+ * les météorites du groupe.
+ */
+typedef struct meteorite_chunk_s {
+    size_t start;        /*!< Indice de la première météorite du groupe, début de son bloc */
+    size_t end;          /*!< Indice suivant la dernière météorite du groupe */
+    bool dynamic;        /*!< Indique si le groupe contient au moins une météorite mobile */
+    bool moving;         /*!< Indique si le groupe contient au moins une météorite qui se déplace, et pas seulement tourne sur elle-même */
+    double updated_time; /*!< Instant (en secondes) auquel les positions du groupe ont été calculées */
+    double min_x;        /*!< Boîte englobante du groupe */
+    double max_x;
+    double min_y;
+    double max_y;
+} meteorite_chunk_t;
+
+/**
+ * \brief Météorites du niveau, stockées sous forme de structure de tableaux
+ *
+ * Les météorites sont triées par ligne du niveau. Leur mouvement est uniquement horizontal, donc l'ordre vertical des groupes ne change jamais et
+ * les boîtes englobantes des groupes forment un découpage spatial qu'il suffit de rafraîchir groupe par groupe.
+ */
+typedef struct meteorites_s {
+    arena_t *arena;        /*!< Arène du niveau, qui contient tous les tableaux */
+    size_t count;          /*!< Nombre de météorites */
+    size_t capacity;       /*!< Nombre d'emplacements des tableaux */
+    size_t next_block;     /*!< Premier emplacement jamais attribué à un bloc */
+    double *x;             /*!< Abscisses courantes */
+    double *y;             /*!< Ordonnées (constantes) */
+    double *angle;         /*!< Angles courants, en degrés */
+    double *base_x;        /*!< Abscisses initiales */
+    double *drift_speed;   /*!< Vitesses de dérive horizontale */
+    double *oscillation_cos; /*!< Amplitudes d'oscillation horizontale multipliées par le cosinus de leur phase */
+    double *oscillation_sin; /*!< Amplitudes d'oscillation horizontale multipliées par le sinus de leur phase */
+    double *angular_speed; /*!< Vitesses de rotation, en degrés par seconde */
+    size_t chunk_count;
+    meteorite_chunk_t *chunks; /*!< Groupes, triés par ordonnée, un emplacement par bloc */
+    size_t free_block_count;
+    size_t *free_blocks; /*!< Débuts des blocs libérés par des groupes vidés, un emplacement par bloc */
+} meteorites_t;
+
+size_t meteorites_arena_size(size_t count);
+
+void init_meteorites(meteorites_t *meteorites, arena_t *arena, size_t capacity);
+
+void add_meteorite(meteorites_t *meteorites, double x, double y, double drift_speed, double amplitude, double phase, double angular_speed);
+
+void build_meteorite_chunks(meteorites_t *meteorites, double level_width);
+
+size_t find_meteorite_chunk(const meteorites_t *meteorites, double min_y);
+
+bool insert_meteorite(meteorites_t *meteorites, double x, double y, double drift_speed, double amplitude, double phase, double angular_speed,
+                      double level_width);
+
+void remove_meteorite_row(meteorites_t *meteorites, double y, double level_width);
+
+void update_meteorites(meteorites_t *meteorites, double time, double min_y, double max_y, double level_width);
+
+void clean_meteorites(meteorites_t *meteorites);
+
+#endif
@@ -0,0 +1,116 @@
+/**
+ * \file offscreen.c
+ * \brief Fichier contenant le dessin hors écran, déterministe, pour les images de référence et la mesure des performances du dessin
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#include "offscreen.h"
+#include "allocations.h"
+#include "capture.h"
+#include "game.h"
+#include "graphics.h"
+#include "latency.h"
+#include "replay.h"
+#include "snapshot.h"
+
+/**
+ * \brief La fonction fait tourner le jeu sans fenêtre : simulation à pas fixe pilotée par un enregistrement d'entrées, dessin par le renderer
+ * logiciel dans une surface, et écriture de chaque image par un fil en arrière-plan. Deux exécutions avec les mêmes entrées produisent les mêmes
+ * images, octet par octet.
+ * \param exe_dir le chemin de l'exécutable, utilisé pour charger les ressources
+ * \param options les options de la ligne de commande
+ * \return le code de sortie du programme
+ */
+int run_offscreen(const char *exe_dir, const options_t *options) {
+    // Ce qui peut échouer est fait avant le chargement des ressources, pour n'avoir que la SDL à nettoyer en cas d'échec
+    replay_t replay = {0};
+    if (options->replay_path != NULL && !load_replay(options->replay_path, &replay)) {
+        return 1;
+    }
+
+    SDL_Surface *surface;
+    SDL_Renderer *renderer;
+    if (init_sdl_offscreen(&surface, &renderer, INITIAL_SCREEN_WIDTH, INITIAL_SCREEN_HEIGHT) != 0) {
+        clean_replay(&replay);
+        return 1;
+    }
+
+    capture_t capture;
+    if (!start_capture(&capture, options->offscreen_dir, options->raw_frames ? CAPTURE_FORMAT_RAW : CAPTURE_FORMAT_PNG, surface->w, surface->h, false, 0)) {
+        clean_replay(&replay);
+        clean_sdl(renderer, NULL);
+        clean_surface(surface);
+        return 1;
+    }
+
+    init_ttf();
+    init_mix(false);
+
+    resources_t resources;
+    world_t world;
+    if (!init_resources(exe_dir, renderer, &resources)) {
+        stop_capture(&capture);
+        clean_replay(&replay);
+        clean_resources(&resources);
+        clean_mix();
+        clean_ttf();
+        clean_sdl(renderer, NULL);
+        clean_surface(surface);
+        return 1;
+    }
+    init_data(exe_dir, &resources, &world);
+    world.fixed_frame_time = 1000 / MAX_FPS;
+
+    snapshot_t snapshot = {0};
+    latency_histogram_t draw_times = {0};
+    int playing_frames = 0;
+    for (long frame = 0; frame < options->frames; frame++) {
+        Uint64 allocations = allocation_count();
+        bool was_playing = world.game_state == GAME_STATE_PLAYING;
+        int level = world.current_level;
+        Uint8 input = replay_input(&replay, frame);
+        update_data(exe_dir, &resources, &world, &input);
+        // L'écran de démarrage est passé, comme avec la touche espace
+        skip_splash_screen(exe_dir, &resources, &world);
+        if (world.game_state == GAME_STATE_QUIT) {
+            break;
+        }
+
+        capture_snapshot(&world, &snapshot, surface->w, surface->h);
+        // Le dessin n'est pas vérifié : le renderer logiciel alloue pour chaque texture tournée
+        bool steady = was_playing && world.game_state == GAME_STATE_PLAYING && world.current_level == level && !snapshot.meteorites_grown;
+        playing_frames = steady ? playing_frames + 1 : 0;
+        if (playing_frames > ALLOCATION_CHECK_WARMUP_FRAMES) {
+            expect_no_allocation(allocations, "la simulation hors écran");
+        }
+        Uint64 draw_start = SDL_GetPerformanceCounter();
+        draw_graphics(exe_dir, renderer, NULL, &resources, &snapshot);
+        update_screen(renderer);
+        record_latency(&draw_times, SDL_GetPerformanceCounter() - draw_start);
+
+        Uint8 *pixels = begin_capture_frame(&capture);
+        for (int y = 0; y < surface->h; y++) {
+            memcpy(pixels + (size_t)y * surface->w * 4, (Uint8 *)surface->pixels + (size_t)y * surface->pitch, (size_t)surface->w * 4);
+        }
+        submit_capture_frame(&capture);
+    }
+
+    stop_capture(&capture);
+    if (options->profile) {
+        printf("Dessin hors écran (%dx%d, %d images écrites) :\n", surface->w, surface->h, SDL_AtomicGet(&capture.encoded));
+        report_latency("temps de dessin", &draw_times);
+        report_particles(&world.particles);
+    }
+
+    clean_snapshot(&snapshot);
+    clean_replay(&replay);
+    clean_data(&world);
+    clean_resources(&resources);
+    clean_mix();
+    clean_ttf();
+    clean_sdl(renderer, NULL);
+    clean_surface(surface);
+    return 0;
+}
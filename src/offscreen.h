@@ -0,0 +1,16 @@
+/**
+ * \file offscreen.h
+ * \brief Fichier contenant le dessin hors écran, déterministe, pour les images de référence et la mesure des performances du dessin
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#ifndef __OFFSCREEN_H__
+#define __OFFSCREEN_H__
+
+#include "options.h"
+
+int run_offscreen(const char *exe_dir, const options_t *options);
+
+#endif
@@ -0,0 +1,98 @@
+/**
+ * \file options.c
+ * \brief Fichier contenant les options de la ligne de commande
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#include "options.h"
+#include "game.h"
+#include "utilities.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * \brief La fonction affiche l'aide de la ligne de commande
+ * \param program le nom du programme
+ */
+static void print_usage(const char *program) {
+    fprintf(stderr, "Usage : %s [options]\n", program);
+    fprintf(stderr, "  --late-input        échantillonner les entrées le plus tard possible avant la physique\n");
+    fprintf(stderr, "  --low-latency-audio ouvrir l'audio avec un petit tampon, pour des sons plus proches des évènements\n");
+    fprintf(stderr, "  --profile           afficher les mesures de performance à la fin du jeu\n");
+    fprintf(stderr, "  --no-idle           redessiner à chaque frame, même sur les écrans fixes\n");
+    fprintf(stderr, "  --frame-budget MS   baisser la résolution de la scène pour la dessiner en MS ms (16 par défaut, 0 pour la résolution native)\n");
+    fprintf(stderr, "  --offscreen DIR     dessiner hors écran, à pas fixe, et écrire chaque image dans DIR\n");
+    fprintf(stderr, "  --raw               écrire les images hors écran en RGBA brut plutôt qu'en PNG\n");
+    fprintf(stderr, "  --frames N          nombre maximal de frames simulées hors écran ou par niveau du banc d'essai (1000 par défaut)\n");
+    fprintf(stderr, "  --replay FILE       rejouer les entrées enregistrées dans FILE hors écran ou dans le banc d'essai\n");
+    fprintf(stderr, "  --record PATH       enregistrer la partie dans PATH, une vidéo .y4m ou un répertoire d'images PNG\n");
+    fprintf(stderr, "  --record-fps N      nombre maximal d'images enregistrées par seconde (30 par défaut, 0 pour toutes)\n");
+    fprintf(stderr, "  --telemetry DIR     enregistrer les évènements de partie dans DIR, en NDJSON\n");
+    fprintf(stderr, "  --telemetry-binary  enregistrer les évènements de partie en binaire plutôt qu'en NDJSON\n");
+    fprintf(stderr, "  --watch-levels DIR  lire les niveaux dans DIR et recharger le niveau courant à chaque modification\n");
+    fprintf(stderr, "  --ghosts DIR        courir contre les meilleures courses enregistrées dans DIR, et y enregistrer les nouvelles\n");
+    fprintf(stderr, "  --records FILE      conserver les records personnels et les temps de passage de chaque niveau dans FILE\n");
+    fprintf(stderr, "  --players N         jouer à N sur le même écran, de 1 à 4 (1 par défaut)\n");
+    fprintf(stderr, "  --trace FILE        enregistrer la chronologie des fils dans FILE au format Chrome trace-event (F9 pour un export immédiat)\n");
+    fprintf(stderr, "  --benchmark DIR     mesurer sans fenêtre le chargement et la simulation de chaque niveau de DIR, résultats dans DIR/benchmark.csv\n");
+}
+
+/**
+ * \brief La fonction lit les options de la ligne de commande. Elle quitte le programme si une option est inconnue
+ * \param argc le nombre d'arguments
+ * \param argv les arguments
+ * \param options les options à remplir
+ */
+void parse_options(int argc, char **argv, options_t *options) {
+    *options = (options_t){.frame_budget = 16.0, .frames = 1000, .record_fps = 30, .players = 1};
+    for (int i = 1; i < argc; i++) {
+        // Les options suivies d'une valeur
+        bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--late-input") == 0) {
+            options->late_input = true;
+        } else if (strcmp(argv[i], "--low-latency-audio") == 0) {
+            options->low_latency_audio = true;
+        } else if (strcmp(argv[i], "--profile") == 0) {
+            options->profile = true;
+        } else if (strcmp(argv[i], "--no-idle") == 0) {
+            options->no_idle = true;
+        } else if (strcmp(argv[i], "--frame-budget") == 0 && has_value) {
+            options->frame_budget = strtod(argv[++i], NULL);
+        } else if (strcmp(argv[i], "--offscreen") == 0 && has_value) {
+            options->offscreen_dir = argv[++i];
+        } else if (strcmp(argv[i], "--raw") == 0) {
+            options->raw_frames = true;
+        } else if (strcmp(argv[i], "--frames") == 0 && has_value) {
+            options->frames = strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--replay") == 0 && has_value) {
+            options->replay_path = argv[++i];
+        } else if (strcmp(argv[i], "--record") == 0 && has_value) {
+            options->record_path = argv[++i];
+        } else if (strcmp(argv[i], "--record-fps") == 0 && has_value) {
+            options->record_fps = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--telemetry") == 0 && has_value) {
+            options->telemetry_dir = argv[++i];
+        } else if (strcmp(argv[i], "--telemetry-binary") == 0) {
+            options->telemetry_binary = true;
+        } else if (strcmp(argv[i], "--watch-levels") == 0 && has_value) {
+            options->levels_dir = argv[++i];
+        } else if (strcmp(argv[i], "--ghosts") == 0 && has_value) {
+            options->ghosts_dir = argv[++i];
+        } else if (strcmp(argv[i], "--records") == 0 && has_value) {
+            options->records_path = argv[++i];
+        } else if (strcmp(argv[i], "--players") == 0 && has_value) {
+            options->players = CLAMP(atoi(argv[++i]), 1, PLAYER_MAX_COUNT);
+        } else if (strcmp(argv[i], "--trace") == 0 && has_value) {
+            options->trace_path = argv[++i];
+        } else if (strcmp(argv[i], "--benchmark") == 0 && has_value) {
+            options->benchmark_dir = argv[++i];
+        } else {
+            fprintf(stderr, "Option inconnue : %s\n", argv[i]);
+            print_usage(argv[0]);
+            exit(1);
+        }
+    }
+}
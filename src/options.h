@@ -0,0 +1,41 @@
+/**
+ * \file options.h
+ * \brief Fichier contenant les options de la ligne de commande
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#ifndef __OPTIONS_H__
+#define __OPTIONS_H__
+
+#include <stdbool.h>
+
+/**
+ * \brief Options de la ligne de commande
+ */
+typedef struct options_s {
+    bool late_input;           /*!< Échantillonner les entrées le plus tard possible avant le pas de physique */
+    bool profile;              /*!< Afficher les mesures de performance à la fin du jeu */
+    bool low_latency_audio;    /*!< Ouvrir l'audio avec un petit tampon */
+    bool no_idle;              /*!< Redessiner à chaque frame, même sur les écrans fixes */
+    double frame_budget;       /*!< Budget de temps de dessin d'une frame, en ms, qui règle la résolution de la scène, ou 0 */
+    const char *offscreen_dir; /*!< Si non NULL, dessiner hors écran et écrire les images dans ce répertoire */
+    bool raw_frames;           /*!< Écrire les images hors écran en RGBA brut plutôt qu'en PNG */
+    long frames;               /*!< Nombre maximal de frames simulées hors écran */
+    const char *replay_path;   /*!< Enregistrement d'entrées rejoué hors écran, ou NULL */
+    const char *record_path;   /*!< Si non NULL, enregistrer la partie dans ce fichier .y4m ou ce répertoire d'images */
+    int record_fps;            /*!< Nombre maximal d'images enregistrées par seconde */
+    const char *telemetry_dir; /*!< Si non NULL, enregistrer les évènements de partie dans ce répertoire */
+    bool telemetry_binary;     /*!< Enregistrer les évènements en binaire plutôt qu'en NDJSON */
+    const char *levels_dir;    /*!< Si non NULL, lire les niveaux dans ce répertoire et recharger le niveau courant à chaque modification */
+    const char *ghosts_dir;    /*!< Si non NULL, courir contre les meilleures courses enregistrées dans ce répertoire */
+    const char *records_path;  /*!< Si non NULL, conserver les records personnels dans ce journal */
+    int players;               /*!< Nombre de joueurs sur le même écran, de 1 à PLAYER_MAX_COUNT */
+    const char *trace_path;    /*!< Si non NULL, enregistrer la chronologie des fils et l'écrire dans ce fichier à la fin du jeu */
+    const char *benchmark_dir; /*!< Si non NULL, mesurer sans fenêtre chaque niveau de ce répertoire et y écrire les résultats */
+} options_t;
+
+void parse_options(int argc, char **argv, options_t *options);
+
+#endif
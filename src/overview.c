@@ -0,0 +1,90 @@
+/**
+ * \file overview.c
+ * \brief Fichier contenant la carte de densité du niveau, qui remplace les météorites une à une dans la vue d'ensemble
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#include "overview.h"
+#include "utilities.h"
+#include <string.h>
+
+/**
+ * \brief La fonction choisit le côté des blocs de la carte d'un niveau, pour que la carte ne dépasse ni OVERVIEW_MAX_HEIGHT texels de haut ni
+ * la taille maximale des textures du renderer
+ * \param width la largeur du niveau, en cases
+ * \param height la hauteur du niveau, en cases
+ * \param max_width la largeur maximale d'une texture, ou 0 si elle n'est pas limitée
+ * \param max_height la hauteur maximale d'une texture, ou 0 si elle n'est pas limitée
+ * \return le côté d'un bloc, en cases
+ */
+static int overview_block(int width, int height, int max_width, int max_height) {
+    int map_height = max_height > 0 ? MIN(max_height, OVERVIEW_MAX_HEIGHT) : OVERVIEW_MAX_HEIGHT;
+    int block = MAX((height + map_height - 1) / map_height, 1);
+    if (max_width > 0) {
+        block = MAX(block, (width + max_width - 1) / max_width);
+    }
+    return block;
+}
+
+/**
+ * \brief La fonction donne la taille à réserver dans l'arène du niveau pour sa carte
+ * \param width la largeur du niveau, en cases
+ * \param height la hauteur du niveau, en cases
+ * \param max_width la largeur maximale d'une texture, ou 0 si elle n'est pas limitée
+ * \param max_height la hauteur maximale d'une texture, ou 0 si elle n'est pas limitée
+ * \return la taille, en octets
+ */
+size_t overview_arena_size(int width, int height, int max_width, int max_height) {
+    int block = overview_block(width, height, max_width, max_height);
+    return arena_allocation_size(sizeof(Uint32) * ((width + block - 1) / block) * ((height + block - 1) / block));
+}
+
+/**
+ * \brief La fonction initialise une carte vide, dont les cases occupées sont ajoutées par l'appelant. Le numéro de version est incrémenté.
+ * \param overview la carte
+ * \param arena l'arène du niveau
+ * \param width la largeur du niveau, en cases
+ * \param height la hauteur du niveau, en cases
+ * \param max_width la largeur maximale d'une texture, ou 0 si elle n'est pas limitée
+ * \param max_height la hauteur maximale d'une texture, ou 0 si elle n'est pas limitée
+ */
+void init_overview(overview_t *overview, arena_t *arena, int width, int height, int max_width, int max_height) {
+    overview->block = overview_block(width, height, max_width, max_height);
+    overview->width = (width + overview->block - 1) / overview->block;
+    overview->height = (height + overview->block - 1) / overview->block;
+    overview->counts = arena_alloc(arena, sizeof(Uint32) * overview->width * overview->height);
+    memset(overview->counts, 0, sizeof(Uint32) * overview->width * overview->height);
+    overview->version++;
+}
+
+/**
+ * \brief La fonction ajoute une case occupée à la carte
+ * \param overview la carte
+ * \param x la colonne de la case dans l'image du niveau
+ * \param y la ligne de la case dans l'image du niveau
+ */
+void add_overview_cell(overview_t *overview, int x, int y) {
+    overview->counts[(size_t)(y / overview->block) * overview->width + x / overview->block]++;
+}
+
+/**
+ * \brief La fonction retire une case occupée de la carte
+ * \param overview la carte
+ * \param x la colonne de la case dans l'image du niveau
+ * \param y la ligne de la case dans l'image du niveau
+ */
+void remove_overview_cell(overview_t *overview, int x, int y) {
+    overview->counts[(size_t)(y / overview->block) * overview->width + x / overview->block]--;
+}
+
+/**
+ * \brief La fonction oublie la carte, qui est rendue avec l'arène du niveau. Le numéro de version est conservé.
+ * \param overview la carte
+ */
+void clean_overview(overview_t *overview) {
+    overview->counts = NULL;
+    overview->width = 0;
+    overview->height = 0;
+}
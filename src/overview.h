@@ -0,0 +1,43 @@
+/**
+ * \file overview.h
+ * \brief Fichier contenant la carte de densité du niveau, qui remplace les météorites une à une dans la vue d'ensemble
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#ifndef __OVERVIEW_H__
+#define __OVERVIEW_H__
+
+#include "arena.h"
+#include <SDL.h>
+
+/**
+ * \brief Hauteur visée de la carte, en texels : les niveaux plus hauts sont résumés par blocs de plusieurs cases. Le renderer peut imposer
+ * moins.
+ */
+#define OVERVIEW_MAX_HEIGHT 4096
+
+/**
+ * \brief Carte de densité du niveau : chaque texel compte les cases occupées par une météorite dans un bloc carré de cases du niveau. La première
+ * ligne de texels résume les premières lignes de l'image du niveau, c'est-à-dire le haut du niveau.
+ */
+typedef struct overview_s {
+    int width;      /*!< Largeur de la carte, en texels */
+    int height;     /*!< Hauteur de la carte, en texels */
+    int block;      /*!< Côté d'un bloc de cases résumé par un texel, sans limite pour que la carte tienne dans une texture */
+    Uint32 *counts; /*!< Nombre de cases occupées de chaque bloc, au plus block * block */
+    int version;    /*!< Numéro incrémenté à chaque modification de la carte, pour que l'affichage sache quand recharger sa texture */
+} overview_t;
+
+size_t overview_arena_size(int width, int height, int max_width, int max_height);
+
+void init_overview(overview_t *overview, arena_t *arena, int width, int height, int max_width, int max_height);
+
+void add_overview_cell(overview_t *overview, int x, int y);
+
+void remove_overview_cell(overview_t *overview, int x, int y);
+
+void clean_overview(overview_t *overview);
+
+#endif
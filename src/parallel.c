@@ -0,0 +1,87 @@
+/**
+ * \file parallel.c
+ * \brief Fichier contenant la répartition d'une boucle entre plusieurs fils, pour les calculs faits au chargement
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#include "parallel.h"
+#include "trace.h"
+#include "utilities.h"
+#include <SDL.h>
+
+/**
+ * \brief Part d'une boucle parallèle confiée à un fil
+ */
+typedef struct parallel_job_s {
+    parallel_function_t function;
+    void *data;
+    int thread;
+    int first;
+    int last;
+} parallel_job_t;
+
+/**
+ * \brief La fonction d'un fil : elle exécute sa part de la boucle
+ * \param data la part
+ * \return 0
+ */
+static int parallel_thread(void *data) {
+    parallel_job_t *job = data;
+    TRACE_BEGIN(span);
+    job->function(job->data, job->thread, job->first, job->last);
+    TRACE_END(span, "parallel_job");
+    return 0;
+}
+
+/**
+ * \brief La fonction d'un fil créé pour une boucle : il exécute sa part sur une ligne « parallel » de la chronologie, qu'il rend en finissant
+ * \param data la part
+ * \return 0
+ */
+static int parallel_worker_thread(void *data) {
+    name_trace_thread("parallel");
+    parallel_thread(data);
+    release_trace_thread();
+    return 0;
+}
+
+/**
+ * \brief La fonction choisit le nombre de fils d'une boucle, selon le nombre de processeurs et la quantité de travail
+ * \param work la quantité de travail de la boucle, par exemple son nombre d'éléments
+ * \param work_per_thread la quantité de travail en dessous de laquelle un fil supplémentaire coûte plus qu'il ne rapporte
+ * \return le nombre de fils, entre 1 et PARALLEL_MAX_THREADS
+ */
+int parallel_thread_count(size_t work, size_t work_per_thread) {
+    int thread_count = CLAMP(SDL_GetCPUCount(), 1, PARALLEL_MAX_THREADS);
+    return MIN(thread_count, (int)MIN(MAX(work / work_per_thread, 1), PARALLEL_MAX_THREADS));
+}
+
+/**
+ * \brief La fonction répartit les itérations d'une boucle en plages égales entre plusieurs fils et attend leur fin. Le fil appelant traite la
+ * première plage, et celles des fils qui n'ont pas pu être créés.
+ * \param count le nombre d'itérations
+ * \param thread_count le nombre de fils, au plus PARALLEL_MAX_THREADS
+ * \param function le corps de la boucle
+ * \param data les données de la boucle
+ */
+void run_parallel(int count, int thread_count, parallel_function_t function, void *data) {
+    parallel_job_t jobs[PARALLEL_MAX_THREADS];
+    SDL_Thread *threads[PARALLEL_MAX_THREADS];
+    thread_count = CLAMP(thread_count, 1, PARALLEL_MAX_THREADS);
+    for (int t = 0; t < thread_count; t++) {
+        jobs[t] = (parallel_job_t){function, data, t, (int)((long long)count * t / thread_count), (int)((long long)count * (t + 1) / thread_count)};
+    }
+    for (int t = 1; t < thread_count; t++) {
+        threads[t] = SDL_CreateThread(parallel_worker_thread, "parallel", &jobs[t]);
+    }
+    parallel_thread(&jobs[0]);
+    for (int t = 1; t < thread_count; t++) {
+        if (threads[t] != NULL) {
+            SDL_WaitThread(threads[t], NULL);
+        } else {
+            parallel_thread(&jobs[t]);
+        }
+    }
+}
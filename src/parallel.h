@@ -0,0 +1,32 @@
+/**
+ * \file parallel.h
+ * \brief Fichier contenant la répartition d'une boucle entre plusieurs fils, pour les calculs faits au chargement
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#ifndef __PARALLEL_H__
+#define __PARALLEL_H__
+
+#include <stddef.h>
+
+/**
+ * \brief Nombre maximal de fils d'une boucle parallèle
+ */
+#define PARALLEL_MAX_THREADS 8
+
+/**
+ * \brief Corps d'une boucle parallèle, appelé une fois par fil sur une plage d'itérations consécutives
+ * \param data les données de la boucle
+ * \param thread le numéro du fil, de 0 au nombre de fils exclu, pour choisir sa mémoire de travail
+ * \param first la première itération
+ * \param last l'itération suivant la dernière
+ */
+typedef void (*parallel_function_t)(void *data, int thread, int first, int last);
+
+int parallel_thread_count(size_t work, size_t work_per_thread);
+
+void run_parallel(int count, int thread_count, parallel_function_t function, void *data);
+
+#endif
@@ -0,0 +1,251 @@
+/**
+ * \file particles.c
+ * \brief Fichier contenant le système de particules : réserves de taille fixe en structure de tableaux, mises à jour sans allocation
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#include "particles.h"
+#include "constants.h"
+#include "logger.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * \brief Nombre de tableaux de chaque réserve
+ */
+#define PARTICLE_ARRAY_COUNT 6
+
+/**
+ * \brief La fonction tire un nombre pseudo-aléatoire (xorshift)
+ * \param particles les particules, qui portent l'état du générateur
+ * \return un nombre dans [0, 1[
+ */
+static float random_unit(particles_t *particles) {
+    Uint32 state = particles->random;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    particles->random = state;
+    return (state >> 8) / 16777216.0f;
+}
+
+/**
+ * \brief La fonction alloue les réserves, toutes dans un seul bloc, une fois pour toutes. Si la mémoire manque, le jeu continue sans
+ * particules.
+ * \param particles les particules
+ */
+void init_particles(particles_t *particles) {
+    particles->storage = malloc(sizeof(float) * PARTICLE_ARRAY_COUNT * PARTICLE_KIND_COUNT * PARTICLE_CAPACITY);
+    if (particles->storage == NULL) {
+        LOG_ERROR("Mémoire insuffisante pour les particules, elles sont désactivées");
+    }
+    for (int kind = 0; kind < PARTICLE_KIND_COUNT; kind++) {
+        float *arrays = particles->storage != NULL ? particles->storage + (size_t)kind * PARTICLE_ARRAY_COUNT * PARTICLE_CAPACITY : NULL;
+        particles->pools[kind] = (particle_pool_t){
+            .count = 0,
+            .x = arrays,
+            .y = arrays + PARTICLE_CAPACITY,
+            .speed_x = arrays + PARTICLE_CAPACITY * 2,
+            .speed_y = arrays + PARTICLE_CAPACITY * 3,
+            .age = arrays + PARTICLE_CAPACITY * 4,
+            .lifetime = arrays + PARTICLE_CAPACITY * 5,
+        };
+    }
+    particles->random = 0x2545F491;
+    particles->exhaust_credit = 0.0;
+    particles->spawned = 0;
+    particles->culled = 0;
+    particles->peak_live = 0;
+}
+
+/**
+ * \brief La fonction émet des particules dans un cône. Les particules au-delà de la capacité de la réserve ne sont pas émises, ni aucune si
+ * les réserves n'ont pas pu être allouées.
+ * \param particles les particules
+ * \param kind la sorte des particules
+ * \param count le nombre de particules
+ * \param x l'abscisse du point d'émission
+ * \param y l'ordonnée du point d'émission
+ * \param speed_x la vitesse horizontale de l'émetteur
+ * \param speed_y la vitesse verticale de l'émetteur
+ * \param speed la vitesse maximale d'éjection
+ * \param direction la direction du cône, en radians
+ * \param spread l'ouverture du cône, en radians
+ * \param lifetime la durée de vie maximale, en ms
+ */
+static void spawn_particles(particles_t *particles, particle_kind_t kind, size_t count, double x, double y, double speed_x, double speed_y,
+                            double speed, double direction, double spread, double lifetime) {
+    particle_pool_t *pool = &particles->pools[kind];
+    if (particles->storage == NULL) {
+        return;
+    }
+    count = count < PARTICLE_CAPACITY - pool->count ? count : PARTICLE_CAPACITY - pool->count;
+    for (size_t i = pool->count; i < pool->count + count; i++) {
+        double angle = direction + (random_unit(particles) - 0.5) * spread;
+        double ejection = speed * (0.25 + 0.75 * random_unit(particles));
+        pool->x[i] = x + (random_unit(particles) - 0.5) * PARTICLE_SIZE;
+        pool->y[i] = y + (random_unit(particles) - 0.5) * PARTICLE_SIZE;
+        pool->speed_x[i] = speed_x + cos(angle) * ejection;
+        pool->speed_y[i] = speed_y + sin(angle) * ejection;
+        pool->age[i] = 0.0f;
+        pool->lifetime[i] = lifetime * (0.5 + 0.5 * random_unit(particles));
+    }
+    pool->count += count;
+    particles->spawned += count;
+}
+
+/**
+ * \brief La fonction émet la traînée du réacteur pendant un pas, à un débit proportionnel à la poussée
+ * \param particles les particules
+ * \param x l'abscisse de la tuyère
+ * \param y l'ordonnée de la tuyère
+ * \param speed_x la vitesse horizontale du vaisseau
+ * \param speed_y la vitesse verticale du vaisseau
+ * \param intensity l'intensité de la flamme, de 0 à 1
+ * \param duration la durée du pas, en ms
+ */
+void emit_exhaust(particles_t *particles, double x, double y, double speed_x, double speed_y, double intensity, double duration) {
+    particles->exhaust_credit += PARTICLE_EXHAUST_RATE * intensity * duration;
+    size_t count = particles->exhaust_credit;
+    particles->exhaust_credit -= count;
+    spawn_particles(particles, PARTICLE_EXHAUST, count, x, y, speed_x, speed_y, PARTICLE_EXHAUST_SPEED, M_PI / 2, PARTICLE_EXHAUST_SPREAD,
+                    PARTICLE_EXHAUST_LIFETIME);
+}
+
+/**
+ * \brief La fonction émet les débris d'une collision, dans toutes les directions
+ * \param particles les particules
+ * \param x l'abscisse de la collision
+ * \param y l'ordonnée de la collision
+ */
+void emit_debris(particles_t *particles, double x, double y) {
+    spawn_particles(particles, PARTICLE_DEBRIS, PARTICLE_DEBRIS_COUNT, x, y, 0.0, 0.0, PARTICLE_DEBRIS_SPEED, 0.0, 2 * M_PI, PARTICLE_DEBRIS_LIFETIME);
+}
+
+/**
+ * \brief La fonction émet la gerbe du passage de la ligne d'arrivée, dans toutes les directions
+ * \param particles les particules
+ * \param x l'abscisse du vaisseau
+ * \param y l'ordonnée du vaisseau
+ */
+void emit_burst(particles_t *particles, double x, double y) {
+    spawn_particles(particles, PARTICLE_BURST, PARTICLE_BURST_COUNT, x, y, 0.0, 0.0, PARTICLE_BURST_SPEED, 0.0, 2 * M_PI, PARTICLE_BURST_LIFETIME);
+}
+
+/**
+ * \brief La fonction fait avancer une réserve d'un pas. Le mouvement est une boucle sans branchement sur les tableaux, vectorisable ; les
+ * particules mortes sont ensuite remplacées par les dernières de la réserve.
+ * \param pool la réserve
+ * \param duration la durée du pas, en ms
+ * \param damping le facteur d'amortissement des vitesses sur le pas
+ */
+static void update_particle_pool(particle_pool_t *pool, float duration, float damping) {
+    float *restrict x = pool->x, *restrict y = pool->y, *restrict speed_x = pool->speed_x, *restrict speed_y = pool->speed_y;
+    float *restrict age = pool->age;
+    for (size_t i = 0; i < pool->count; i++) {
+        speed_x[i] *= damping;
+        speed_y[i] *= damping;
+        x[i] += speed_x[i] * duration;
+        y[i] += speed_y[i] * duration;
+        age[i] += duration;
+    }
+    for (size_t i = 0; i < pool->count;) {
+        if (pool->age[i] < pool->lifetime[i]) {
+            i++;
+            continue;
+        }
+        size_t last = --pool->count;
+        pool->x[i] = pool->x[last];
+        pool->y[i] = pool->y[last];
+        pool->speed_x[i] = pool->speed_x[last];
+        pool->speed_y[i] = pool->speed_y[last];
+        pool->age[i] = pool->age[last];
+        pool->lifetime[i] = pool->lifetime[last];
+    }
+}
+
+/**
+ * \brief La fonction fait avancer toutes les particules d'un pas
+ * \param particles les particules
+ * \param duration la durée du pas, en ms
+ */
+void update_particles(particles_t *particles, double duration) {
+    float damping = exp(-PARTICLE_DRAG * duration);
+    for (int kind = 0; kind < PARTICLE_KIND_COUNT; kind++) {
+        update_particle_pool(&particles->pools[kind], duration, damping);
+    }
+    size_t live = live_particle_count(particles);
+    if (live > particles->peak_live) {
+        particles->peak_live = live;
+    }
+}
+
+/**
+ * \brief La fonction compte les particules vivantes
+ * \param particles les particules
+ * \return le nombre de particules vivantes, toutes sortes confondues
+ */
+size_t live_particle_count(const particles_t *particles) {
+    size_t live = 0;
+    for (int kind = 0; kind < PARTICLE_KIND_COUNT; kind++) {
+        live += particles->pools[kind].count;
+    }
+    return live;
+}
+
+/**
+ * \brief La fonction copie les particules d'une réserve qui sont dans un rectangle, avec leur vie restante
+ * \param pool la réserve
+ * \param min_x la gauche du rectangle
+ * \param max_x la droite du rectangle
+ * \param min_y le haut du rectangle
+ * \param max_y le bas du rectangle
+ * \param x les abscisses copiées, d'au moins PARTICLE_CAPACITY emplacements
+ * \param y les ordonnées copiées
+ * \param life les vies restantes copiées, de 1 à la naissance à 0 à la mort
+ * \return le nombre de particules copiées
+ */
+size_t copy_visible_particles(const particle_pool_t *pool, float min_x, float max_x, float min_y, float max_y, float *x, float *y, float *life) {
+    size_t count = 0;
+    for (size_t i = 0; i < pool->count; i++) {
+        // Chaque particule est écrite, mais le compteur n'avance que pour les particules visibles
+        x[count] = pool->x[i];
+        y[count] = pool->y[i];
+        life[count] = 1.0f - pool->age[i] / pool->lifetime[i];
+        count += pool->x[i] >= min_x && pool->x[i] <= max_x && pool->y[i] >= min_y && pool->y[i] <= max_y;
+    }
+    return count;
+}
+
+/**
+ * \brief La fonction supprime toutes les particules, par exemple au changement de niveau
+ * \param particles les particules
+ */
+void clear_particles(particles_t *particles) {
+    for (int kind = 0; kind < PARTICLE_KIND_COUNT; kind++) {
+        particles->pools[kind].count = 0;
+    }
+    particles->exhaust_credit = 0.0;
+}
+
+/**
+ * \brief La fonction affiche les compteurs de particules
+ * \param particles les particules
+ */
+void report_particles(const particles_t *particles) {
+    printf("Particules : %zu vivantes (au plus %zu), %llu émises, %llu écartées hors écran\n", live_particle_count(particles), particles->peak_live,
+           (unsigned long long)particles->spawned, (unsigned long long)particles->culled);
+}
+
+/**
+ * \brief La fonction libère les réserves
+ * \param particles les particules
+ */
+void clean_particles(particles_t *particles) {
+    free(particles->storage);
+    particles->storage = NULL;
+    clear_particles(particles);
+}
@@ -0,0 +1,79 @@
+/**
+ * \file particles.h
+ * \brief Fichier contenant le système de particules : réserves de taille fixe en structure de tableaux, mises à jour sans allocation
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#ifndef __PARTICLES_H__
+#define __PARTICLES_H__
+
+#include <SDL.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * \brief Nombre maximal de particules vivantes de chaque sorte
+ */
+#define PARTICLE_CAPACITY 32768
+
+/**
+ * \brief Sortes de particules, chacune avec sa propre réserve et dessinée en un seul appel
+ */
+enum particle_kind_e {
+    PARTICLE_EXHAUST, /*!< Traînée du réacteur */
+    PARTICLE_DEBRIS,  /*!< Débris d'une collision */
+    PARTICLE_BURST,   /*!< Gerbe du passage de la ligne d'arrivée */
+    PARTICLE_KIND_COUNT,
+};
+typedef enum particle_kind_e particle_kind_t;
+
+/**
+ * \brief Réserve de particules d'une sorte. Les particules vivantes occupent les count premiers emplacements, une particule morte étant
+ * remplacée par la dernière.
+ */
+typedef struct particle_pool_s {
+    size_t count;
+    float *x;
+    float *y;
+    float *speed_x;  /*!< Vitesse horizontale, en unités par ms */
+    float *speed_y;  /*!< Vitesse verticale, en unités par ms */
+    float *age;      /*!< Âge, en ms */
+    float *lifetime; /*!< Durée de vie, en ms */
+} particle_pool_t;
+
+/**
+ * \brief Particules du monde
+ */
+typedef struct particles_s {
+    particle_pool_t pools[PARTICLE_KIND_COUNT];
+    float *storage;        /*!< Bloc unique qui contient tous les tableaux des réserves */
+    Uint32 random;         /*!< État du générateur pseudo-aléatoire, pour des effets reproductibles hors écran */
+    double exhaust_credit; /*!< Fraction de particule de traînée restant à émettre */
+    Uint64 spawned;        /*!< Nombre de particules émises */
+    Uint64 culled;         /*!< Nombre de particules hors écran écartées des instantanés */
+    size_t peak_live;      /*!< Nombre maximal de particules vivantes en même temps */
+} particles_t;
+
+void init_particles(particles_t *particles);
+
+void emit_exhaust(particles_t *particles, double x, double y, double speed_x, double speed_y, double intensity, double duration);
+
+void emit_debris(particles_t *particles, double x, double y);
+
+void emit_burst(particles_t *particles, double x, double y);
+
+void update_particles(particles_t *particles, double duration);
+
+size_t live_particle_count(const particles_t *particles);
+
+size_t copy_visible_particles(const particle_pool_t *pool, float min_x, float max_x, float min_y, float max_y, float *x, float *y, float *life);
+
+void clear_particles(particles_t *particles);
+
+void report_particles(const particles_t *particles);
+
+void clean_particles(particles_t *particles);
+
+#endif
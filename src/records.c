@@ -0,0 +1,307 @@
+/**
+ * \file records.c
+ * \brief Fichier contenant les records personnels, conservés dans un journal en ajout seul écrit par un fil en arrière-plan
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#include "records.h"
+#include <stdlib.h>
+#include <string.h>
+#ifndef _WIN32
+#include <unistd.h>
+#else
+#include <io.h>
+#endif
+
+/**
+ * \brief La fonction calcule le CRC-32 (polynôme 0xEDB88320) d'un bloc de données
+ * \param data les données
+ * \param size la taille des données
+ * \return le CRC-32
+ */
+static Uint32 crc32(const void *data, size_t size) {
+    const Uint8 *bytes = data;
+    Uint32 crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < size; i++) {
+        crc ^= bytes[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+        }
+    }
+    return ~crc;
+}
+
+/**
+ * \brief La fonction force l'écriture sur disque d'un fichier
+ * \param file le fichier
+ * \return true si les données sont sur disque, false sinon
+ */
+static bool sync_file(FILE *file) {
+    if (fflush(file) != 0) {
+        return false;
+    }
+#ifndef _WIN32
+    return fsync(fileno(file)) == 0;
+#else
+    return _commit(_fileno(file)) == 0;
+#endif
+}
+
+/**
+ * \brief La fonction ajoute une course à la fin d'un fichier, précédée de son en-tête
+ * \param file le fichier
+ * \param record la course
+ * \return true si l'entrée a été écrite, false sinon
+ */
+static bool write_record(FILE *file, const record_t *record) {
+    record_header_t header = {RECORDS_MAGIC, sizeof(record_t), crc32(record, sizeof(record_t)), 0};
+    return fwrite(&header, sizeof(header), 1, file) == 1 && fwrite(record, sizeof(record_t), 1, file) == 1;
+}
+
+/**
+ * \brief La fonction garde une course dans un index si elle est la meilleure de son niveau
+ * \param index l'index
+ * \param record la course
+ * \return true si la course est la nouvelle meilleure course du niveau, false sinon
+ */
+static bool index_record(record_t *index, const record_t *record) {
+    record_t *best = &index[record->level];
+    if (best->time != 0 && best->time <= record->time) {
+        return false;
+    }
+    *best = *record;
+    return true;
+}
+
+/**
+ * \brief La fonction donne le nombre de niveaux qui ont une meilleure course dans un index
+ * \param index l'index
+ * \return le nombre de niveaux
+ */
+static int indexed_level_count(const record_t *index) {
+    int count = 0;
+    for (int level = 0; level < RECORDS_MAX_LEVELS; level++) {
+        count += index[level].time != 0;
+    }
+    return count;
+}
+
+/**
+ * \brief La fonction lit le journal et reconstruit l'index de ses meilleures courses. La lecture s'arrête à la première entrée incomplète ou dont
+ * la somme de contrôle ne correspond pas, comme celle qu'aurait laissée un arrêt brutal pendant son écriture.
+ * \param records les records
+ * \return true si tout le journal est valide, false s'il se termine par des données à écarter
+ */
+static bool load_records(records_t *records) {
+    records->log_count = 0;
+    FILE *file = fopen(records->path, "rb");
+    if (file == NULL) {
+        return true;
+    }
+    record_header_t header;
+    record_t record;
+    size_t header_read;
+    bool valid = true;
+    while ((header_read = fread(&header, 1, sizeof(header), file)) > 0) {
+        valid = header_read == sizeof(header) && header.magic == RECORDS_MAGIC && header.size == sizeof(record_t) &&
+                fread(&record, sizeof(record_t), 1, file) == 1 && crc32(&record, sizeof(record_t)) == header.checksum &&
+                record.level >= 0 && record.level < RECORDS_MAX_LEVELS && record.time != 0;
+        if (!valid) {
+            fprintf(stderr, "Journal des records %s tronqué après %d entrées, la fin est ignorée\n", records->path, records->log_count);
+            break;
+        }
+        record.replay[RECORDS_REPLAY_SIZE - 1] = '\0';
+        index_record(records->log_best, &record);
+        records->log_count++;
+    }
+    fclose(file);
+    return valid;
+}
+
+/**
+ * \brief La fonction réécrit le journal avec les seules meilleures courses. Le nouveau journal est écrit à côté, forcé sur disque puis renommé,
+ * de sorte qu'un arrêt brutal laisse toujours l'un des deux journaux complet. Si la mémoire manque, la compaction est remise à plus tard et
+ * le journal reste tel quel.
+ * \param records les records
+ * \return true si le journal a été compacté, false sinon
+ */
+static bool compact_records(records_t *records) {
+    char *temporary_path = malloc(strlen(records->path) + 5);
+    if (temporary_path == NULL) {
+        fprintf(stderr, "Mémoire insuffisante pour compacter le journal des records %s\n", records->path);
+        if (records->file == NULL) {
+            records->file = fopen(records->path, "ab");
+        }
+        return false;
+    }
+    sprintf(temporary_path, "%s.tmp", records->path);
+    FILE *file = fopen(temporary_path, "wb");
+    bool written = file != NULL;
+    for (int level = 0; written && level < RECORDS_MAX_LEVELS; level++) {
+        if (records->log_best[level].time != 0) {
+            written = write_record(file, &records->log_best[level]);
+        }
+    }
+    written = written && sync_file(file);
+    if (file != NULL) {
+        fclose(file);
+    }
+    if (records->file != NULL) {
+        fclose(records->file);
+        records->file = NULL;
+    }
+#ifdef _WIN32
+    // rename ne remplace pas un fichier existant sous Windows
+    written = written && remove(records->path) == 0;
+#endif
+    written = written && rename(temporary_path, records->path) == 0;
+    if (written) {
+        records->log_count = indexed_level_count(records->log_best);
+        SDL_AtomicAdd(&records->compactions, 1);
+    } else {
+        fprintf(stderr, "Erreur pendant la compaction du journal des records %s\n", records->path);
+        remove(temporary_path);
+    }
+    free(temporary_path);
+    records->file = fopen(records->path, "ab");
+    if (records->file == NULL) {
+        fprintf(stderr, "Erreur pendant l'ouverture du journal des records %s\n", records->path);
+    }
+    return written;
+}
+
+/**
+ * \brief La fonction indique si le journal contient assez d'entrées périmées pour être compacté
+ * \param records les records
+ * \return true si le journal doit être compacté, false sinon
+ */
+static bool records_need_compaction(const records_t *records) {
+    return records->log_count - indexed_level_count(records->log_best) >= RECORDS_COMPACTION_SLACK;
+}
+
+/**
+ * \brief La boucle du fil d'écriture : il ajoute les courses de la file au journal et les force sur disque, jusqu'à l'arrêt des records et
+ * l'épuisement de la file
+ * \param data les records
+ * \return 0
+ */
+static int records_thread(void *data) {
+    records_t *records = data;
+    while (true) {
+        SDL_SemWait(records->pending);
+        bool running = SDL_AtomicGet(&records->running);
+        int tail = SDL_AtomicGet(&records->tail), head = SDL_AtomicGet(&records->head);
+        bool damaged = false;
+        for (int i = tail; i != head; i++) {
+            const record_t *record = &records->queue[i % RECORDS_QUEUE_SIZE];
+            index_record(records->log_best, record);
+            records->log_count++;
+            damaged |= records->file == NULL || !write_record(records->file, record);
+        }
+        if (head != tail && !damaged) {
+            damaged = !sync_file(records->file);
+        }
+        SDL_AtomicAdd(&records->written, head - tail);
+        SDL_AtomicSet(&records->tail, head);
+        // Après une erreur d'écriture, le journal peut se terminer par une entrée incomplète : il est réécrit depuis l'index
+        if (damaged || records_need_compaction(records)) {
+            compact_records(records);
+        }
+        if (!running && head == SDL_AtomicGet(&records->head)) {
+            break;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief La fonction charge le journal des records, le compacte si nécessaire et démarre le fil d'écriture
+ * \param records les records
+ * \param path le chemin du journal, créé s'il n'existe pas
+ * \return true si les records ont démarré, false sinon
+ */
+bool start_records(records_t *records, const char *path) {
+    records->path = path;
+    records->file = NULL;
+    memset(records->log_best, 0, sizeof(records->log_best));
+    SDL_AtomicSet(&records->head, 0);
+    SDL_AtomicSet(&records->tail, 0);
+    SDL_AtomicSet(&records->running, 1);
+    SDL_AtomicSet(&records->written, 0);
+    SDL_AtomicSet(&records->dropped, 0);
+    SDL_AtomicSet(&records->compactions, 0);
+
+    // Une fin tronquée est écartée par la compaction, sans quoi les entrées suivantes seraient ajoutées après elle
+    if (!load_records(records) || records_need_compaction(records)) {
+        compact_records(records);
+    } else {
+        records->file = fopen(path, "ab");
+    }
+    if (records->file == NULL) {
+        fprintf(stderr, "Erreur pendant l'ouverture du journal des records %s\n", path);
+        return false;
+    }
+    memcpy(records->best, records->log_best, sizeof(records->best));
+
+    records->pending = SDL_CreateSemaphore(0);
+    records->thread = SDL_CreateThread(records_thread, "records", records);
+    if (records->thread == NULL) {
+        fprintf(stderr, "Erreur lors de la creation du fil des records : %s\n", SDL_GetError());
+        fclose(records->file);
+        SDL_DestroySemaphore(records->pending);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * \brief La fonction donne la meilleure course d'un niveau, lue dans l'index en mémoire
+ * \param records les records, ou NULL
+ * \param level le numéro du niveau
+ * \return la meilleure course, ou NULL s'il n'y en a aucune
+ */
+const record_t *best_record(const records_t *records, int level) {
+    if (records == NULL || level < 0 || level >= RECORDS_MAX_LEVELS || records->best[level].time == 0) {
+        return NULL;
+    }
+    return &records->best[level];
+}
+
+/**
+ * \brief La fonction met à jour l'index avec une course terminée et la transmet au fil d'écriture, sans attendre l'écriture. Elle ne doit être
+ * appelée que depuis un seul fil.
+ * \param records les records, ou NULL pour ne rien enregistrer
+ * \param record la course
+ * \return true si la course est un nouveau record du niveau, false sinon
+ */
+bool submit_record(records_t *records, const record_t *record) {
+    if (records == NULL || record->level < 0 || record->level >= RECORDS_MAX_LEVELS || record->time == 0) {
+        return false;
+    }
+    bool new_best = index_record(records->best, record);
+    int head = SDL_AtomicGet(&records->head);
+    if (head - SDL_AtomicGet(&records->tail) >= RECORDS_QUEUE_SIZE) {
+        SDL_AtomicAdd(&records->dropped, 1);
+        return new_best;
+    }
+    records->queue[head % RECORDS_QUEUE_SIZE] = *record;
+    SDL_AtomicSet(&records->head, head + 1);
+    SDL_SemPost(records->pending);
+    return new_best;
+}
+
+/**
+ * \brief La fonction écrit les courses restantes, arrête le fil d'écriture et ferme le journal
+ * \param records les records
+ */
+void stop_records(records_t *records) {
+    SDL_AtomicSet(&records->running, 0);
+    SDL_SemPost(records->pending);
+    SDL_WaitThread(records->thread, NULL);
+    SDL_DestroySemaphore(records->pending);
+    if (records->file != NULL) {
+        fclose(records->file);
+    }
+}
@@ -0,0 +1,98 @@
+/**
+ * \file records.h
+ * \brief Fichier contenant les records personnels, conservés dans un journal en ajout seul écrit par un fil en arrière-plan
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#ifndef __RECORDS_H__
+#define __RECORDS_H__
+
+#include <SDL.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+/**
+ * \brief Nombre de temps de passage d'une course : un à chaque quart du niveau, le dernier étant le temps final
+ */
+#define RECORDS_SPLIT_COUNT 4
+
+/**
+ * \brief Nombre maximal de niveaux dont les records sont conservés
+ */
+#define RECORDS_MAX_LEVELS 256
+
+/**
+ * \brief Taille maximale de la référence de la course enregistrée, zéro final compris
+ */
+#define RECORDS_REPLAY_SIZE 64
+
+/**
+ * \brief Nombre de courses de la file entre le fil de simulation et le fil d'écriture
+ */
+#define RECORDS_QUEUE_SIZE 16
+
+/**
+ * \brief Nombre d'entrées périmées du journal au-delà duquel il est compacté
+ */
+#define RECORDS_COMPACTION_SLACK 64
+
+/**
+ * \brief Signature de chaque entrée du journal ("SCRC")
+ */
+#define RECORDS_MAGIC 0x43524353
+
+/**
+ * \brief Course terminée
+ */
+typedef struct record_s {
+    Sint32 level;
+    Uint32 reserved;                    /*!< Toujours 0 */
+    Uint64 time;                        /*!< Durée de la course, en ms */
+    Uint64 splits[RECORDS_SPLIT_COUNT]; /*!< Temps de passage depuis le début du niveau, en ms */
+    Sint64 date;                        /*!< Date de la course, en secondes depuis le 1er janvier 1970 */
+    char replay[RECORDS_REPLAY_SIZE];   /*!< Référence de la course parmi les fantômes ("level_N.ghosts#<durée>"), ou chaîne vide */
+} record_t;
+
+/**
+ * \brief En-tête de chaque entrée du journal, qui permet d'écarter une entrée tronquée ou corrompue
+ */
+typedef struct record_header_s {
+    Uint32 magic;
+    Uint32 size;     /*!< Taille de la course qui suit, pour vérifier la compatibilité */
+    Uint32 checksum; /*!< CRC-32 de la course */
+    Uint32 reserved;
+} record_header_t;
+
+/**
+ * \brief Records personnels. Les meilleures courses sont lues dans un index en mémoire, reconstruit depuis le journal au démarrage. Les nouvelles
+ * courses passent du fil de simulation au fil d'écriture par une file circulaire sans verrou, à un seul producteur et un seul consommateur ; le
+ * fil d'écriture les ajoute au journal, force leur écriture sur disque et compacte le journal lorsqu'il contient trop d'entrées périmées.
+ */
+typedef struct records_s {
+    const char *path;
+    record_t best[RECORDS_MAX_LEVELS];     /*!< Index des meilleures courses, propriété du fil de simulation (temps nul si aucune) */
+    record_t log_best[RECORDS_MAX_LEVELS]; /*!< Meilleures courses du journal, propriété du fil d'écriture */
+    int log_count;                         /*!< Nombre d'entrées du journal, propriété du fil d'écriture */
+    FILE *file;                            /*!< Journal ouvert en ajout, propriété du fil d'écriture */
+    record_t queue[RECORDS_QUEUE_SIZE];
+    SDL_atomic_t head; /*!< Écrit par le producteur */
+    SDL_atomic_t tail; /*!< Écrit par le fil d'écriture */
+    SDL_atomic_t running;
+    SDL_atomic_t written;     /*!< Nombre de courses écrites */
+    SDL_atomic_t dropped;     /*!< Nombre de courses abandonnées, la file étant pleine */
+    SDL_atomic_t compactions; /*!< Nombre de compactions du journal */
+    SDL_sem *pending;         /*!< Réveille le fil d'écriture */
+    SDL_Thread *thread;
+} records_t;
+
+bool start_records(records_t *records, const char *path);
+
+const record_t *best_record(const records_t *records, int level);
+
+bool submit_record(records_t *records, const record_t *record);
+
+void stop_records(records_t *records);
+
+#endif
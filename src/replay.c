@@ -0,0 +1,125 @@
+/**
+ * \file replay.c
+ * \brief Fichier contenant les enregistrements d'entrées rejoués frame par frame
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#include "replay.h"
+#include "game.h"
+#include "utilities.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * \brief La fonction lit des touches écrites avec les lettres L, R, U et D (gauche, droite, haut, bas), ou - pour aucune touche
+ * \param keys les touches
+ * \return le masque des touches
+ */
+Uint8 parse_replay_keys(const char *keys) {
+    Uint8 input = 0;
+    for (const char *key = keys; *key != '\0'; key++) {
+        input |= *key == 'L' ? INPUT_LEFT : *key == 'R' ? INPUT_RIGHT : *key == 'U' ? INPUT_UP : *key == 'D' ? INPUT_DOWN : 0;
+    }
+    return input;
+}
+
+/**
+ * \brief La fonction écrit des touches avec les lettres L, R, U et D, ou - pour aucune touche
+ * \param input le masque des touches
+ * \param keys la chaîne à remplir, d'au moins 5 caractères
+ */
+void format_replay_keys(Uint8 input, char *keys) {
+    char *key = keys;
+    if (input & INPUT_LEFT) {
+        *key++ = 'L';
+    }
+    if (input & INPUT_RIGHT) {
+        *key++ = 'R';
+    }
+    if (input & INPUT_UP) {
+        *key++ = 'U';
+    }
+    if (input & INPUT_DOWN) {
+        *key++ = 'D';
+    }
+    if (key == keys) {
+        *key++ = '-';
+    }
+    *key = '\0';
+}
+
+/**
+ * \brief La fonction charge un enregistrement d'entrées.
+ * Le fichier est un texte dont chaque ligne "<frames> <touches>" maintient des touches pendant un nombre de frames. Les touches sont les lettres
+ * L, R, U et D (gauche, droite, haut, bas), ou - pour aucune touche. Les lignes commençant par # sont ignorées.
+ * \param path le chemin du fichier
+ * \param replay l'enregistrement à remplir
+ * \return true si l'enregistrement a été chargé, false sinon
+ */
+bool load_replay(const char *path, replay_t *replay) {
+    replay->length = 0;
+    replay->inputs = NULL;
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        fprintf(stderr, "Erreur pendant l'ouverture de l'enregistrement : %s\n", path);
+        return false;
+    }
+    size_t capacity = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), file) != NULL) {
+        if (line[0] == '#' || line[0] == '\n') {
+            continue;
+        }
+        unsigned long frames;
+        char keys[16];
+        if (sscanf(line, "%lu %15s", &frames, keys) != 2) {
+            fprintf(stderr, "Ligne invalide dans l'enregistrement : %s", line);
+            continue;
+        }
+        if (frames > (size_t)REPLAY_MAX_FRAMES - replay->length) {
+            fprintf(stderr, "Enregistrement trop long (plus de %d frames) : %s\n", REPLAY_MAX_FRAMES, path);
+            fclose(file);
+            clean_replay(replay);
+            return false;
+        }
+        Uint8 input = parse_replay_keys(keys);
+        if (replay->length + frames > capacity) {
+            capacity = MIN((replay->length + frames) * 2, (size_t)REPLAY_MAX_FRAMES);
+            Uint8 *inputs = realloc(replay->inputs, capacity);
+            if (inputs == NULL) {
+                fprintf(stderr, "Mémoire insuffisante pour l'enregistrement : %s\n", path);
+                fclose(file);
+                clean_replay(replay);
+                return false;
+            }
+            replay->inputs = inputs;
+        }
+        memset(replay->inputs + replay->length, input, frames);
+        replay->length += frames;
+    }
+    fclose(file);
+    return true;
+}
+
+/**
+ * \brief La fonction donne les entrées d'une frame
+ * \param replay l'enregistrement
+ * \param frame le numéro de la frame
+ * \return le masque des touches enfoncées, aucune touche après la fin de l'enregistrement
+ */
+Uint8 replay_input(const replay_t *replay, size_t frame) {
+    return frame < replay->length ? replay->inputs[frame] : 0;
+}
+
+/**
+ * \brief La fonction libère un enregistrement d'entrées
+ * \param replay l'enregistrement
+ */
+void clean_replay(replay_t *replay) {
+    free(replay->inputs);
+    replay->inputs = NULL;
+    replay->length = 0;
+}
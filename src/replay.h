@@ -0,0 +1,39 @@
+/**
+ * \file replay.h
+ * \brief Fichier contenant les enregistrements d'entrées rejoués frame par frame
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#ifndef __REPLAY_H__
+#define __REPLAY_H__
+
+#include "constants.h"
+#include <SDL.h>
+#include <stdbool.h>
+
+/**
+ * \brief Nombre maximal de frames d'un enregistrement, une heure de jeu : au-delà, le fichier est refusé
+ */
+#define REPLAY_MAX_FRAMES (MAX_FPS * 3600)
+
+/**
+ * \brief Entrées à appliquer à chaque frame d'une simulation à pas fixe
+ */
+typedef struct replay_s {
+    size_t length; /*!< Nombre de frames */
+    Uint8 *inputs; /*!< Masques des touches enfoncées, un par frame */
+} replay_t;
+
+Uint8 parse_replay_keys(const char *keys);
+
+void format_replay_keys(Uint8 input, char *keys);
+
+bool load_replay(const char *path, replay_t *replay);
+
+Uint8 replay_input(const replay_t *replay, size_t frame);
+
+void clean_replay(replay_t *replay);
+
+#endif
@@ -0,0 +1,147 @@
+/**
+ * \file resolution.c
+ * \brief Fichier contenant la résolution dynamique de la scène de jeu, adaptée pour tenir le temps de dessin sous un budget
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#include "resolution.h"
+#include "utilities.h"
+#include <math.h>
+#include <stdio.h>
+
+/**
+ * \brief La fonction initialise la résolution dynamique, à l'échelle 1
+ * \param resolution la résolution dynamique
+ * \param budget le budget de temps de dessin d'une frame, en ms, ou 0 pour toujours dessiner à la résolution de l'écran
+ * \param show afficher l'échelle courante dans le HUD
+ */
+void init_resolution(resolution_t *resolution, double budget, bool show) {
+    *resolution = (resolution_t){.show = show, .budget = budget, .scale = 1.0, .min_scale = 1.0};
+}
+
+/**
+ * \brief La fonction prépare le dessin de la scène de jeu. À une échelle inférieure à 1, le renderer dessine dans la texture cible, limité à la
+ * taille de la scène ; sinon il dessine directement à l'écran.
+ * \param resolution la résolution dynamique, ou NULL pour dessiner à la résolution de l'écran
+ * \param renderer le renderer
+ * \param screen_w la largeur de l'écran, en pixels
+ * \param screen_h la hauteur de l'écran, en pixels
+ * \param scene_w la largeur de la scène à dessiner, en pixels
+ * \param scene_h la hauteur de la scène à dessiner, en pixels
+ * \return true si la scène est dessinée dans la texture cible, et doit être terminée par end_scene, false sinon
+ */
+bool begin_scene(resolution_t *resolution, SDL_Renderer *renderer, int screen_w, int screen_h, int *scene_w, int *scene_h) {
+    *scene_w = screen_w;
+    *scene_h = screen_h;
+    if (resolution == NULL || resolution->budget <= 0.0) {
+        return false;
+    }
+    resolution->scene_drawn = true;
+    resolution->scene_frames++;
+    resolution->scale_total += resolution->scale;
+    resolution->min_scale = MIN(resolution->min_scale, resolution->scale);
+
+    // La texture est créée même à l'échelle 1, pour qu'une baisse de l'échelle en cours de niveau n'alloue rien
+    if (resolution->target == NULL || resolution->target_w != screen_w || resolution->target_h != screen_h) {
+        if (resolution->target != NULL) {
+            SDL_DestroyTexture(resolution->target);
+        }
+        resolution->target = SDL_RenderTargetSupported(renderer)
+                                 ? SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, screen_w, screen_h)
+                                 : NULL;
+        if (resolution->target == NULL) {
+            fprintf(stderr, "Erreur lors de la creation de la texture cible, la résolution dynamique est désactivée : %s\n", SDL_GetError());
+            resolution->budget = 0.0;
+            return false;
+        }
+        // La scène est agrandie par interpolation bilinéaire et recouvre tout l'écran
+        SDL_SetTextureScaleMode(resolution->target, SDL_ScaleModeLinear);
+        SDL_SetTextureBlendMode(resolution->target, SDL_BLENDMODE_NONE);
+        resolution->target_w = screen_w;
+        resolution->target_h = screen_h;
+    }
+    if (resolution->scale >= 1.0) {
+        return false;
+    }
+
+    resolution->scene_w = *scene_w = MAX((int)lround(screen_w * resolution->scale), 1);
+    resolution->scene_h = *scene_h = MAX((int)lround(screen_h * resolution->scale), 1);
+    SDL_SetRenderTarget(renderer, resolution->target);
+    SDL_Rect viewport = {0, 0, *scene_w, *scene_h};
+    SDL_RenderSetViewport(renderer, &viewport);
+    // Seule la scène est effacée, et non toute la texture comme le ferait SDL_RenderClear
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderFillRect(renderer, NULL);
+    return true;
+}
+
+/**
+ * \brief La fonction termine le dessin de la scène dans la texture cible et l'agrandit à tout l'écran
+ * \param resolution la résolution dynamique
+ * \param renderer le renderer
+ */
+void end_scene(resolution_t *resolution, SDL_Renderer *renderer) {
+    SDL_SetRenderTarget(renderer, NULL);
+    SDL_RenderSetViewport(renderer, NULL);
+    SDL_Rect scene = {0, 0, resolution->scene_w, resolution->scene_h};
+    SDL_RenderCopy(renderer, resolution->target, &scene, NULL);
+}
+
+/**
+ * \brief La fonction ajoute le temps de dessin d'une frame à la moyenne glissante et ajuste l'échelle toutes les RESOLUTION_ADJUST_FRAMES frames.
+ * Le coût du remplissage étant proportionnel au nombre de pixels, donc au carré de l'échelle, l'échelle baisse d'un coup de la racine du
+ * dépassement ; elle remonte d'un pas à la fois.
+ * \param resolution la résolution dynamique
+ * \param frame_time le temps de dessin et de présentation de la frame, en ms
+ */
+void record_frame_time(resolution_t *resolution, double frame_time) {
+    // Seules les frames de jeu sont mesurées, les autres écrans n'étant pas dessinés à l'échelle
+    if (!resolution->scene_drawn) {
+        return;
+    }
+    resolution->scene_drawn = false;
+    resolution->average = resolution->average == 0.0 ? frame_time : resolution->average + (frame_time - resolution->average) * RESOLUTION_SMOOTHING;
+    if (++resolution->frames < RESOLUTION_ADJUST_FRAMES) {
+        return;
+    }
+    resolution->frames = 0;
+
+    double scale = resolution->scale;
+    if (resolution->average > resolution->budget) {
+        scale = floor(scale * sqrt(resolution->budget / resolution->average) / RESOLUTION_SCALE_STEP) * RESOLUTION_SCALE_STEP;
+    } else if (resolution->average < resolution->budget * RESOLUTION_GROWTH_MARGIN) {
+        scale += RESOLUTION_SCALE_STEP;
+    }
+    scale = CLAMP(scale, RESOLUTION_MIN_SCALE, 1.0);
+    if (scale != resolution->scale) {
+        // La moyenne repart de zéro, le temps de dessin à l'ancienne échelle ne disant rien de la nouvelle
+        resolution->scale = scale;
+        resolution->average = 0.0;
+    }
+}
+
+/**
+ * \brief La fonction affiche les mesures de la résolution dynamique
+ * \param resolution la résolution dynamique
+ */
+void report_resolution(const resolution_t *resolution) {
+    if (resolution->scene_frames == 0) {
+        printf("Résolution dynamique : désactivée ou aucune frame de jeu\n");
+        return;
+    }
+    printf("Résolution dynamique : budget %.1f ms, échelle finale %.0f %%, moyenne %.0f %%, minimale %.0f %%\n", resolution->budget,
+           resolution->scale * 100.0, resolution->scale_total / resolution->scene_frames * 100.0, resolution->min_scale * 100.0);
+}
+
+/**
+ * \brief La fonction libère la texture cible
+ * \param resolution la résolution dynamique
+ */
+void clean_resolution(resolution_t *resolution) {
+    if (resolution->target != NULL) {
+        SDL_DestroyTexture(resolution->target);
+        resolution->target = NULL;
+    }
+}
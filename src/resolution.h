@@ -0,0 +1,75 @@
+/**
+ * \file resolution.h
+ * \brief Fichier contenant la résolution dynamique de la scène de jeu, adaptée pour tenir le temps de dessin sous un budget
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#ifndef __RESOLUTION_H__
+#define __RESOLUTION_H__
+
+#include <SDL.h>
+#include <stdbool.h>
+
+/**
+ * \brief Échelle minimale de la scène, par rapport à la résolution de l'écran
+ */
+#define RESOLUTION_MIN_SCALE 0.5
+
+/**
+ * \brief Pas des changements d'échelle
+ */
+#define RESOLUTION_SCALE_STEP 0.0625
+
+/**
+ * \brief Nombre de frames entre deux ajustements de l'échelle
+ */
+#define RESOLUTION_ADJUST_FRAMES 30
+
+/**
+ * \brief Poids de chaque frame dans la moyenne glissante du temps de dessin
+ */
+#define RESOLUTION_SMOOTHING 0.1
+
+/**
+ * \brief Part du budget sous laquelle le temps de dessin moyen doit passer pour que l'échelle augmente, ce qui évite les oscillations
+ */
+#define RESOLUTION_GROWTH_MARGIN 0.75
+
+/**
+ * \brief Résolution dynamique de la scène
+ *
+ * La scène est dessinée dans le coin d'une texture cible de la taille de l'écran, puis agrandie à l'écran : un changement d'échelle ne réalloue
+ * rien, seul un changement de taille de l'écran recrée la texture.
+ */
+typedef struct resolution_s {
+    bool show;           /*!< Afficher l'échelle courante dans le HUD */
+    double budget;       /*!< Budget de temps de dessin d'une frame, en ms, ou 0 pour toujours dessiner à la résolution de l'écran */
+    double scale;        /*!< Échelle courante de la scène, par pas de RESOLUTION_SCALE_STEP */
+    double average;      /*!< Moyenne glissante du temps de dessin à l'échelle courante, en ms, ou 0 */
+    int frames;          /*!< Frames dessinées depuis le dernier ajustement */
+    bool scene_drawn;    /*!< Indique si la frame en cours a dessiné la scène de jeu */
+    SDL_Texture *target; /*!< Texture cible, de la taille de l'écran */
+    int target_w;
+    int target_h;
+    int scene_w; /*!< Taille de la scène dans la texture cible */
+    int scene_h;
+    Uint64 scene_frames; /*!< Nombre de frames de jeu dessinées, pour les mesures */
+    double scale_total;  /*!< Somme des échelles de ces frames */
+    double min_scale;    /*!< Échelle minimale atteinte */
+} resolution_t;
+
+void init_resolution(resolution_t *resolution, double budget, bool show);
+
+bool begin_scene(resolution_t *resolution, SDL_Renderer *renderer, int screen_w, int screen_h, int *scene_w, int *scene_h);
+
+void end_scene(resolution_t *resolution, SDL_Renderer *renderer);
+
+void record_frame_time(resolution_t *resolution, double frame_time);
+
+void report_resolution(const resolution_t *resolution);
+
+void clean_resolution(resolution_t *resolution);
+
+#endif
@@ -7,11 +7,21 @@
  */
 
 #include "resources.h"
+#include "constants.h"
+#include "logger.h"
+#include "trace.h"
 #include "utilities.h"
 
-void init_mix() {
-    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) == -1) {
-        fprintf(stderr, "Erreur en Mix_OpenAudio : %s\n", Mix_GetError());
+/**
+ * \brief La fonction ouvre l'audio. La fréquence et le nombre de canaux peuvent être négociés avec le périphérique, les sons étant convertis
+ * au format négocié une seule fois, à leur chargement.
+ * \param low_latency utiliser un petit tampon, pour que les sons suivent les évènements au plus près
+ */
+void init_mix(bool low_latency) {
+    int chunk_size = low_latency ? AUDIO_LOW_LATENCY_CHUNK_SIZE : AUDIO_CHUNK_SIZE;
+    if (Mix_OpenAudioDevice(AUDIO_FREQUENCY, AUDIO_FORMAT, AUDIO_CHANNELS, chunk_size, NULL,
+                            SDL_AUDIO_ALLOW_FREQUENCY_CHANGE | SDL_AUDIO_ALLOW_CHANNELS_CHANGE) == -1) {
+        LOG_ERROR("Erreur en Mix_OpenAudioDevice : %s", Mix_GetError());
     }
 }
 
@@ -30,7 +40,7 @@ Mix_Chunk *load_sound(const char *exe_path, const char *path) {
     Mix_Chunk *sound = Mix_LoadWAV(full_path);
     if (sound == NULL) {
         free(full_path);
-        fprintf(stderr, "Erreur pendant chargement du son : %s\n", Mix_GetError());
+        LOG_ERROR("Erreur pendant chargement du son : %s", Mix_GetError());
         return NULL;
     }
     free(full_path);
@@ -64,36 +74,198 @@ void clean_sound(Mix_Chunk *sound) {
     Mix_FreeChunk(sound);
 }
 
+/**
+ * \brief La fonction charge une image, depuis l'archive des ressources si elle s'y trouve (sans décodage ni copie des pixels), sinon depuis son fichier
+ * \param exe_dir le chemin de l'exécutable, utilisé pour construire le chemin complet du fichier
+ * \param resources les ressources, pour leur archive
+ * \param renderer le renderer, ou NULL pour ne pas créer de texture
+ * \param path le chemin de l'image
+ * \param image_surface_out si non NULL, la surface de l'image sera stockée ici
+ * \param success si non NULL, mis à true si l'image a été chargée avec succès, false sinon
+ * \return la texture de l'image, ou NULL
+ */
+SDL_Texture *load_resource_image(const char *exe_dir, resources_t *resources, SDL_Renderer *renderer, const char *path, SDL_Surface **image_surface_out,
+                                 bool *success) {
+    const archive_entry_t *entry = find_archive_entry(&resources->archive, path);
+    if (entry == NULL || entry->type != ARCHIVE_ENTRY_IMAGE) {
+        return load_image(renderer, exe_dir, path, image_surface_out, success);
+    }
+    // La surface pointe directement vers les pixels de l'archive
+    SDL_Surface *surface =
+        SDL_CreateRGBSurfaceWithFormatFrom(archive_entry_data(&resources->archive, entry), entry->width, entry->height, 32, entry->width * 4, entry->format);
+    SDL_Texture *texture = renderer == NULL || surface == NULL ? NULL : SDL_CreateTextureFromSurface(renderer, surface);
+    if (image_surface_out != NULL) {
+        *image_surface_out = surface;
+    } else {
+        SDL_FreeSurface(surface);
+    }
+    if (success) {
+        *success = surface != NULL && (renderer == NULL || texture != NULL);
+    }
+    return texture;
+}
+
+/**
+ * \brief La fonction charge un son, depuis l'archive des ressources si elle s'y trouve, sinon depuis son fichier. Les échantillons de l'archive sont
+ * joués directement s'ils sont déjà au format de sortie de l'audio, et convertis une seule fois sinon.
+ * \param exe_dir le chemin de l'exécutable, utilisé pour construire le chemin complet du fichier
+ * \param resources les ressources, pour leur archive
+ * \param path le chemin du son
+ * \return le son chargé, ou NULL
+ */
+Mix_Chunk *load_resource_sound(const char *exe_dir, resources_t *resources, const char *path) {
+    const archive_entry_t *entry = find_archive_entry(&resources->archive, path);
+    if (entry == NULL || entry->type != ARCHIVE_ENTRY_SOUND) {
+        return load_sound(exe_dir, path);
+    }
+    Uint8 *samples = archive_entry_data(&resources->archive, entry);
+    int frequency, channels;
+    Uint16 format;
+    if (Mix_QuerySpec(&frequency, &format, &channels) == 0) {
+        return NULL;
+    }
+    if ((Uint32)frequency == entry->width && (Uint32)channels == entry->height && format == entry->format) {
+        return Mix_QuickLoad_RAW(samples, entry->size);
+    }
+    SDL_AudioCVT cvt;
+    int built = SDL_BuildAudioCVT(&cvt, entry->format, entry->height, entry->width, format, channels, frequency);
+    if (built < 0) {
+        LOG_ERROR("Conversion impossible du son %s : %s", path, SDL_GetError());
+        return NULL;
+    }
+    if (!cvt.needed) {
+        return Mix_QuickLoad_RAW(samples, entry->size);
+    }
+    cvt.len = entry->size;
+    cvt.buf = SDL_malloc((size_t)entry->size * cvt.len_mult);
+    if (cvt.buf == NULL) {
+        LOG_ERROR("Mémoire insuffisante pour convertir le son %s", path);
+        return NULL;
+    }
+    memcpy(cvt.buf, samples, entry->size);
+    Mix_Chunk *sound = SDL_ConvertAudio(&cvt) == 0 ? Mix_QuickLoad_RAW(cvt.buf, cvt.len_cvt) : NULL;
+    if (sound == NULL) {
+        LOG_ERROR("Conversion impossible du son %s : %s", path, SDL_GetError());
+        SDL_free(cvt.buf);
+        return NULL;
+    }
+    // Les échantillons convertis seront libérés par Mix_FreeChunk
+    sound->allocated = 1;
+    return sound;
+}
+
 /**
  * \brief La fonction initialise les ressources nécessaires à l'affichage graphique du jeu
  * \param exe_dir le chemin de l'exécutable, utilisé pour charger les ressources
  * \param renderer le renderer correspondant à l'écran de jeu
  * \param resources Les ressources du jeu
+ * \return true si les ressources sont utilisables, false si leurs masques de collision n'ont pas pu être alloués ; elles doivent être libérées
+ * avec clean_resources dans les deux cas
  */
-void init_resources(const char *exe_dir, SDL_Renderer *renderer, resources_t *resources) {
-    resources->splash_screen_texture = load_image(renderer, exe_dir, "resources/splash_screen.png", &resources->splash_screen_surface, NULL);
-    resources->background_texture = load_image(renderer, exe_dir, "resources/background.png", &resources->background_surface, NULL);
-    resources->spaceship_texture = load_image(renderer, exe_dir, "resources/spaceship.png", &resources->spaceship_surface, NULL);
-    resources->flame_texture = load_image(renderer, exe_dir, "resources/flame.png", &resources->flame_surface, NULL);
-    resources->finish_line_texture = load_image(renderer, exe_dir, "resources/finish_line.png", &resources->finish_line_surface, NULL);
-    resources->meteorite_texture = load_image(renderer, exe_dir, "resources/meteorite.png", &resources->meteorite_surface, NULL);
-    resources->splash_screen_sound = load_sound(exe_dir, "resources/splash_screen.wav");
-    resources->loss_sound = load_sound(exe_dir, "resources/loss.wav");
-    resources->win_sound = load_sound(exe_dir, "resources/win.wav");
+bool init_resources(const char *exe_dir, SDL_Renderer *renderer, resources_t *resources) {
+    TRACE_BEGIN(span);
+    char *archive_path = concat_paths(exe_dir, ARCHIVE_FILE_NAME);
+    if (!open_archive(archive_path, &resources->archive)) {
+        // Pas d'archive : les ressources sont lues et décodées depuis leurs fichiers
+        resources->archive = (archive_t){0};
+    }
+    free(archive_path);
+
+    // Tampons de dessin des particules, assez grands pour une réserve pleine ; sans eux, les particules ne sont pas dessinées
+    resources->particle_vertices = malloc(sizeof(float) * 8 * PARTICLE_CAPACITY);
+    resources->particle_colors = malloc(sizeof(SDL_Color) * 4 * PARTICLE_CAPACITY);
+    resources->particle_indices = malloc(sizeof(int) * 6 * PARTICLE_CAPACITY);
+    if (resources->particle_vertices == NULL || resources->particle_colors == NULL || resources->particle_indices == NULL) {
+        LOG_ERROR("Mémoire insuffisante pour dessiner les particules, elles sont désactivées");
+        free(resources->particle_vertices);
+        free(resources->particle_colors);
+        free(resources->particle_indices);
+        resources->particle_vertices = NULL;
+        resources->particle_colors = NULL;
+        resources->particle_indices = NULL;
+    }
+    for (int i = 0; resources->particle_indices != NULL && i < PARTICLE_CAPACITY; i++) {
+        int quad_indices[6] = {0, 1, 2, 0, 2, 3};
+        for (int j = 0; j < 6; j++) {
+            resources->particle_indices[i * 6 + j] = i * 4 + quad_indices[j];
+        }
+    }
+
+    resources->splash_screen_texture =
+        load_resource_image(exe_dir, resources, renderer, "resources/splash_screen.png", &resources->splash_screen_surface, NULL);
+    resources->background_texture = load_resource_image(exe_dir, resources, renderer, "resources/background.png", &resources->background_surface, NULL);
+    for (int layer = 0; layer < BACKGROUND_LAYER_COUNT; layer++) {
+        char layer_path[40];
+        bool success;
+        sprintf(layer_path, "resources/background_%d.png", layer + 1);
+        resources->background_layer_textures[layer] = load_resource_image(exe_dir, resources, renderer, layer_path, NULL, &success);
+        if (!success) {
+            resources->background_layer_textures[layer] = NULL;
+        }
+    }
+    SDL_Texture *texture = load_resource_image(exe_dir, resources, renderer, "resources/spaceship.png", &resources->spaceship_surface, NULL);
+    build_sprite(renderer, resources->spaceship_surface, texture, &resources->spaceship_sprite);
+    texture = load_resource_image(exe_dir, resources, renderer, "resources/flame.png", &resources->flame_surface, NULL);
+    build_sprite(renderer, resources->flame_surface, texture, &resources->flame_sprite);
+    texture = load_resource_image(exe_dir, resources, renderer, "resources/finish_line.png", &resources->finish_line_surface, NULL);
+    build_sprite(renderer, resources->finish_line_surface, texture, &resources->finish_line_sprite);
+    texture = load_resource_image(exe_dir, resources, renderer, "resources/meteorite.png", &resources->meteorite_surface, NULL);
+    build_sprite(renderer, resources->meteorite_surface, texture, &resources->meteorite_sprite);
+    // Tous les masques sont construits, même après un échec, pour que clean_resources puisse tout libérer
+    bool masks_built =
+        build_rotated_collision_masks(resources->spaceship_surface, SPACESHIP_MAX_BANK_ANGLE, SPACESHIP_BANK_ANGLE_COUNT, resources->spaceship_masks);
+    masks_built = build_rotated_collision_masks(resources->meteorite_surface, 180.0, METEORITE_ROTATION_COUNT, resources->meteorite_masks) && masks_built;
+    masks_built = build_collision_mask(resources->finish_line_surface, &resources->finish_line_mask) && masks_built;
+    resources->splash_screen_sound = load_resource_sound(exe_dir, resources, "resources/splash_screen.wav");
+    resources->loss_sound = load_resource_sound(exe_dir, resources, "resources/loss.wav");
+    resources->win_sound = load_resource_sound(exe_dir, resources, "resources/win.wav");
     resources->font = NULL;
+    resources->font_size = 0;
+    resources->glyphs = (glyph_cache_t){0};
+    resources->levels_dir = NULL;
+    resources->overview_texture = NULL;
+    resources->overview_version = 0;
+    // La carte de densité d'un niveau est dimensionnée pour tenir dans une texture de ce renderer
+    SDL_RendererInfo info;
+    bool has_info = renderer != NULL && SDL_GetRendererInfo(renderer, &info) == 0;
+    resources->max_texture_width = has_info ? info.max_texture_width : 0;
+    resources->max_texture_height = has_info ? info.max_texture_height : 0;
+    start_audio(&resources->audio);
+    TRACE_END(span, "init_resources");
+    if (!masks_built) {
+        LOG_ERROR("Mémoire insuffisante pour les masques de collision");
+        return false;
+    }
+    return true;
 }
 
 /**
- * \brief La fonction rafraichit la police. Peut être appelée plusieurs fois et utilisée pour changer la taille de la police
+ * \brief La fonction rafraichit la police. Peut être appelée à chaque image : la police et ses glyphes ne sont recréés que si la taille change
  * \param exe_dir le chemin de l'exécutable, utilisé pour charger les ressources
+ * \param renderer le renderer, pour rendre les glyphes
  * \param resources Les ressources du jeu
  * \param font_size La taille de la police
  */
-void refresh_font(const char *exe_dir, resources_t *resources, int font_size) {
+void refresh_font(const char *exe_dir, SDL_Renderer *renderer, resources_t *resources, int font_size) {
+    if (resources->font != NULL && resources->font_size == font_size) {
+        return;
+    }
+    TRACE_BEGIN(span);
     if (resources->font != NULL) {
         clean_font(resources->font);
+        clean_glyph_cache(&resources->glyphs);
+    }
+    const archive_entry_t *entry = find_archive_entry(&resources->archive, "resources/COOPBL.ttf");
+    if (entry != NULL && entry->type == ARCHIVE_ENTRY_FONT) {
+        resources->font = TTF_OpenFontRW(SDL_RWFromConstMem(archive_entry_data(&resources->archive, entry), entry->size), 1, font_size);
+    } else {
+        resources->font = load_font(exe_dir, "resources/COOPBL.ttf", font_size);
+    }
+    resources->font_size = font_size;
+    if (resources->font != NULL) {
+        build_glyph_cache(renderer, resources->font, &resources->glyphs);
     }
-    resources->font = load_font(exe_dir, "resources/COOPBL.ttf", font_size);
+    TRACE_END(span, "refresh_font");
 }
 
 /**
@@ -101,22 +273,44 @@ void refresh_font(const char *exe_dir, resources_t *resources, int font_size) {
  * \param resources Les ressources
  */
 void clean_resources(resources_t *resources) {
+    stop_audio(&resources->audio);
     clean_surface(resources->splash_screen_surface);
     clean_texture(resources->splash_screen_texture);
     clean_surface(resources->background_surface);
     clean_texture(resources->background_texture);
+    for (int layer = 0; layer < BACKGROUND_LAYER_COUNT; layer++) {
+        if (resources->background_layer_textures[layer] != NULL) {
+            clean_texture(resources->background_layer_textures[layer]);
+        }
+    }
     clean_surface(resources->spaceship_surface);
-    clean_texture(resources->spaceship_texture);
+    clean_sprite(&resources->spaceship_sprite);
     clean_surface(resources->flame_surface);
-    clean_texture(resources->flame_texture);
+    clean_sprite(&resources->flame_sprite);
     clean_surface(resources->finish_line_surface);
-    clean_texture(resources->finish_line_texture);
+    clean_sprite(&resources->finish_line_sprite);
     clean_surface(resources->meteorite_surface);
-    clean_texture(resources->meteorite_texture);
+    clean_sprite(&resources->meteorite_sprite);
+    for (int i = 0; i < SPACESHIP_BANK_ANGLE_COUNT; i++) {
+        clean_collision_mask(&resources->spaceship_masks[i]);
+    }
+    for (int i = 0; i < METEORITE_ROTATION_COUNT; i++) {
+        clean_collision_mask(&resources->meteorite_masks[i]);
+    }
+    clean_collision_mask(&resources->finish_line_mask);
     clean_sound(resources->splash_screen_sound);
     clean_sound(resources->loss_sound);
     clean_sound(resources->win_sound);
     if (resources->font != NULL) {
         clean_font(resources->font);
+        clean_glyph_cache(&resources->glyphs);
+    }
+    free(resources->particle_vertices);
+    free(resources->particle_colors);
+    free(resources->particle_indices);
+    if (resources->overview_texture != NULL) {
+        clean_texture(resources->overview_texture);
     }
+    // Après les surfaces et les sons, qui peuvent pointer vers l'archive
+    close_archive(&resources->archive);
 }
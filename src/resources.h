@@ -9,8 +9,14 @@
 #ifndef __RESOURCES_H__
 #define __RESOURCES_H__
 
+#include "archive.h"
+#include "audio.h"
+#include "collision.h"
+#include "constants.h"
+#include "particles.h"
 #include "sdl2-light.h"
 #include "sdl2-ttf-light.h"
+#include "sprite.h"
 #include <SDL_mixer.h>
 
 /**
@@ -21,21 +27,37 @@ typedef struct resources_s {
     SDL_Texture *splash_screen_texture;
     SDL_Surface *background_surface;
     SDL_Texture *background_texture;
+    SDL_Texture *background_layer_textures[BACKGROUND_LAYER_COUNT]; /*!< Couches de fond supplémentaires, ou NULL si absentes */
     SDL_Surface *spaceship_surface;
-    SDL_Texture *spaceship_texture;
+    sprite_t spaceship_sprite;
     SDL_Surface *flame_surface;
-    SDL_Texture *flame_texture;
+    sprite_t flame_sprite;
     SDL_Surface *finish_line_surface;
-    SDL_Texture *finish_line_texture;
+    sprite_t finish_line_sprite;
     SDL_Surface *meteorite_surface;
-    SDL_Texture *meteorite_texture;
+    sprite_t meteorite_sprite;
+    collision_mask_t spaceship_masks[SPACESHIP_BANK_ANGLE_COUNT]; /*!< Masques du vaisseau à chaque inclinaison, de la gauche vers la droite */
+    collision_mask_t meteorite_masks[METEORITE_ROTATION_COUNT];   /*!< Masques de la météorite à chaque angle, de -180 à 180 degrés */
+    collision_mask_t finish_line_mask;
     Mix_Chunk *splash_screen_sound;
     Mix_Chunk *loss_sound;
     Mix_Chunk *win_sound;
     TTF_Font *font;
+    int font_size;                 /*!< Taille de la police ouverte */
+    glyph_cache_t glyphs;          /*!< Glyphes de la police, rendus à chaque changement de taille */
+    archive_t archive;             /*!< Archive des ressources, vide si elle n'a pas été trouvée */
+    const char *levels_dir;        /*!< Répertoire d'où lire les niveaux à la place des ressources, ou NULL */
+    audio_t audio;                 /*!< Effets sonores synthétisés et mesure de la latence du son */
+    float *particle_vertices;      /*!< Sommets des quadrilatères des particules, réécrits à chaque dessin */
+    SDL_Color *particle_colors;    /*!< Couleurs des sommets des particules */
+    int *particle_indices;         /*!< Indices des quadrilatères des particules, constants */
+    int max_texture_width;         /*!< Largeur maximale des textures du renderer, 0 si elle n'est pas limitée */
+    int max_texture_height;        /*!< Hauteur maximale des textures du renderer, 0 si elle n'est pas limitée */
+    SDL_Texture *overview_texture; /*!< Carte de densité du niveau, recréée au chargement du niveau si sa taille change, ou NULL */
+    int overview_version;          /*!< Version de la carte chargée dans la texture */
 } resources_t;
 
-void init_mix();
+void init_mix(bool low_latency);
 
 void clean_mix();
 
@@ -47,9 +69,14 @@ void stop_sound(int sound_channel);
 
 void clean_sound(Mix_Chunk *sound);
 
-void init_resources(const char *exe_dir, SDL_Renderer *renderer, resources_t *resources);
+SDL_Texture *load_resource_image(const char *exe_dir, resources_t *resources, SDL_Renderer *renderer, const char *path, SDL_Surface **image_surface_out,
+                                 bool *success);
 
-void refresh_font(const char *exe_dir, resources_t *resources, int font_size);
+Mix_Chunk *load_resource_sound(const char *exe_dir, resources_t *resources, const char *path);
+
+bool init_resources(const char *exe_dir, SDL_Renderer *renderer, resources_t *resources);
+
+void refresh_font(const char *exe_dir, SDL_Renderer *renderer, resources_t *resources, int font_size);
 
 void clean_resources(resources_t *resources);
 
@@ -1,4 +1,5 @@
 #include "sdl2-light.h"
+#include "logger.h"
 #include "utilities.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -13,18 +14,51 @@
  * \return -1 en cas d'erreur, 0 sinon
  */
 int init_sdl(SDL_Window **window, SDL_Renderer **renderer, int width, int height) {
-    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) != 0) {
-        fprintf(stderr, "Erreur initialisation de la SDL : %s\n", SDL_GetError());
+    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_GAMECONTROLLER) != 0) {
+        LOG_ERROR("Erreur initialisation de la SDL : %s", SDL_GetError());
         return -1;
     }
     // SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
     int img_flags = IMG_INIT_JPG | IMG_INIT_PNG;
     if ((IMG_Init(img_flags) & img_flags) != img_flags) {
-        fprintf(stderr, "Erreur initialisation de la IMG : %s\n", IMG_GetError());
+        LOG_ERROR("Erreur initialisation de la IMG : %s", IMG_GetError());
         return -1;
     }
     if (SDL_CreateWindowAndRenderer(width, height, SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI, window, renderer) != 0) {
-        fprintf(stderr, "Erreur lors de la creation de l'image et du renderer : %s\n", SDL_GetError());
+        LOG_ERROR("Erreur lors de la creation de l'image et du renderer : %s", SDL_GetError());
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * \brief La fonction initialise la SDL sans fenêtre, avec un renderer logiciel qui dessine dans une surface en mémoire.
+ * L'audio utilise le pilote factice, pour fonctionner sur une machine sans écran ni carte son.
+ * \param surface la surface dans laquelle le renderer dessine, au format RGBA32 (octets R, G, B, A)
+ * \param renderer le renderer
+ * \param width largeur de la surface
+ * \param height hauteur de la surface
+ * \return -1 en cas d'erreur, 0 sinon
+ */
+int init_sdl_offscreen(SDL_Surface **surface, SDL_Renderer **renderer, int width, int height) {
+    SDL_SetHint(SDL_HINT_AUDIODRIVER, "dummy");
+    if (SDL_Init(SDL_INIT_AUDIO) != 0) {
+        LOG_ERROR("Erreur initialisation de la SDL : %s", SDL_GetError());
+        return -1;
+    }
+    int img_flags = IMG_INIT_JPG | IMG_INIT_PNG;
+    if ((IMG_Init(img_flags) & img_flags) != img_flags) {
+        LOG_ERROR("Erreur initialisation de la IMG : %s", IMG_GetError());
+        return -1;
+    }
+    *surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32);
+    if (*surface == NULL) {
+        LOG_ERROR("Erreur lors de la creation de la surface : %s", SDL_GetError());
+        return -1;
+    }
+    *renderer = SDL_CreateSoftwareRenderer(*surface);
+    if (*renderer == NULL) {
+        LOG_ERROR("Erreur lors de la creation du renderer logiciel : %s", SDL_GetError());
         return -1;
     }
     return 0;
@@ -46,9 +80,9 @@ SDL_Texture *load_image(SDL_Renderer *renderer, const char *exe_path, const char
         if (success) {
             *success = false;
         } else {
-            fprintf(stderr, "Erreur pendant chargement image : %s\n", IMG_GetError());
-            free(full_path);
+            LOG_ERROR("Erreur pendant chargement image : %s", IMG_GetError());
         }
+        free(full_path);
         return NULL;
     }
     SDL_Surface *converted_image_surface = SDL_ConvertSurfaceFormat(image_surface, SDL_PIXELFORMAT_RGBA8888, 0);
@@ -57,9 +91,9 @@ SDL_Texture *load_image(SDL_Renderer *renderer, const char *exe_path, const char
         if (success) {
             *success = false;
         } else {
-            fprintf(stderr, "Impossible d'optimiser l'image! Erreur SDL : %s\n", SDL_GetError());
-            free(full_path);
+            LOG_ERROR("Impossible d'optimiser l'image! Erreur SDL : %s", SDL_GetError());
         }
+        free(full_path);
         return NULL;
     }
     SDL_Texture *texture = renderer == NULL ? NULL : SDL_CreateTextureFromSurface(renderer, converted_image_surface);
@@ -72,9 +106,9 @@ SDL_Texture *load_image(SDL_Renderer *renderer, const char *exe_path, const char
         if (success) {
             *success = false;
         } else {
-            fprintf(stderr, "Erreur pendant creation de la texture liee a l'image chargee : %s\n", SDL_GetError());
-            free(full_path);
+            LOG_ERROR("Erreur pendant creation de la texture liee a l'image chargee : %s", SDL_GetError());
         }
+        free(full_path);
         return NULL;
     }
     free(full_path);
@@ -86,7 +120,7 @@ SDL_Texture *load_image(SDL_Renderer *renderer, const char *exe_path, const char
 
 Uint32 get_pixel_RGBA32(SDL_Surface *surface, size_t x, size_t y) {
     if (!surface || surface->format->BitsPerPixel != 32 || x >= (size_t)surface->w || y >= (size_t)surface->h) {
-        fprintf(stderr, "get_pixel_RGBA8888: paramètre invalide ou hors bornes (%p, %zu, %zu)\n", (void *)surface, x, y);
+        LOG_ERROR("get_pixel_RGBA8888: paramètre invalide ou hors bornes (%p, %zu, %zu)", (void *)surface, x, y);
         return 0;
     }
     return ((Uint32 *)surface->pixels)[y * surface->pitch / 4 + x];
@@ -11,6 +11,8 @@ SDL_Texture *load_image(SDL_Renderer *renderer, const char *exe_path, const char
 
 int init_sdl(SDL_Window **window, SDL_Renderer **renderer, int width, int height);
 
+int init_sdl_offscreen(SDL_Surface **surface, SDL_Renderer **renderer, int width, int height);
+
 Uint32 get_pixel_RGBA32(SDL_Surface *surface, size_t x, size_t y);
 
 void clean_surface(SDL_Surface *surface);
@@ -33,31 +33,72 @@ TTF_Font *load_font(const char *exe_path, const char *path, int font_size) {
 }
 
 /**
- * \brief La fonction applique un texte dans une certaine police sur le renderer à une certaine position et avec une certaine dimension
+ * \brief La fonction rend chaque caractère imprimable d'une police dans sa propre texture
+ * \param renderer le renderer
+ * \param font la police
+ * \param glyphs le cache à remplir, vide ou déjà nettoyé
+ */
+void build_glyph_cache(SDL_Renderer *renderer, TTF_Font *font, glyph_cache_t *glyphs) {
+    SDL_Color color = {230, 212, 175, 255};
+    glyphs->height = TTF_FontHeight(font);
+    for (int c = GLYPH_FIRST; c <= GLYPH_LAST; c++) {
+        char text[2] = {c, '\0'};
+        SDL_Surface *surface = TTF_RenderText_Blended(font, text, color);
+        glyphs->textures[c - GLYPH_FIRST] = surface != NULL ? SDL_CreateTextureFromSurface(renderer, surface) : NULL;
+        if (surface != NULL) {
+            glyphs->widths[c - GLYPH_FIRST] = surface->w;
+            SDL_FreeSurface(surface);
+        } else {
+            TTF_SizeText(font, text, &glyphs->widths[c - GLYPH_FIRST], NULL);
+        }
+    }
+}
+
+/**
+ * \brief La fonction applique un texte sur le renderer à une certaine position, glyphe par glyphe depuis le cache. Les caractères absents du
+ * cache sont ignorés.
  * \param renderer le renderer
  * \param x abscisse du centre
  * \param y son abscisse
  * \param center centrer
- * \param font la police
+ * \param glyphs les glyphes de la police
  * \param text le texte à afficher
  */
-void draw_text(SDL_Renderer *renderer, double x, double y, bool center, TTF_Font *font, const char *text) {
-    SDL_Color color = {230, 212, 175, 255};
-    SDL_Surface *surface = TTF_RenderText_Blended(font, text, color);
-
-    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_FreeSurface(surface);
-    int w;
-    int h;
-    SDL_QueryTexture(texture, NULL, NULL, &w, &h);
-    SDL_FRect sdl_rect;
+void draw_text(SDL_Renderer *renderer, double x, double y, bool center, const glyph_cache_t *glyphs, const char *text) {
+    int w = 0;
+    for (const char *c = text; *c != '\0'; c++) {
+        if (*c >= GLYPH_FIRST && *c <= GLYPH_LAST) {
+            w += glyphs->widths[*c - GLYPH_FIRST];
+        }
+    }
     if (center) {
-        sdl_rect = (SDL_FRect){x - (double)w / 2, y - (double)h / 2, w, h};
-    } else {
-        sdl_rect = (SDL_FRect){x, y, w, h};
+        x -= (double)w / 2;
+        y -= (double)glyphs->height / 2;
+    }
+    for (const char *c = text; *c != '\0'; c++) {
+        if (*c < GLYPH_FIRST || *c > GLYPH_LAST) {
+            continue;
+        }
+        int glyph = *c - GLYPH_FIRST;
+        if (glyphs->textures[glyph] != NULL) {
+            SDL_FRect sdl_rect = {x, y, glyphs->widths[glyph], glyphs->height};
+            SDL_RenderCopyF(renderer, glyphs->textures[glyph], NULL, &sdl_rect);
+        }
+        x += glyphs->widths[glyph];
+    }
+}
+
+/**
+ * \brief La fonction libère les textures du cache de glyphes
+ * \param glyphs le cache
+ */
+void clean_glyph_cache(glyph_cache_t *glyphs) {
+    for (int glyph = 0; glyph <= GLYPH_LAST - GLYPH_FIRST; glyph++) {
+        if (glyphs->textures[glyph] != NULL) {
+            SDL_DestroyTexture(glyphs->textures[glyph]);
+            glyphs->textures[glyph] = NULL;
+        }
     }
-    SDL_RenderCopyF(renderer, texture, NULL, &sdl_rect);
-    SDL_DestroyTexture(texture);
 }
 
 /**
@@ -5,11 +5,34 @@
 #include <SDL2/SDL_ttf.h>
 #include <stdbool.h>
 
+/**
+ * \brief Premier caractère du cache de glyphes
+ */
+#define GLYPH_FIRST ' '
+
+/**
+ * \brief Dernier caractère du cache de glyphes
+ */
+#define GLYPH_LAST '~'
+
+/**
+ * \brief Glyphes d'une police, rendus une fois en textures pour que l'affichage d'un texte n'alloue ni surface ni texture
+ */
+typedef struct glyph_cache_s {
+    SDL_Texture *textures[GLYPH_LAST - GLYPH_FIRST + 1]; /*!< Textures des caractères imprimables ASCII, ou NULL pour un caractère sans pixel */
+    int widths[GLYPH_LAST - GLYPH_FIRST + 1];            /*!< Avancées des caractères */
+    int height;                                          /*!< Hauteur d'une ligne */
+} glyph_cache_t;
+
 void init_ttf();
 
 TTF_Font *load_font(const char *exe_path, const char *path, int font_size);
 
-void draw_text(SDL_Renderer *renderer, double x, double y, bool center, TTF_Font *font, const char *text);
+void build_glyph_cache(SDL_Renderer *renderer, TTF_Font *font, glyph_cache_t *glyphs);
+
+void draw_text(SDL_Renderer *renderer, double x, double y, bool center, const glyph_cache_t *glyphs, const char *text);
+
+void clean_glyph_cache(glyph_cache_t *glyphs);
 
 void clean_font(TTF_Font *font);
 
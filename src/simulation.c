@@ -0,0 +1,169 @@
+/**
+ * \file simulation.c
+ * \brief Fichier contenant le fil d'exécution de la simulation, séparé de l'affichage
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#include "simulation.h"
+#include "allocations.h"
+#include "graphics.h"
+#include "level.h"
+#include "trace.h"
+
+/**
+ * \brief La fonction attend précisément l'échéance de la frame suivante : elle dort jusqu'à une milliseconde avant l'échéance puis attend
+ * activement, pour que les entrées soient échantillonnées à l'échéance et non au réveil imprécis de SDL_Delay
+ * \param step_counter l'instant du début du pas précédent, en ticks de SDL_GetPerformanceCounter
+ */
+static void wait_for_next_frame_precisely(Uint64 step_counter) {
+    Uint64 frequency = SDL_GetPerformanceFrequency();
+    Uint64 deadline = step_counter + frequency / MAX_FPS;
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (deadline > now + frequency / 1000 * 2) {
+        SDL_Delay((deadline - now) * 1000 / frequency - 1);
+    }
+    while (SDL_GetPerformanceCounter() < deadline) {
+    }
+}
+
+/**
+ * \brief La boucle du fil de simulation : évènements, physique, publication d'un instantané, puis attente de la frame suivante
+ * \param data la simulation
+ * \return 0
+ */
+static int simulation_thread(void *data) {
+    simulation_t *simulation = data;
+    world_t *world = simulation->world;
+    int playing_frames = 0; // frames de jeu consécutives du niveau courant, pour la vérification des allocations
+    name_trace_thread("simulation");
+    while (true) {
+        Uint64 step_counter = SDL_GetPerformanceCounter();
+        Uint64 allocations = allocation_count();
+        bool was_playing = world->game_state == GAME_STATE_PLAYING;
+        int level = world->current_level;
+        bool reloaded = false;
+
+        // gestion des évènements
+        begin_input_step(&simulation->input_latency);
+        TRACE_BEGIN(events_span);
+        handle_events(simulation->exe_dir, simulation->resources, world);
+        TRACE_END(events_span, "handle_events");
+
+        // rechargement du niveau courant si son fichier a été modifié
+        if (simulation->level_watcher != NULL && world->game_state == GAME_STATE_PLAYING) {
+            SDL_Surface *level_surface = take_level_update(simulation->level_watcher, world->current_level);
+            if (level_surface != NULL) {
+                if (!reload_level(simulation->resources, world, level_surface)) {
+                    clean_playing_data(world);
+                    world->game_state = GAME_STATE_QUIT;
+                }
+                clean_surface(level_surface);
+                reloaded = true;
+            }
+        }
+
+        // mise à jour des données liée à la physique du monde
+        Uint8 inputs[PLAYER_MAX_COUNT];
+        read_player_inputs(world, inputs);
+        TRACE_BEGIN(update_span);
+        update_data(simulation->exe_dir, simulation->resources, world, inputs);
+        TRACE_END(update_span, "update_data");
+
+        // publication de l'état du monde pour l'affichage
+        TRACE_BEGIN(snapshot_span);
+        snapshot_t *snapshot = begin_snapshot(&simulation->snapshots);
+        capture_snapshot(world, snapshot, SDL_AtomicGet(&simulation->screen_w), SDL_AtomicGet(&simulation->screen_h));
+        TRACE_END(snapshot_span, "capture_snapshot");
+        snapshot->sequence = ++simulation->sequence;
+        snapshot->input_counter = finish_input_step(&simulation->input_latency, snapshot->sequence);
+        publish_snapshot(&simulation->snapshots);
+        if (world->game_state == GAME_STATE_QUIT) {
+            break;
+        }
+
+        // Une fois le niveau lancé, une frame de jeu ne doit plus allouer ; les changements d'état, les rechargements du niveau et les
+        // agrandissements des tableaux de l'instantané le peuvent
+        bool steady = was_playing && world->game_state == GAME_STATE_PLAYING && world->current_level == level && !reloaded && !snapshot->meteorites_grown;
+        playing_frames = steady ? playing_frames + 1 : 0;
+        if (playing_frames > ALLOCATION_CHECK_WARMUP_FRAMES) {
+            expect_no_allocation(allocations, "la simulation");
+        }
+
+        // Sur un écran fixe, la simulation dort jusqu'à la fin de l'écran ou jusqu'à ce que le fil d'affichage reçoive un évènement
+        Uint64 idle_left = simulation->options->no_idle ? 0 : idle_time_left(world);
+        TRACE_BEGIN(wait_span);
+        if (idle_left > 0) {
+            SDL_SemWaitTimeout(simulation->wake, idle_left + 1);
+        } else if (simulation->options->late_input) {
+            wait_for_next_frame_precisely(step_counter);
+        } else {
+            wait_for_next_frame(world);
+        }
+        TRACE_END(wait_span, "wait");
+    }
+    return 0;
+}
+
+/**
+ * \brief La fonction démarre le fil de simulation
+ * \param simulation la simulation
+ * \param exe_dir le chemin de l'exécutable, utilisé pour charger les ressources
+ * \param options les options de la ligne de commande
+ * \param resources les ressources
+ * \param world le monde, qui ne doit plus être accédé par l'appelant jusqu'à l'arrêt de la simulation
+ * \param level_watcher la surveillance des niveaux, ou NULL
+ */
+void start_simulation(simulation_t *simulation, const char *exe_dir, const options_t *options, resources_t *resources, world_t *world,
+                      level_watcher_t *level_watcher) {
+    simulation->exe_dir = exe_dir;
+    simulation->options = options;
+    simulation->resources = resources;
+    simulation->world = world;
+    simulation->level_watcher = level_watcher;
+    init_snapshot_buffer(&simulation->snapshots);
+    SDL_AtomicSet(&simulation->screen_w, 0);
+    SDL_AtomicSet(&simulation->screen_h, 0);
+    simulation->sequence = 0;
+    init_input_latency(&simulation->input_latency);
+    simulation->wake = SDL_CreateSemaphore(0);
+    simulation->thread = SDL_CreateThread(simulation_thread, "simulation", simulation);
+    if (simulation->thread == NULL) {
+        fprintf(stderr, "Erreur lors de la creation du fil de simulation : %s\n", SDL_GetError());
+        exit(1);
+    }
+}
+
+/**
+ * \brief La fonction publie la taille de l'écran, utilisée par la simulation pour choisir les météorites à copier dans les instantanés
+ * \param simulation la simulation
+ * \param screen_w la largeur de l'écran
+ * \param screen_h la hauteur de l'écran
+ */
+void set_simulation_screen_size(simulation_t *simulation, int screen_w, int screen_h) {
+    SDL_AtomicSet(&simulation->screen_w, screen_w);
+    SDL_AtomicSet(&simulation->screen_h, screen_h);
+}
+
+/**
+ * \brief La fonction réveille la simulation si elle dort sur un écran fixe, pour qu'elle traite les évènements reçus
+ * \param simulation la simulation
+ */
+void wake_simulation(simulation_t *simulation) {
+    SDL_SemPost(simulation->wake);
+}
+
+/**
+ * \brief La fonction attend la fin du fil de simulation, affiche les mesures si demandé et libère les instantanés
+ * \param simulation la simulation
+ */
+void stop_simulation(simulation_t *simulation) {
+    SDL_WaitThread(simulation->thread, NULL);
+    SDL_DestroySemaphore(simulation->wake);
+    clean_input_latency(&simulation->input_latency);
+    if (simulation->options->profile) {
+        report_input_latency(&simulation->input_latency, simulation->options->late_input);
+    }
+    clean_snapshot_buffer(&simulation->snapshots);
+}
@@ -0,0 +1,45 @@
+/**
+ * \file simulation.h
+ * \brief Fichier contenant le fil d'exécution de la simulation, séparé de l'affichage
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#ifndef __SIMULATION_H__
+#define __SIMULATION_H__
+
+#include "game.h"
+#include "latency.h"
+#include "options.h"
+#include "snapshot.h"
+#include "watcher.h"
+
+/**
+ * \brief État partagé entre le fil de simulation et le fil d'affichage
+ */
+typedef struct simulation_s {
+    const char *exe_dir;
+    const options_t *options;
+    resources_t *resources;
+    world_t *world;                 /*!< Le monde, accédé uniquement par le fil de simulation une fois celui-ci démarré */
+    level_watcher_t *level_watcher; /*!< Surveillance des niveaux, ou NULL */
+    snapshot_buffer_t snapshots;
+    SDL_atomic_t screen_w; /*!< Taille de l'écran, publiée par le fil d'affichage */
+    SDL_atomic_t screen_h;
+    int sequence;                  /*!< Numéro du dernier instantané publié */
+    input_latency_t input_latency; /*!< Mesure de la latence des entrées */
+    SDL_sem *wake;                 /*!< Réveille la simulation endormie sur un écran fixe */
+    SDL_Thread *thread;
+} simulation_t;
+
+void start_simulation(simulation_t *simulation, const char *exe_dir, const options_t *options, resources_t *resources, world_t *world,
+                      level_watcher_t *level_watcher);
+
+void set_simulation_screen_size(simulation_t *simulation, int screen_w, int screen_h);
+
+void wake_simulation(simulation_t *simulation);
+
+void stop_simulation(simulation_t *simulation);
+
+#endif
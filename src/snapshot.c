@@ -0,0 +1,336 @@
+/**
+ * \file snapshot.c
+ * \brief Fichier contenant les instantanés du monde transmis de la simulation à l'affichage
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#include "snapshot.h"
+#include "graphics.h"
+#include "logger.h"
+#include "utilities.h"
+
+/**
+ * \brief Bit indiquant que le tampon du milieu contient un instantané pas encore lu
+ */
+#define SNAPSHOT_FRESH 4
+
+/**
+ * \brief Masque de l'indice de tampon
+ */
+#define SNAPSHOT_INDEX_MASK 3
+
+/**
+ * \brief La fonction alloue les tableaux des particules d'un instantané, à la capacité des réserves. Si la mémoire manque, ils restent à
+ * NULL et l'instantané ne copie aucune particule.
+ * \param snapshot l'instantané
+ */
+static void alloc_snapshot_particles(snapshot_t *snapshot) {
+    float *storage = malloc(sizeof(float) * 3 * PARTICLE_KIND_COUNT * PARTICLE_CAPACITY);
+    if (storage == NULL) {
+        LOG_ERROR("Mémoire insuffisante pour copier les particules");
+        return;
+    }
+    for (int kind = 0; kind < PARTICLE_KIND_COUNT; kind++) {
+        snapshot->particle_x[kind] = storage + (size_t)kind * 3 * PARTICLE_CAPACITY;
+        snapshot->particle_y[kind] = snapshot->particle_x[kind] + PARTICLE_CAPACITY;
+        snapshot->particle_life[kind] = snapshot->particle_x[kind] + PARTICLE_CAPACITY * 2;
+    }
+}
+
+/**
+ * \brief La fonction initialise le triple tampon avec des instantanés vides
+ * \param buffer le triple tampon
+ */
+void init_snapshot_buffer(snapshot_buffer_t *buffer) {
+    for (int i = 0; i < 3; i++) {
+        buffer->snapshots[i] = (snapshot_t){.game_state = GAME_STATE_STARTED};
+        alloc_snapshot_particles(&buffer->snapshots[i]);
+    }
+    buffer->back = 0;
+    SDL_AtomicSet(&buffer->middle, 1);
+    buffer->front = 2;
+}
+
+/**
+ * \brief La fonction donne l'instantané à remplir par le producteur
+ * \param buffer le triple tampon
+ * \return l'instantané arrière
+ */
+snapshot_t *begin_snapshot(snapshot_buffer_t *buffer) {
+    return &buffer->snapshots[buffer->back];
+}
+
+/**
+ * \brief La fonction publie l'instantané arrière, qui devient le plus récent disponible pour le consommateur
+ * \param buffer le triple tampon
+ */
+void publish_snapshot(snapshot_buffer_t *buffer) {
+    int previous = SDL_AtomicSet(&buffer->middle, buffer->back | SNAPSHOT_FRESH);
+    buffer->back = previous & SNAPSHOT_INDEX_MASK;
+}
+
+/**
+ * \brief La fonction donne l'instantané le plus récent au consommateur
+ * \param buffer le triple tampon
+ * \param fresh si non NULL, mis à true si l'instantané n'avait pas encore été lu
+ * \return l'instantané avant, valide jusqu'au prochain appel
+ */
+const snapshot_t *acquire_snapshot(snapshot_buffer_t *buffer, bool *fresh) {
+    bool is_fresh = (SDL_AtomicGet(&buffer->middle) & SNAPSHOT_FRESH) != 0;
+    if (is_fresh) {
+        int previous = SDL_AtomicSet(&buffer->middle, buffer->front);
+        buffer->front = previous & SNAPSHOT_INDEX_MASK;
+    }
+    if (fresh != NULL) {
+        *fresh = is_fresh;
+    }
+    return &buffer->snapshots[buffer->front];
+}
+
+/**
+ * \brief La fonction calcule les bandes verticales du niveau vues par les joueurs, chacun dans sa partie de l'écran. Les bandes sont triées puis
+ * fusionnées lorsqu'elles se chevauchent, pour que les objets vus par plusieurs joueurs ne soient copiés qu'une fois.
+ * \param world les données du monde
+ * \param screen_w la largeur de l'écran
+ * \param screen_h la hauteur de l'écran
+ * \param margin la marge ajoutée autour de chaque vue, en unités du niveau
+ * \param detail indique que seuls les objets dessinés un à un comptent : dans la vue d'ensemble, la bande se réduit alors aux abords du vaisseau
+ * \param min_y les débuts des bandes, PLAYER_MAX_COUNT emplacements
+ * \param max_y les fins des bandes, PLAYER_MAX_COUNT emplacements
+ * \param half_view_width la plus grande demi-largeur vue, marge comprise
+ * \return le nombre de bandes
+ */
+static int player_view_ranges(const world_t *world, double screen_w, double screen_h, double margin, bool detail, double *min_y, double *max_y,
+                              double *half_view_width) {
+    int count = 0;
+    *half_view_width = 0.0;
+    for (int p = 0; p < world->player_count; p++) {
+        SDL_Rect viewport = player_viewport(p, world->player_count, screen_w, screen_h);
+        double scale = camera_scale(viewport.w, viewport.h, world->level_width, world->zoom);
+        double center_y = -world->camera_offset[p], half_view_height = viewport.h / 2.0 / scale + margin;
+        *half_view_width = MAX(*half_view_width, viewport.w / 2.0 / scale + margin);
+        if (detail && meteorite_sprite_fade(scale) == 0.0) {
+            // Le reste de la vue est couvert par la carte de densité : le nombre d'objets copiés ne dépend plus du zoom
+            center_y = world->spaceship_y[p];
+            half_view_height = OVERVIEW_DETAIL_RADIUS + margin;
+        }
+        double range_min = center_y - half_view_height, range_max = center_y + half_view_height;
+        int i = count++;
+        while (i > 0 && min_y[i - 1] > range_min) {
+            min_y[i] = min_y[i - 1];
+            max_y[i] = max_y[i - 1];
+            i--;
+        }
+        min_y[i] = range_min;
+        max_y[i] = range_max;
+    }
+    int merged = 0;
+    for (int i = 0; i < count; i++) {
+        if (merged > 0 && min_y[i] <= max_y[merged - 1]) {
+            max_y[merged - 1] = MAX(max_y[merged - 1], max_y[i]);
+        } else {
+            min_y[merged] = min_y[i];
+            max_y[merged] = max_y[i];
+            merged++;
+        }
+    }
+    return merged;
+}
+
+/**
+ * \brief La fonction copie les particules visibles à l'écran, bande par bande. Les tableaux d'un instantané qui n'en a pas encore sont alloués
+ * ici.
+ * \param world les données du monde
+ * \param snapshot l'instantané à remplir
+ * \param screen_w la largeur de l'écran
+ * \param screen_h la hauteur de l'écran
+ */
+static void capture_particles(world_t *world, snapshot_t *snapshot, double screen_w, double screen_h) {
+    if (snapshot->particle_x[0] == NULL) {
+        alloc_snapshot_particles(snapshot);
+        if (snapshot->particle_x[0] == NULL) {
+            return;
+        }
+    }
+    double min_y[PLAYER_MAX_COUNT], max_y[PLAYER_MAX_COUNT], half_view_width;
+    int range_count = player_view_ranges(world, screen_w, screen_h, PARTICLE_SIZE, false, min_y, max_y, &half_view_width);
+    for (int kind = 0; kind < PARTICLE_KIND_COUNT; kind++) {
+        const particle_pool_t *pool = &world->particles.pools[kind];
+        // Les bandes étant disjointes, une particule n'est copiée qu'une fois et la capacité des tableaux suffit
+        size_t count = 0;
+        for (int r = 0; r < range_count; r++) {
+            count += copy_visible_particles(pool, -half_view_width, half_view_width, min_y[r], max_y[r], snapshot->particle_x[kind] + count,
+                                            snapshot->particle_y[kind] + count, snapshot->particle_life[kind] + count);
+        }
+        snapshot->particle_count[kind] = count;
+        world->particles.culled += pool->count - count;
+    }
+}
+
+/**
+ * \brief La fonction copie la carte de densité du niveau si elle a changé depuis la dernière copie dans cet instantané. Le tableau n'est
+ * agrandi qu'au changement de niveau.
+ * \param world les données du monde
+ * \param snapshot l'instantané à remplir
+ */
+static void capture_overview(const world_t *world, snapshot_t *snapshot) {
+    const overview_t *overview = &world->overview;
+    if (snapshot->overview_version == overview->version) {
+        return;
+    }
+    size_t size = sizeof(Uint32) * overview->width * overview->height;
+    if (size > snapshot->overview_capacity) {
+        free(snapshot->overview_counts);
+        snapshot->overview_counts = malloc(size);
+        snapshot->overview_capacity = snapshot->overview_counts != NULL ? size : 0;
+        if (snapshot->overview_counts == NULL) {
+            // Sans copie, la vue d'ensemble ne dessine pas la carte
+            return;
+        }
+    }
+    memcpy(snapshot->overview_counts, overview->counts, size);
+    snapshot->overview_width = overview->width;
+    snapshot->overview_height = overview->height;
+    snapshot->overview_block = overview->block;
+    snapshot->overview_version = overview->version;
+}
+
+/**
+ * \brief La fonction copie l'état du monde dans un instantané, y compris les météorites visibles à l'écran
+ * \param world les données du monde
+ * \param snapshot l'instantané à remplir
+ * \param screen_w la largeur de l'écran
+ * \param screen_h la hauteur de l'écran
+ */
+void capture_snapshot(world_t *world, snapshot_t *snapshot, double screen_w, double screen_h) {
+    snapshot->game_state = world->game_state;
+    snapshot->playing_time = world->playing_time;
+    snapshot->current_level = world->current_level;
+    snapshot->level_width = world->level_width;
+    snapshot->level_height = world->level_height;
+    snapshot->zoom = world->zoom;
+    snapshot->player_count = world->player_count;
+    for (int p = 0; p < world->player_count; p++) {
+        snapshot->camera_offset[p] = world->camera_offset[p];
+        snapshot->spaceship_speed_x[p] = world->spaceship_speed_x[p];
+        snapshot->spaceship_speed_y[p] = world->spaceship_speed_y[p];
+        snapshot->spaceship_rect[p] = spaceship_rect(world, p);
+        snapshot->spaceship_angle[p] = spaceship_bank_angle(world->spaceship_speed_x[p]);
+        snapshot->player_state[p] = world->player_state[p];
+        snapshot->finish_time[p] = world->finish_time[p];
+        snapshot->near_misses[p] = world->near_misses[p];
+    }
+    snapshot->finish_line_rect = world->finish_line_rect;
+    snapshot->invincible = world->invincible;
+    snapshot->has_won = world->has_won;
+    const record_t *best = best_record(world->records, world->current_level);
+    snapshot->split = world->game_state == GAME_STATE_PLAYING && best != NULL && world->split_count > 0 ? world->split_count - 1 : -1;
+    snapshot->split_delta = snapshot->split >= 0 ? (Sint64)world->splits[snapshot->split] - (Sint64)best->splits[snapshot->split] : 0;
+    snapshot->best_time = world->best_time;
+    snapshot->new_best = world->new_best;
+    snapshot->idle_time_left = idle_time_left(world);
+    snapshot->idle = snapshot->idle_time_left > 0;
+    snapshot->meteorites_count = 0;
+    snapshot->meteorites_grown = false;
+    snapshot->ghost_count = 0;
+    for (int kind = 0; kind < PARTICLE_KIND_COUNT; kind++) {
+        snapshot->particle_count[kind] = 0;
+    }
+
+    if (screen_w <= 0.0 || screen_h <= 0.0) {
+        return;
+    }
+    // Les particules restent visibles sur les écrans de fin de niveau et de fin de partie
+    if (world->game_state == GAME_STATE_PLAYING || world->game_state == GAME_STATE_LEVEL_COMPLETE_SCREEN || world->game_state == GAME_STATE_END_SCREEN) {
+        capture_particles(world, snapshot, screen_w, screen_h);
+    }
+    if (world->game_state != GAME_STATE_PLAYING) {
+        return;
+    }
+    capture_overview(world, snapshot);
+
+    for (int g = 0; g < world->ghosts.count; g++) {
+        if (world->ghosts.state[g] == GHOST_RACING) {
+            snapshot->ghost_x[snapshot->ghost_count] = world->ghosts.x[g];
+            snapshot->ghost_y[snapshot->ghost_count] = world->ghosts.y[g];
+            snapshot->ghost_angle[snapshot->ghost_count] = spaceship_bank_angle(world->ghosts.speed_x[g]);
+            snapshot->ghost_count++;
+        }
+    }
+
+    double min_y[PLAYER_MAX_COUNT], max_y[PLAYER_MAX_COUNT], half_view_width;
+    int range_count = player_view_ranges(world, screen_w, screen_h, 0.0, true, min_y, max_y, &half_view_width);
+    meteorites_t *meteorites = &world->meteorites;
+
+    // Les groupes n'occupent pas des emplacements contigus : ils sont comptés puis copiés un par un. Un groupe à cheval sur deux bandes n'est
+    // copié qu'avec la première.
+    size_t first_chunks[PLAYER_MAX_COUNT], last_chunks[PLAYER_MAX_COUNT], count = 0, next_chunk = 0;
+    for (int r = 0; r < range_count; r++) {
+        update_meteorites(meteorites, meteorite_time(world), min_y[r], max_y[r], world->level_width);
+        first_chunks[r] = last_chunks[r] = MAX(find_meteorite_chunk(meteorites, min_y[r]), next_chunk);
+        while (last_chunks[r] < meteorites->chunk_count && meteorites->chunks[last_chunks[r]].min_y <= max_y[r]) {
+            count += meteorites->chunks[last_chunks[r]].end - meteorites->chunks[last_chunks[r]].start;
+            last_chunks[r]++;
+        }
+        next_chunk = MAX(next_chunk, last_chunks[r]);
+    }
+
+    snapshot->meteorites_grown = count > snapshot->meteorites_capacity;
+    if (snapshot->meteorites_grown) {
+        // Agrandissement géométrique : seules les météorites visibles sont copiées, et leur nombre se stabilise vite
+        size_t capacity = MAX(count, snapshot->meteorites_capacity * 2);
+        free(snapshot->meteorite_x);
+        snapshot->meteorite_x = malloc(sizeof(double) * 3 * capacity);
+        snapshot->meteorites_capacity = snapshot->meteorite_x != NULL ? capacity : 0;
+        if (snapshot->meteorite_x == NULL) {
+            // Sans copie, aucune météorite n'est dessinée
+            LOG_ERROR("Mémoire insuffisante pour copier %zu météorites visibles", count);
+            return;
+        }
+        snapshot->meteorite_y = snapshot->meteorite_x + capacity;
+        snapshot->meteorite_angle = snapshot->meteorite_x + capacity * 2;
+    }
+    for (int r = 0; r < range_count; r++) {
+        for (size_t c = first_chunks[r]; c < last_chunks[r]; c++) {
+            size_t start = meteorites->chunks[c].start, length = meteorites->chunks[c].end - start, offset = snapshot->meteorites_count;
+            memcpy(snapshot->meteorite_x + offset, meteorites->x + start, sizeof(double) * length);
+            memcpy(snapshot->meteorite_y + offset, meteorites->y + start, sizeof(double) * length);
+            memcpy(snapshot->meteorite_angle + offset, meteorites->angle + start, sizeof(double) * length);
+            snapshot->meteorites_count += length;
+        }
+    }
+}
+
+/**
+ * \brief La fonction libère les météorites copiées dans un instantané
+ * \param snapshot l'instantané
+ */
+void clean_snapshot(snapshot_t *snapshot) {
+    free(snapshot->meteorite_x);
+    snapshot->meteorite_x = NULL;
+    snapshot->meteorites_count = 0;
+    snapshot->meteorites_capacity = 0;
+    free(snapshot->overview_counts);
+    snapshot->overview_counts = NULL;
+    snapshot->overview_capacity = 0;
+    snapshot->overview_version = 0;
+    free(snapshot->particle_x[0]);
+    for (int kind = 0; kind < PARTICLE_KIND_COUNT; kind++) {
+        snapshot->particle_count[kind] = 0;
+        snapshot->particle_x[kind] = NULL;
+        snapshot->particle_y[kind] = NULL;
+        snapshot->particle_life[kind] = NULL;
+    }
+}
+
+/**
+ * \brief La fonction libère les instantanés du triple tampon
+ * \param buffer le triple tampon
+ */
+void clean_snapshot_buffer(snapshot_buffer_t *buffer) {
+    for (int i = 0; i < 3; i++) {
+        clean_snapshot(&buffer->snapshots[i]);
+    }
+}
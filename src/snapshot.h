@@ -0,0 +1,93 @@
+/**
+ * \file snapshot.h
+ * \brief Fichier contenant les instantanés du monde transmis de la simulation à l'affichage
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#ifndef __SNAPSHOT_H__
+#define __SNAPSHOT_H__
+
+#include "game.h"
+
+/**
+ * \brief Instantané immuable de tout ce que l'affichage lit du monde
+ */
+typedef struct snapshot_s {
+    int sequence;         /*!< Numéro de l'instantané */
+    Uint64 input_counter; /*!< Horodatage du plus ancien évènement clavier pris en compte et pas encore affiché, ou 0 */
+    game_state_t game_state;
+    Uint64 playing_time;
+    bool idle;             /*!< Indique que l'image reste fixe jusqu'à la fin de l'écran courant */
+    Uint64 idle_time_left; /*!< Temps restant avant la fin de l'écran courant, en ms, si l'image est fixe */
+    int current_level;
+    double level_width;
+    double level_height;
+    double zoom; /*!< Zoom de la vue, 1 au zoom normal, plus petit dans la vue d'ensemble */
+    int player_count;
+    double camera_offset[PLAYER_MAX_COUNT];
+    double spaceship_speed_x[PLAYER_MAX_COUNT];
+    double spaceship_speed_y[PLAYER_MAX_COUNT];
+    rect_t spaceship_rect[PLAYER_MAX_COUNT];
+    double spaceship_angle[PLAYER_MAX_COUNT]; /*!< Inclinaisons des vaisseaux, en degrés dans le sens horaire */
+    Uint8 player_state[PLAYER_MAX_COUNT];
+    Uint64 finish_time[PLAYER_MAX_COUNT];
+    int near_misses[PLAYER_MAX_COUNT];
+    rect_t finish_line_rect;
+    bool invincible;
+    bool has_won;
+    int split;          /*!< Dernier temps de passage atteint, comparé au record, ou -1 */
+    Sint64 split_delta; /*!< Écart au temps de passage du record, en ms */
+    Uint64 best_time;   /*!< Record du dernier niveau terminé, en ms, ou 0 */
+    bool new_best;
+    size_t meteorites_count;    /*!< Nombre de météorites visibles copiées, dans l'une au moins des vues des joueurs */
+    size_t meteorites_capacity; /*!< Capacité des tableaux de météorites */
+    bool meteorites_grown;      /*!< Indique que cet instantané a agrandi les tableaux de météorites, ce qui relance la vérification des allocations */
+    double *meteorite_x;
+    double *meteorite_y;
+    double *meteorite_angle;
+    int ghost_count; /*!< Nombre de fantômes en course copiés */
+    double ghost_x[GHOST_MAX_COUNT];
+    double ghost_y[GHOST_MAX_COUNT];
+    double ghost_angle[GHOST_MAX_COUNT];
+    int overview_version;                       /*!< Version de la carte de densité copiée, 0 si aucune */
+    int overview_width;                         /*!< Largeur de la carte, en texels */
+    int overview_height;                        /*!< Hauteur de la carte, en texels */
+    int overview_block;                         /*!< Côté d'un bloc de cases résumé par un texel */
+    size_t overview_capacity;                   /*!< Capacité du tableau de la carte */
+    Uint32 *overview_counts;                    /*!< Carte de densité, recopiée uniquement quand sa version change */
+    size_t particle_count[PARTICLE_KIND_COUNT]; /*!< Nombre de particules visibles copiées, par sorte */
+    float *particle_x[PARTICLE_KIND_COUNT];     /*!< Particules visibles, PARTICLE_CAPACITY emplacements par sorte */
+    float *particle_y[PARTICLE_KIND_COUNT];
+    float *particle_life[PARTICLE_KIND_COUNT]; /*!< Vies restantes, de 1 à 0 */
+} snapshot_t;
+
+/**
+ * \brief Triple tampon d'instantanés, sans verrou, avec un seul producteur et un seul consommateur
+ *
+ * Le producteur écrit dans le tampon arrière puis l'échange avec le tampon du milieu. Le consommateur échange le tampon avant avec celui du milieu
+ * lorsque ce dernier est marqué comme nouveau. Aucun des deux n'attend jamais l'autre.
+ */
+typedef struct snapshot_buffer_s {
+    snapshot_t snapshots[3];
+    int back;            /*!< Indice du tampon arrière, propriété du producteur */
+    SDL_atomic_t middle; /*!< Indice du tampon du milieu, avec le bit SNAPSHOT_FRESH */
+    int front;           /*!< Indice du tampon avant, propriété du consommateur */
+} snapshot_buffer_t;
+
+void init_snapshot_buffer(snapshot_buffer_t *buffer);
+
+snapshot_t *begin_snapshot(snapshot_buffer_t *buffer);
+
+void publish_snapshot(snapshot_buffer_t *buffer);
+
+const snapshot_t *acquire_snapshot(snapshot_buffer_t *buffer, bool *fresh);
+
+void capture_snapshot(world_t *world, snapshot_t *snapshot, double screen_w, double screen_h);
+
+void clean_snapshot(snapshot_t *snapshot);
+
+void clean_snapshot_buffer(snapshot_buffer_t *buffer);
+
+#endif
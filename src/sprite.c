@@ -0,0 +1,142 @@
+/**
+ * \file sprite.c
+ * \brief Fichier contenant les sprites, images accompagnées de versions réduites choisies selon leur taille à l'écran
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#include "sprite.h"
+#include "parallel.h"
+#include "sdl2-light.h"
+#include "utilities.h"
+
+/**
+ * \brief Nombre minimal de pixels réduits par fil de calcul
+ */
+#define SPRITE_PIXELS_PER_THREAD 65536
+
+/**
+ * \brief Réduction d'une image de moitié
+ */
+typedef struct sprite_reduction_s {
+    SDL_Surface *source;
+    SDL_Surface *destination;
+} sprite_reduction_t;
+
+/**
+ * \brief La fonction réduit une plage de lignes. Chaque pixel est la moyenne d'un bloc de 2x2 pixels de la source, les couleurs étant pondérées
+ * par leur opacité pour que les bords transparents ne noircissent pas l'image.
+ * \param data la réduction
+ * \param thread le numéro du fil de calcul
+ * \param first la première ligne
+ * \param last la ligne suivant la dernière
+ */
+static void reduce_rows(void *data, int thread, int first, int last) {
+    (void)thread;
+    sprite_reduction_t *reduction = data;
+    SDL_Surface *source = reduction->source, *destination = reduction->destination;
+    for (int y = first; y < last; y++) {
+        Uint32 *row = (Uint32 *)((Uint8 *)destination->pixels + (size_t)y * destination->pitch);
+        for (int x = 0; x < destination->w; x++) {
+            Uint32 red = 0, green = 0, blue = 0, alpha = 0;
+            for (int dy = 0; dy < 2; dy++) {
+                for (int dx = 0; dx < 2; dx++) {
+                    // Pixels RGBA8888 : le rouge dans l'octet de poids fort, l'opacité dans celui de poids faible
+                    Uint32 pixel = get_pixel_RGBA32(source, MIN(x * 2 + dx, source->w - 1), MIN(y * 2 + dy, source->h - 1));
+                    Uint32 pixel_alpha = pixel & 0xFF;
+                    red += (pixel >> 24) * pixel_alpha;
+                    green += ((pixel >> 16) & 0xFF) * pixel_alpha;
+                    blue += ((pixel >> 8) & 0xFF) * pixel_alpha;
+                    alpha += pixel_alpha;
+                }
+            }
+            if (alpha == 0) {
+                row[x] = 0;
+            } else {
+                row[x] = (red + alpha / 2) / alpha << 24 | (green + alpha / 2) / alpha << 16 | (blue + alpha / 2) / alpha << 8 | (alpha + 2) / 4;
+            }
+        }
+    }
+}
+
+/**
+ * \brief La fonction construit un sprite à partir d'une image et de sa texture : les versions réduites sont calculées en parallèle, jusqu'à
+ * SPRITE_MIN_SIZE pixels, puis envoyées au renderer. Elles couvrent toutes les tailles d'écran, si bien qu'un redimensionnement de la fenêtre
+ * ne demande aucun nouveau calcul.
+ * \param renderer le renderer, ou NULL pour ne garder que l'image d'origine
+ * \param surface l'image, au format RGBA8888
+ * \param texture la texture de l'image, qui appartient désormais au sprite
+ * \param sprite le sprite, à libérer avec clean_sprite
+ */
+void build_sprite(SDL_Renderer *renderer, SDL_Surface *surface, SDL_Texture *texture, sprite_t *sprite) {
+    sprite->level_count = 1;
+    sprite->textures[0] = texture;
+    sprite->widths[0] = surface->w;
+    sprite->heights[0] = surface->h;
+    if (renderer == NULL) {
+        return;
+    }
+    SDL_Surface *source = surface;
+    while (sprite->level_count < SPRITE_MAX_LEVELS && source->w / 2 >= SPRITE_MIN_SIZE && source->h / 2 >= SPRITE_MIN_SIZE) {
+        SDL_Surface *destination = SDL_CreateRGBSurfaceWithFormat(0, source->w / 2, source->h / 2, 32, SDL_PIXELFORMAT_RGBA8888);
+        if (destination == NULL) {
+            break;
+        }
+        sprite_reduction_t reduction = {source, destination};
+        run_parallel(destination->h, parallel_thread_count((size_t)destination->w * destination->h, SPRITE_PIXELS_PER_THREAD), reduce_rows,
+                     &reduction);
+        SDL_Texture *level_texture = SDL_CreateTextureFromSurface(renderer, destination);
+        if (source != surface) {
+            SDL_FreeSurface(source);
+        }
+        source = destination;
+        if (level_texture == NULL) {
+            break;
+        }
+        sprite->textures[sprite->level_count] = level_texture;
+        sprite->widths[sprite->level_count] = destination->w;
+        sprite->heights[sprite->level_count] = destination->h;
+        sprite->level_count++;
+    }
+    if (source != surface) {
+        SDL_FreeSurface(source);
+    }
+}
+
+/**
+ * \brief La fonction choisit la plus petite version du sprite qui couvre encore sa taille à l'écran, pour ne jamais l'agrandir
+ * \param sprite le sprite
+ * \param w la largeur à l'écran, en pixels
+ * \param h la hauteur à l'écran, en pixels
+ * \return la texture
+ */
+SDL_Texture *sprite_texture(const sprite_t *sprite, double w, double h) {
+    int level = 0;
+    while (level + 1 < sprite->level_count && sprite->widths[level + 1] >= w && sprite->heights[level + 1] >= h) {
+        level++;
+    }
+    return sprite->textures[level];
+}
+
+/**
+ * \brief La fonction règle l'opacité de toutes les versions du sprite
+ * \param sprite le sprite
+ * \param alpha l'opacité
+ */
+void set_sprite_alpha_mod(const sprite_t *sprite, Uint8 alpha) {
+    for (int level = 0; level < sprite->level_count; level++) {
+        SDL_SetTextureAlphaMod(sprite->textures[level], alpha);
+    }
+}
+
+/**
+ * \brief La fonction libère les textures du sprite
+ * \param sprite le sprite
+ */
+void clean_sprite(sprite_t *sprite) {
+    for (int level = 0; level < sprite->level_count; level++) {
+        clean_texture(sprite->textures[level]);
+    }
+    sprite->level_count = 0;
+}
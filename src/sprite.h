@@ -0,0 +1,42 @@
+/**
+ * \file sprite.h
+ * \brief Fichier contenant les sprites, images accompagnées de versions réduites choisies selon leur taille à l'écran
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#ifndef __SPRITE_H__
+#define __SPRITE_H__
+
+#include <SDL.h>
+
+/**
+ * \brief Nombre maximal de niveaux de réduction d'un sprite, image d'origine comprise
+ */
+#define SPRITE_MAX_LEVELS 8
+
+/**
+ * \brief Taille minimale, en pixels, d'un côté d'une version réduite
+ */
+#define SPRITE_MIN_SIZE 16
+
+/**
+ * \brief Sprite : l'image d'origine suivie de versions réduites de moitié à chaque niveau, par moyenne de blocs de 2x2 pixels
+ */
+typedef struct sprite_s {
+    int level_count;
+    SDL_Texture *textures[SPRITE_MAX_LEVELS]; /*!< Textures, de la plus grande à la plus petite */
+    int widths[SPRITE_MAX_LEVELS];
+    int heights[SPRITE_MAX_LEVELS];
+} sprite_t;
+
+void build_sprite(SDL_Renderer *renderer, SDL_Surface *surface, SDL_Texture *texture, sprite_t *sprite);
+
+SDL_Texture *sprite_texture(const sprite_t *sprite, double w, double h);
+
+void set_sprite_alpha_mod(const sprite_t *sprite, Uint8 alpha);
+
+void clean_sprite(sprite_t *sprite);
+
+#endif
@@ -0,0 +1,205 @@
+/**
+ * \file telemetry.c
+ * \brief Fichier contenant l'enregistrement des évènements de partie, écrits sur disque par un fil en arrière-plan
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#include "telemetry.h"
+#include "utilities.h"
+#include <stdlib.h>
+#include <time.h>
+
+/**
+ * \brief Noms des types d'évènements dans les fichiers NDJSON
+ */
+static const char *telemetry_event_names[] = {"level_start", "level_finish", "death", "frame_summary", "invincibility", "near_miss", "retry"};
+
+/**
+ * \brief La fonction construit le chemin d'un fichier
+ * \param telemetry l'enregistrement
+ * \param index le numéro du fichier
+ * \return le chemin, à libérer
+ */
+static char *telemetry_file_path(const telemetry_t *telemetry, int index) {
+    char name[64];
+    sprintf(name, "telemetry_%lld_%03d.%s", telemetry->session, index, telemetry->format == TELEMETRY_FORMAT_NDJSON ? "ndjson" : "bin");
+    return concat_paths(telemetry->directory, name);
+}
+
+/**
+ * \brief La fonction ferme le fichier courant et ouvre le suivant, en supprimant le plus ancien au-delà de TELEMETRY_MAX_FILES
+ * \param telemetry l'enregistrement
+ */
+static void rotate_telemetry_file(telemetry_t *telemetry) {
+    if (telemetry->file != NULL) {
+        fclose(telemetry->file);
+        telemetry->file_index++;
+    }
+    if (telemetry->file_index >= TELEMETRY_MAX_FILES) {
+        char *oldest_path = telemetry_file_path(telemetry, telemetry->file_index - TELEMETRY_MAX_FILES);
+        remove(oldest_path);
+        free(oldest_path);
+    }
+    char *path = telemetry_file_path(telemetry, telemetry->file_index);
+    telemetry->file = fopen(path, "wb");
+    telemetry->file_size = 0;
+    if (telemetry->file == NULL) {
+        fprintf(stderr, "Erreur pendant l'ouverture de %s\n", path);
+    } else if (telemetry->format == TELEMETRY_FORMAT_BINARY) {
+        telemetry_header_t header = {TELEMETRY_MAGIC, sizeof(telemetry_event_t), SDL_GetPerformanceFrequency(), telemetry->start_counter};
+        fwrite(&header, sizeof(header), 1, telemetry->file);
+        telemetry->file_size = sizeof(header);
+    }
+    free(path);
+}
+
+/**
+ * \brief La fonction écrit un évènement dans le fichier courant
+ * \param telemetry l'enregistrement
+ * \param event l'évènement
+ */
+static void write_telemetry_event(telemetry_t *telemetry, const telemetry_event_t *event) {
+    if (telemetry->file == NULL || telemetry->file_size >= TELEMETRY_FILE_SIZE) {
+        rotate_telemetry_file(telemetry);
+        if (telemetry->file == NULL) {
+            return;
+        }
+    }
+    if (telemetry->format == TELEMETRY_FORMAT_BINARY) {
+        fwrite(event, sizeof(telemetry_event_t), 1, telemetry->file);
+        telemetry->file_size += sizeof(telemetry_event_t);
+        return;
+    }
+    double time = (double)(event->counter - telemetry->start_counter) / SDL_GetPerformanceFrequency();
+    int length = fprintf(telemetry->file, "{\"time\":%.6f,\"event\":\"%s\",\"level\":%d,\"player\":%d,\"playing_time\":%llu,\"x\":%g,\"y\":%g", time,
+                         telemetry_event_names[event->type], event->level, event->player, (unsigned long long)event->playing_time, event->x, event->y);
+    if (event->type == TELEMETRY_DEATH) {
+        length += fprintf(telemetry->file, ",\"meteorite\":%lld", (long long)event->meteorite);
+    } else if (event->type == TELEMETRY_FRAME_SUMMARY) {
+        length += fprintf(telemetry->file, ",\"frames\":%u,\"mean_frame_time\":%.3f,\"max_frame_time\":%.3f", event->frame_count,
+                          event->mean_frame_time, event->max_frame_time);
+    } else if (event->type == TELEMETRY_INVINCIBILITY) {
+        length += fprintf(telemetry->file, ",\"invincible\":%s", event->invincible ? "true" : "false");
+    }
+    length += fprintf(telemetry->file, "}\n");
+    telemetry->file_size += length;
+}
+
+/**
+ * \brief La boucle du fil d'écriture : il vide la file à intervalles réguliers, jusqu'à l'arrêt de l'enregistrement et l'épuisement de la file
+ * \param data l'enregistrement
+ * \return 0
+ */
+static int telemetry_thread(void *data) {
+    telemetry_t *telemetry = data;
+    while (true) {
+        bool running = SDL_AtomicGet(&telemetry->running);
+        int tail = SDL_AtomicGet(&telemetry->tail), head = SDL_AtomicGet(&telemetry->head);
+        for (int i = tail; i != head; i++) {
+            write_telemetry_event(telemetry, &telemetry->events[i % TELEMETRY_QUEUE_SIZE]);
+        }
+        SDL_AtomicAdd(&telemetry->written, head - tail);
+        SDL_AtomicSet(&telemetry->tail, head);
+        if (telemetry->file != NULL) {
+            fflush(telemetry->file);
+        }
+        if (!running) {
+            break;
+        }
+        SDL_Delay(TELEMETRY_FLUSH_INTERVAL);
+    }
+    return 0;
+}
+
+/**
+ * \brief La fonction démarre l'enregistrement et son fil d'écriture
+ * \param telemetry l'enregistrement
+ * \param directory le répertoire des fichiers, qui doit exister
+ * \param format le format des fichiers
+ * \return true si l'enregistrement a démarré, false sinon
+ */
+bool start_telemetry(telemetry_t *telemetry, const char *directory, telemetry_format_t format) {
+    telemetry->directory = directory;
+    telemetry->format = format;
+    telemetry->session = (long long)time(NULL);
+    telemetry->start_counter = SDL_GetPerformanceCounter();
+    telemetry->file = NULL;
+    telemetry->file_index = 0;
+    telemetry->file_size = 0;
+    telemetry->summary_frames = 0;
+    telemetry->summary_time = 0;
+    telemetry->summary_max = 0;
+    SDL_AtomicSet(&telemetry->head, 0);
+    SDL_AtomicSet(&telemetry->tail, 0);
+    SDL_AtomicSet(&telemetry->running, 1);
+    SDL_AtomicSet(&telemetry->written, 0);
+    SDL_AtomicSet(&telemetry->dropped, 0);
+    telemetry->thread = SDL_CreateThread(telemetry_thread, "telemetry", telemetry);
+    if (telemetry->thread == NULL) {
+        fprintf(stderr, "Erreur lors de la creation du fil de télémétrie : %s\n", SDL_GetError());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * \brief La fonction ajoute un évènement à la file, horodaté à l'instant de l'appel, ou l'abandonne si la file est pleine.
+ * Elle ne doit être appelée que depuis un seul fil.
+ * \param telemetry l'enregistrement, ou NULL pour ne rien enregistrer
+ * \param event l'évènement
+ */
+void record_telemetry_event(telemetry_t *telemetry, const telemetry_event_t *event) {
+    if (telemetry == NULL) {
+        return;
+    }
+    int head = SDL_AtomicGet(&telemetry->head);
+    if (head - SDL_AtomicGet(&telemetry->tail) >= TELEMETRY_QUEUE_SIZE) {
+        SDL_AtomicAdd(&telemetry->dropped, 1);
+        return;
+    }
+    telemetry_event_t *slot = &telemetry->events[head % TELEMETRY_QUEUE_SIZE];
+    *slot = *event;
+    slot->counter = SDL_GetPerformanceCounter();
+    SDL_AtomicSet(&telemetry->head, head + 1);
+}
+
+/**
+ * \brief La fonction accumule la durée d'une frame, et ajoute un résumé à la file toutes les TELEMETRY_SUMMARY_INTERVAL ms de jeu
+ * \param telemetry l'enregistrement, ou NULL pour ne rien enregistrer
+ * \param event l'évènement de base du résumé (niveau, temps de jeu, position)
+ * \param frame_time la durée de la frame, en ms
+ */
+void record_telemetry_frame(telemetry_t *telemetry, const telemetry_event_t *event, Uint64 frame_time) {
+    if (telemetry == NULL) {
+        return;
+    }
+    telemetry->summary_frames++;
+    telemetry->summary_time += frame_time;
+    telemetry->summary_max = MAX(telemetry->summary_max, frame_time);
+    if (telemetry->summary_time < TELEMETRY_SUMMARY_INTERVAL) {
+        return;
+    }
+    telemetry_event_t summary = *event;
+    summary.type = TELEMETRY_FRAME_SUMMARY;
+    summary.frame_count = telemetry->summary_frames;
+    summary.mean_frame_time = (double)telemetry->summary_time / telemetry->summary_frames;
+    summary.max_frame_time = telemetry->summary_max;
+    record_telemetry_event(telemetry, &summary);
+    telemetry->summary_frames = 0;
+    telemetry->summary_time = 0;
+    telemetry->summary_max = 0;
+}
+
+/**
+ * \brief La fonction écrit les évènements restants, arrête le fil d'écriture et ferme le fichier courant
+ * \param telemetry l'enregistrement
+ */
+void stop_telemetry(telemetry_t *telemetry) {
+    SDL_AtomicSet(&telemetry->running, 0);
+    SDL_WaitThread(telemetry->thread, NULL);
+    if (telemetry->file != NULL) {
+        fclose(telemetry->file);
+    }
+}
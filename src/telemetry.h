@@ -0,0 +1,130 @@
+/**
+ * \file telemetry.h
+ * \brief Fichier contenant l'enregistrement des évènements de partie, écrits sur disque par un fil en arrière-plan
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#ifndef __TELEMETRY_H__
+#define __TELEMETRY_H__
+
+#include <SDL.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+/**
+ * \brief Nombre d'évènements de la file entre le fil de simulation et le fil d'écriture
+ */
+#define TELEMETRY_QUEUE_SIZE 4096
+
+/**
+ * \brief Intervalle (en ms) entre deux vidages de la file par le fil d'écriture
+ */
+#define TELEMETRY_FLUSH_INTERVAL 100
+
+/**
+ * \brief Durée de jeu (en ms) résumée par chaque évènement de résumé des frames
+ */
+#define TELEMETRY_SUMMARY_INTERVAL 1000
+
+/**
+ * \brief Taille (en octets) à partir de laquelle un fichier est fermé et le suivant ouvert
+ */
+#define TELEMETRY_FILE_SIZE (1 << 20)
+
+/**
+ * \brief Nombre de fichiers conservés, les plus anciens étant supprimés
+ */
+#define TELEMETRY_MAX_FILES 8
+
+/**
+ * \brief Signature des fichiers binaires ("SCTM")
+ */
+#define TELEMETRY_MAGIC 0x4D544353
+
+/**
+ * \brief Types d'évènements
+ */
+enum telemetry_event_type_e {
+    TELEMETRY_LEVEL_START,   /*!< Début d'un niveau */
+    TELEMETRY_LEVEL_FINISH,  /*!< Ligne d'arrivée franchie */
+    TELEMETRY_DEATH,         /*!< Collision avec une météorite */
+    TELEMETRY_FRAME_SUMMARY, /*!< Résumé des durées de frame */
+    TELEMETRY_INVINCIBILITY, /*!< Activation ou désactivation de l'invincibilité */
+    TELEMETRY_NEAR_MISS,     /*!< Météorite frôlée sans collision */
+    TELEMETRY_RETRY,         /*!< Reprise du niveau au début ou au dernier point de passage */
+};
+typedef enum telemetry_event_type_e telemetry_event_type_t;
+
+/**
+ * \brief Formats des fichiers
+ */
+enum telemetry_format_e {
+    TELEMETRY_FORMAT_NDJSON, /*!< Un objet JSON par ligne */
+    TELEMETRY_FORMAT_BINARY, /*!< En-tête, puis évènements tels qu'en mémoire */
+};
+typedef enum telemetry_format_e telemetry_format_t;
+
+/**
+ * \brief Évènement, de taille fixe
+ */
+typedef struct telemetry_event_s {
+    Uint32 type;
+    Sint32 level;
+    Sint32 player; /*!< Numéro du joueur concerné */
+    Uint32 reserved;
+    Uint64 counter;      /*!< Instant de l'évènement, en ticks de SDL_GetPerformanceCounter */
+    Uint64 playing_time; /*!< Temps de jeu, en ms */
+    double x;            /*!< Position du vaisseau */
+    double y;
+    Sint64 meteorite;       /*!< Indice de la météorite percutée, ou -1 */
+    Uint32 frame_count;     /*!< Nombre de frames résumées */
+    Uint32 invincible;      /*!< État de l'invincibilité */
+    double mean_frame_time; /*!< Durée moyenne des frames résumées, en ms */
+    double max_frame_time;  /*!< Durée maximale des frames résumées, en ms */
+} telemetry_event_t;
+
+/**
+ * \brief En-tête des fichiers binaires
+ */
+typedef struct telemetry_header_s {
+    Uint32 magic;
+    Uint32 event_size;    /*!< Taille d'un évènement, pour vérifier la compatibilité */
+    Uint64 frequency;     /*!< Fréquence de SDL_GetPerformanceCounter */
+    Uint64 start_counter; /*!< Instant du démarrage de l'enregistrement */
+} telemetry_header_t;
+
+/**
+ * \brief Enregistrement des évènements. Ils passent du fil de simulation au fil d'écriture par une file circulaire sans verrou, à un seul
+ * producteur et un seul consommateur : l'enregistrement d'un évènement n'est qu'une copie et une écriture atomique, sans appel système.
+ */
+typedef struct telemetry_s {
+    const char *directory;
+    telemetry_format_t format;
+    long long session;    /*!< Heure de démarrage, qui préfixe les noms de fichiers */
+    Uint64 start_counter; /*!< Instant du démarrage */
+    FILE *file;           /*!< Fichier courant, propriété du fil d'écriture */
+    int file_index;
+    long file_size;
+    Uint32 summary_frames; /*!< Frames en cours de résumé, propriété du producteur */
+    Uint64 summary_time;
+    Uint64 summary_max;
+    telemetry_event_t events[TELEMETRY_QUEUE_SIZE];
+    SDL_atomic_t head; /*!< Écrit par le producteur */
+    SDL_atomic_t tail; /*!< Écrit par le fil d'écriture */
+    SDL_atomic_t running;
+    SDL_atomic_t written; /*!< Nombre d'évènements écrits */
+    SDL_atomic_t dropped; /*!< Nombre d'évènements abandonnés, la file étant pleine */
+    SDL_Thread *thread;
+} telemetry_t;
+
+bool start_telemetry(telemetry_t *telemetry, const char *directory, telemetry_format_t format);
+
+void record_telemetry_event(telemetry_t *telemetry, const telemetry_event_t *event);
+
+void record_telemetry_frame(telemetry_t *telemetry, const telemetry_event_t *event, Uint64 frame_time);
+
+void stop_telemetry(telemetry_t *telemetry);
+
+#endif
@@ -0,0 +1,228 @@
+/**
+ * \file trace.c
+ * \brief Fichier contenant l'enregistrement d'une chronologie des fils d'exécution, exportée au format Chrome trace-event
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#include "trace.h"
+#include "logger.h"
+#include "utilities.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+bool trace_enabled = false;
+
+/**
+ * \brief La chronologie du programme, partagée par tous les fils
+ */
+static trace_t trace;
+
+/**
+ * \brief Tampon du fil courant, ou NULL s'il n'en a pas encore
+ */
+static _Thread_local trace_buffer_t *thread_buffer;
+
+/**
+ * \brief La fonction donne le tampon du fil courant, en lui attribuant au premier appel un tampon libre : de préférence un tampon déjà utilisé
+ * par un fil du même nom, pour que les fils éphémères se succèdent sur une même ligne de la chronologie, puis un tampon jamais utilisé
+ * \param name le nom du fil, une chaîne littérale
+ * \return le tampon, ou NULL si aucun tampon n'est libre
+ */
+static trace_buffer_t *acquire_trace_buffer(const char *name) {
+    if (thread_buffer != NULL) {
+        return thread_buffer;
+    }
+    for (int pass = 0; pass < 3; pass++) {
+        for (int i = 0; i < TRACE_MAX_THREADS; i++) {
+            trace_buffer_t *buffer = &trace.buffers[i];
+            const char *buffer_name = buffer->thread_name;
+            bool preferred = pass == 2 || (pass == 0 ? buffer_name != NULL && strcmp(buffer_name, name) == 0 : buffer_name == NULL);
+            if (preferred && SDL_AtomicCAS(&buffer->in_use, 0, 1)) {
+                buffer->thread_id = SDL_ThreadID();
+                buffer->thread_name = name;
+                thread_buffer = buffer;
+                return buffer;
+            }
+        }
+    }
+    return NULL;
+}
+
+/**
+ * \brief La fonction écrit la chronologie en JSON, au format Chrome trace-event : un fil par tampon, nommé par un évènement de métadonnées, et
+ * un évènement complet par intervalle, horodaté en microsecondes à la nanoseconde près. Les fils continuent d'écrire pendant l'export : seuls
+ * les intervalles qui ne peuvent pas être écrasés entre-temps sont écrits.
+ * \param path le fichier
+ */
+static void write_trace(const char *path) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        LOG_ERROR("Erreur lors de l'ouverture de la chronologie %s", path);
+        return;
+    }
+    double scale = 1e6 / (double)SDL_GetPerformanceFrequency();
+    int written = 0;
+    fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"spacecorridor\"}}");
+    for (int i = 0; i < TRACE_MAX_THREADS; i++) {
+        trace_buffer_t *buffer = &trace.buffers[i];
+        int count = SDL_AtomicGet(&buffer->count);
+        if (count == 0) {
+            continue;
+        }
+        fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\",\"thread_id\":%lu}}", i + 1,
+                buffer->thread_name, (unsigned long)buffer->thread_id);
+        for (int s = MAX(count - (TRACE_BUFFER_SIZE - TRACE_EXPORT_MARGIN), 0); s < count; s++) {
+            trace_span_t span = buffer->spans[s % TRACE_BUFFER_SIZE];
+            fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}", span.name, i + 1,
+                    (double)(span.start - trace.origin) * scale, (double)(span.end - span.start) * scale);
+            written++;
+        }
+    }
+    fprintf(file, "\n]}\n");
+    fclose(file);
+    LOG_INFO("Chronologie écrite dans %s : %d intervalle(s)", path, written);
+}
+
+/**
+ * \brief La boucle du fil d'export : il attend une demande et écrit la chronologie dans un nouveau fichier numéroté, jusqu'à l'arrêt
+ * \param data inutilisé
+ * \return 0
+ */
+static int trace_thread(void *data) {
+    (void)data;
+    while (true) {
+        SDL_SemWait(trace.wake);
+        if (!SDL_AtomicGet(&trace.running)) {
+            break;
+        }
+        size_t length = strlen(trace.path) + 32;
+        char *path = malloc(length);
+        if (path != NULL) {
+            snprintf(path, length, "%s.%d.json", trace.path, ++trace.export_count);
+            write_trace(path);
+            free(path);
+        } else {
+            LOG_ERROR("Mémoire insuffisante pour exporter la chronologie");
+        }
+        SDL_AtomicSet(&trace.pending, 0);
+    }
+    return 0;
+}
+
+/**
+ * \brief La fonction démarre l'enregistrement de la chronologie et son fil d'export. Elle doit être appelée avant la création des autres fils.
+ * \param path le fichier écrit à l'arrêt
+ * \return true si la chronologie a démarré, false sinon, le programme continuant alors sans chronologie
+ */
+bool start_trace(const char *path) {
+    trace.path = path;
+    bool allocated = true;
+    for (int i = 0; i < TRACE_MAX_THREADS; i++) {
+        trace.buffers[i] = (trace_buffer_t){0};
+        trace.buffers[i].spans = malloc(sizeof(trace_span_t) * TRACE_BUFFER_SIZE);
+        allocated = allocated && trace.buffers[i].spans != NULL;
+    }
+    if (!allocated) {
+        LOG_ERROR("Mémoire insuffisante pour la chronologie (%zu Mio), elle est désactivée",
+                  sizeof(trace_span_t) * TRACE_BUFFER_SIZE * TRACE_MAX_THREADS >> 20);
+        for (int i = 0; i < TRACE_MAX_THREADS; i++) {
+            free(trace.buffers[i].spans);
+        }
+        return false;
+    }
+    SDL_AtomicSet(&trace.missed, 0);
+    SDL_AtomicSet(&trace.pending, 0);
+    SDL_AtomicSet(&trace.running, 1);
+    trace.export_count = 0;
+    trace.wake = SDL_CreateSemaphore(0);
+    trace.thread = trace.wake != NULL ? SDL_CreateThread(trace_thread, "trace", NULL) : NULL;
+    if (trace.thread == NULL) {
+        LOG_ERROR("Erreur lors de la creation du fil de la chronologie : %s", SDL_GetError());
+        if (trace.wake != NULL) {
+            SDL_DestroySemaphore(trace.wake);
+        }
+        for (int i = 0; i < TRACE_MAX_THREADS; i++) {
+            free(trace.buffers[i].spans);
+        }
+        return false;
+    }
+    trace.origin = SDL_GetPerformanceCounter();
+    trace_enabled = true;
+    return true;
+}
+
+/**
+ * \brief La fonction nomme le fil courant dans la chronologie, en lui attribuant un tampon
+ * \param name le nom du fil, une chaîne littérale
+ */
+void name_trace_thread(const char *name) {
+    if (!trace_enabled) {
+        return;
+    }
+    trace_buffer_t *buffer = acquire_trace_buffer(name);
+    if (buffer != NULL) {
+        buffer->thread_name = name;
+    }
+}
+
+/**
+ * \brief La fonction rend le tampon du fil courant, qui doit être appelée avant la fin d'un fil éphémère : un fil créé ensuite reprend le
+ * tampon et ses intervalles, sous le même nom
+ */
+void release_trace_thread(void) {
+    if (thread_buffer != NULL) {
+        SDL_AtomicSet(&thread_buffer->in_use, 0);
+        thread_buffer = NULL;
+    }
+}
+
+/**
+ * \brief La fonction enregistre un intervalle terminé maintenant dans le tampon du fil courant, sans verrou ni allocation. Elle est appelée par
+ * TRACE_END.
+ * \param name le nom de l'intervalle, une chaîne littérale
+ * \param start le début de l'intervalle, en ticks de SDL_GetPerformanceCounter
+ */
+void record_trace_span(const char *name, Uint64 start) {
+    Uint64 end = SDL_GetPerformanceCounter();
+    trace_buffer_t *buffer = acquire_trace_buffer("thread");
+    if (buffer == NULL) {
+        SDL_AtomicAdd(&trace.missed, 1);
+        return;
+    }
+    int count = SDL_AtomicGet(&buffer->count);
+    buffer->spans[count % TRACE_BUFFER_SIZE] = (trace_span_t){name, start, end};
+    // L'intervalle n'est visible par le fil d'export qu'une fois écrit
+    SDL_AtomicSet(&buffer->count, count + 1);
+}
+
+/**
+ * \brief La fonction demande au fil d'export d'écrire la chronologie, sans attendre. Elle est ignorée si un export est déjà en cours.
+ */
+void request_trace_export(void) {
+    if (trace_enabled && SDL_AtomicCAS(&trace.pending, 0, 1)) {
+        SDL_SemPost(trace.wake);
+    }
+}
+
+/**
+ * \brief La fonction arrête le fil d'export et écrit la chronologie dans son fichier. Les tampons restent alloués jusqu'à la fin du programme,
+ * d'autres fils pouvant encore y écrire.
+ */
+void stop_trace(void) {
+    if (!trace_enabled || !SDL_AtomicGet(&trace.running)) {
+        return;
+    }
+    SDL_AtomicSet(&trace.running, 0);
+    SDL_SemPost(trace.wake);
+    SDL_WaitThread(trace.thread, NULL);
+    SDL_DestroySemaphore(trace.wake);
+    write_trace(trace.path);
+    int missed = SDL_AtomicGet(&trace.missed);
+    if (missed > 0) {
+        LOG_WARNING("Chronologie : %d intervalle(s) perdu(s), plus de %d fils enregistrés en même temps", missed, TRACE_MAX_THREADS);
+    }
+}
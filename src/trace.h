@@ -0,0 +1,98 @@
+/**
+ * \file trace.h
+ * \brief Fichier contenant l'enregistrement d'une chronologie des fils d'exécution, exportée au format Chrome trace-event
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#ifndef __TRACE_H__
+#define __TRACE_H__
+
+#include <SDL.h>
+#include <stdbool.h>
+
+/**
+ * \brief Nombre d'intervalles conservés par fil, les plus anciens étant écrasés
+ */
+#define TRACE_BUFFER_SIZE 32768
+
+/**
+ * \brief Nombre maximal de fils enregistrés en même temps
+ */
+#define TRACE_MAX_THREADS 16
+
+/**
+ * \brief Nombre d'intervalles les plus anciens d'un tampon plein ignorés à l'export, car ils peuvent être écrasés pendant leur écriture
+ */
+#define TRACE_EXPORT_MARGIN 4096
+
+/**
+ * \brief Intervalle de temps mesuré
+ */
+typedef struct trace_span_s {
+    const char *name; /*!< Nom de l'intervalle, une chaîne littérale */
+    Uint64 start;     /*!< Début, en ticks de SDL_GetPerformanceCounter */
+    Uint64 end;       /*!< Fin, en ticks de SDL_GetPerformanceCounter */
+} trace_span_t;
+
+/**
+ * \brief Tampon circulaire des intervalles d'un fil, écrit uniquement par ce fil
+ */
+typedef struct trace_buffer_s {
+    SDL_atomic_t in_use;     /*!< Indique si le tampon est attribué à un fil */
+    SDL_atomic_t count;      /*!< Nombre d'intervalles écrits depuis le début, l'indice du suivant étant count % TRACE_BUFFER_SIZE */
+    SDL_threadID thread_id;  /*!< Identifiant du dernier fil auquel le tampon a été attribué */
+    const char *thread_name; /*!< Nom du fil, une chaîne littérale */
+    trace_span_t *spans;
+} trace_buffer_t;
+
+/**
+ * \brief Chronologie. Chaque fil écrit ses intervalles dans son propre tampon, sans verrou ni allocation ; un fil d'export les écrit en JSON à
+ * la demande, pendant que les autres fils continuent.
+ */
+typedef struct trace_s {
+    const char *path; /*!< Fichier écrit à l'arrêt ; les exports demandés en cours de partie y ajoutent leur numéro */
+    Uint64 origin;    /*!< Instant du démarrage, origine des horodatages */
+    trace_buffer_t buffers[TRACE_MAX_THREADS];
+    SDL_atomic_t missed;  /*!< Nombre d'intervalles perdus, aucun tampon n'étant libre pour leur fil */
+    SDL_atomic_t pending; /*!< Indique qu'un export est demandé et pas encore terminé */
+    SDL_atomic_t running;
+    int export_count;
+    SDL_sem *wake;
+    SDL_Thread *thread;
+} trace_t;
+
+/**
+ * \brief Indique si la chronologie est enregistrée ; fixé avant le démarrage des autres fils
+ */
+extern bool trace_enabled;
+
+/**
+ * \brief Déclare et démarre l'intervalle span. Sans chronologie, il ne coûte qu'un test.
+ */
+#define TRACE_BEGIN(span) Uint64 span = trace_enabled ? SDL_GetPerformanceCounter() : 0
+
+/**
+ * \brief Termine l'intervalle span et l'enregistre sous le nom name, qui doit être une chaîne littérale
+ */
+#define TRACE_END(span, name)                                                                                                                                  \
+    do {                                                                                                                                                       \
+        if ((span) != 0) {                                                                                                                                     \
+            record_trace_span((name), (span));                                                                                                                 \
+        }                                                                                                                                                      \
+    } while (false)
+
+bool start_trace(const char *path);
+
+void name_trace_thread(const char *name);
+
+void release_trace_thread(void);
+
+void record_trace_span(const char *name, Uint64 start);
+
+void request_trace_export(void);
+
+void stop_trace(void);
+
+#endif
@@ -0,0 +1,158 @@
+/**
+ * \file watcher.c
+ * \brief Fichier contenant la surveillance des fichiers de niveaux, pour les recharger pendant la partie
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#include "watcher.h"
+#include "sdl2-light.h"
+#include "utilities.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#else
+#include <sys/stat.h>
+#endif
+
+/**
+ * \brief La fonction décode un fichier modifié s'il s'agit d'un niveau, et le met en attente pour la simulation
+ * \param watcher la surveillance
+ * \param name le nom du fichier dans le répertoire surveillé
+ */
+static void decode_level(level_watcher_t *watcher, const char *name) {
+    int level, length = 0;
+    if (sscanf(name, "level_%d.png%n", &level, &length) != 1 || (size_t)length != strlen(name) || level < 0 || level >= LEVEL_WATCHER_MAX_LEVELS) {
+        return;
+    }
+    SDL_Surface *level_surface;
+    bool success;
+    load_image(NULL, watcher->directory, name, &level_surface, &success);
+    if (!success) {
+        // Fichier en cours d'écriture ou invalide : la prochaine modification sera prise en compte
+        fprintf(stderr, "Niveau illisible : %s\n", name);
+        return;
+    }
+    SDL_Surface *previous = SDL_AtomicSetPtr(&watcher->pending[level], level_surface);
+    if (previous != NULL) {
+        SDL_FreeSurface(previous);
+    }
+}
+
+#ifdef __linux__
+/**
+ * \brief La boucle du fil de surveillance : il attend les évènements inotify du répertoire, les fichiers étant considérés modifiés à leur
+ * fermeture après écriture ou à leur remplacement par renommage
+ * \param data la surveillance
+ * \return 0
+ */
+static int level_watcher_thread(void *data) {
+    level_watcher_t *watcher = data;
+    int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd == -1 || inotify_add_watch(fd, watcher->directory, IN_CLOSE_WRITE | IN_MOVED_TO) == -1) {
+        fprintf(stderr, "Impossible de surveiller %s\n", watcher->directory);
+        if (fd != -1) {
+            close(fd);
+        }
+        return 0;
+    }
+    _Alignas(struct inotify_event) char buffer[4096];
+    while (SDL_AtomicGet(&watcher->running)) {
+        struct pollfd poll_fd = {fd, POLLIN, 0};
+        if (poll(&poll_fd, 1, LEVEL_WATCHER_POLL_INTERVAL) <= 0) {
+            continue;
+        }
+        ssize_t length = read(fd, buffer, sizeof(buffer));
+        const struct inotify_event *event;
+        for (char *p = buffer; p < buffer + length; p += sizeof(struct inotify_event) + event->len) {
+            event = (const struct inotify_event *)p;
+            if (event->len > 0) {
+                decode_level(watcher, event->name);
+            }
+        }
+    }
+    close(fd);
+    return 0;
+}
+#else
+/**
+ * \brief La boucle du fil de surveillance, sans inotify : il compare régulièrement les dates de modification des niveaux
+ * \param data la surveillance
+ * \return 0
+ */
+static int level_watcher_thread(void *data) {
+    level_watcher_t *watcher = data;
+    time_t modification_times[LEVEL_WATCHER_MAX_LEVELS] = {0};
+    bool first = true;
+    while (SDL_AtomicGet(&watcher->running)) {
+        for (int level = 0; level < LEVEL_WATCHER_MAX_LEVELS; level++) {
+            char name[30];
+            sprintf(name, "level_%d.png", level);
+            char *path = concat_paths(watcher->directory, name);
+            struct stat file_stat;
+            if (stat(path, &file_stat) == 0 && file_stat.st_mtime != modification_times[level]) {
+                modification_times[level] = file_stat.st_mtime;
+                if (!first) {
+                    decode_level(watcher, name);
+                }
+            }
+            free(path);
+        }
+        first = false;
+        SDL_Delay(LEVEL_WATCHER_POLL_INTERVAL);
+    }
+    return 0;
+}
+#endif
+
+/**
+ * \brief La fonction démarre la surveillance d'un répertoire de niveaux
+ * \param watcher la surveillance
+ * \param directory le répertoire contenant les fichiers level_N.png
+ * \return true si la surveillance a démarré, false sinon
+ */
+bool start_level_watcher(level_watcher_t *watcher, const char *directory) {
+    watcher->directory = directory;
+    for (int level = 0; level < LEVEL_WATCHER_MAX_LEVELS; level++) {
+        watcher->pending[level] = NULL;
+    }
+    SDL_AtomicSet(&watcher->running, 1);
+    watcher->thread = SDL_CreateThread(level_watcher_thread, "level watcher", watcher);
+    if (watcher->thread == NULL) {
+        fprintf(stderr, "Erreur lors de la creation du fil de surveillance : %s\n", SDL_GetError());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * \brief La fonction récupère la dernière image modifiée d'un niveau, s'il y en a une
+ * \param watcher la surveillance
+ * \param level le numéro du niveau
+ * \return l'image, à libérer par l'appelant, ou NULL si le niveau n'a pas été modifié
+ */
+SDL_Surface *take_level_update(level_watcher_t *watcher, int level) {
+    if (level < 0 || level >= LEVEL_WATCHER_MAX_LEVELS) {
+        return NULL;
+    }
+    return SDL_AtomicSetPtr(&watcher->pending[level], NULL);
+}
+
+/**
+ * \brief La fonction arrête le fil de surveillance et libère les images en attente
+ * \param watcher la surveillance
+ */
+void stop_level_watcher(level_watcher_t *watcher) {
+    SDL_AtomicSet(&watcher->running, 0);
+    SDL_WaitThread(watcher->thread, NULL);
+    for (int level = 0; level < LEVEL_WATCHER_MAX_LEVELS; level++) {
+        if (watcher->pending[level] != NULL) {
+            SDL_FreeSurface(watcher->pending[level]);
+        }
+    }
+}
@@ -0,0 +1,41 @@
+/**
+ * \file watcher.h
+ * \brief Fichier contenant la surveillance des fichiers de niveaux, pour les recharger pendant la partie
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#ifndef __WATCHER_H__
+#define __WATCHER_H__
+
+#include <SDL.h>
+#include <stdbool.h>
+
+/**
+ * \brief Nombre maximal de niveaux surveillés
+ */
+#define LEVEL_WATCHER_MAX_LEVELS 32
+
+/**
+ * \brief Intervalle (en ms) entre deux vérifications de l'arrêt, ou des dates de modification sans inotify
+ */
+#define LEVEL_WATCHER_POLL_INTERVAL 250
+
+/**
+ * \brief Surveillance d'un répertoire de niveaux par un fil en arrière-plan, qui décode les niveaux modifiés
+ */
+typedef struct level_watcher_s {
+    const char *directory;
+    void *pending[LEVEL_WATCHER_MAX_LEVELS]; /*!< Dernière image décodée de chaque niveau, en attente, échangée atomiquement */
+    SDL_atomic_t running;
+    SDL_Thread *thread;
+} level_watcher_t;
+
+bool start_level_watcher(level_watcher_t *watcher, const char *directory);
+
+SDL_Surface *take_level_update(level_watcher_t *watcher, int level);
+
+void stop_level_watcher(level_watcher_t *watcher);
+
+#endif
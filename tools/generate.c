@@ -0,0 +1,394 @@
+/**
+ * \file generate.c
+ * \brief Programme de génération de niveaux synthétiques, de taille et de densité réglables, pour mesurer le passage à l'échelle du jeu. Le
+ * niveau est écrit ligne par ligne dans un PNG à palette, sans jamais être entièrement en mémoire.
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#include "constants.h"
+#include "utilities.h"
+#include <SDL.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * \brief Taille des blocs de données IDAT écrits dans le fichier
+ */
+#define GENERATE_CHUNK_SIZE 65536
+
+/**
+ * \brief Demi-largeur (en cases) du couloir laissé libre au centre du niveau, pour qu'une course tout droit ne s'écrase jamais
+ */
+#define GENERATE_CORRIDOR_HALF_WIDTH 2
+
+/**
+ * \brief Nombre de variantes de phase et de rotation des météorites mobiles pour chaque amplitude, dans la palette
+ */
+#define GENERATE_MOBILE_VARIANTS 15
+
+/**
+ * \brief Longueur maximale d'une répétition dans le format deflate
+ */
+#define DEFLATE_MAX_MATCH 258
+
+/**
+ * \brief Écriture en continu d'un PNG à palette, compressé par des répétitions de l'octet précédent avec les codes de Huffman fixes de deflate
+ */
+typedef struct png_writer_s {
+    FILE *file;
+    Uint8 data[GENERATE_CHUNK_SIZE]; /*!< Données compressées en attente d'écriture dans un bloc IDAT */
+    size_t length;
+    Uint32 bits; /*!< Bits en attente d'un octet complet, le premier écrit en poids faible */
+    int bit_count;
+    Uint32 adler_a; /*!< Somme de contrôle Adler-32 des données non compressées */
+    Uint32 adler_b;
+    int previous; /*!< Dernier octet écrit en littéral, ou -1 */
+    int run;      /*!< Nombre de répétitions de cet octet pas encore écrites */
+} png_writer_t;
+
+/**
+ * \brief Table du CRC-32 des blocs PNG
+ */
+static Uint32 crc_table[256];
+
+/**
+ * \brief La fonction remplit la table du CRC-32
+ */
+static void init_crc_table(void) {
+    for (Uint32 n = 0; n < 256; n++) {
+        Uint32 crc = n;
+        for (int k = 0; k < 8; k++) {
+            crc = crc & 1 ? 0xEDB88320 ^ (crc >> 1) : crc >> 1;
+        }
+        crc_table[n] = crc;
+    }
+}
+
+/**
+ * \brief La fonction poursuit le calcul d'un CRC-32
+ * \param crc le CRC des octets précédents, complémenté
+ * \param data les octets
+ * \param length le nombre d'octets
+ * \return le CRC complémenté
+ */
+static Uint32 update_crc(Uint32 crc, const Uint8 *data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        crc = crc_table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+/**
+ * \brief La fonction écrit un entier de 32 bits en gros-boutiste
+ * \param bytes les octets à remplir
+ * \param value l'entier
+ */
+static void store_be32(Uint8 *bytes, Uint32 value) {
+    bytes[0] = value >> 24;
+    bytes[1] = value >> 16;
+    bytes[2] = value >> 8;
+    bytes[3] = value;
+}
+
+/**
+ * \brief La fonction écrit un bloc PNG : longueur, type, données et CRC
+ * \param file le fichier
+ * \param type le type du bloc, quatre lettres
+ * \param data les données
+ * \param length la longueur des données
+ */
+static void write_png_chunk(FILE *file, const char *type, const Uint8 *data, size_t length) {
+    Uint8 header[8], footer[4];
+    store_be32(header, length);
+    memcpy(header + 4, type, 4);
+    store_be32(footer, ~update_crc(update_crc(0xFFFFFFFF, header + 4, 4), data, length));
+    fwrite(header, 1, sizeof(header), file);
+    fwrite(data, 1, length, file);
+    fwrite(footer, 1, sizeof(footer), file);
+}
+
+/**
+ * \brief La fonction ajoute un octet compressé, et écrit un bloc IDAT quand le tampon est plein
+ * \param writer l'écriture
+ * \param byte l'octet
+ */
+static void put_byte(png_writer_t *writer, Uint8 byte) {
+    writer->data[writer->length++] = byte;
+    if (writer->length == GENERATE_CHUNK_SIZE) {
+        write_png_chunk(writer->file, "IDAT", writer->data, writer->length);
+        writer->length = 0;
+    }
+}
+
+/**
+ * \brief La fonction ajoute des bits au flux deflate, le bit de poids faible en premier
+ * \param writer l'écriture
+ * \param value les bits
+ * \param count le nombre de bits, au plus 16
+ */
+static void put_bits(png_writer_t *writer, Uint32 value, int count) {
+    writer->bits |= value << writer->bit_count;
+    writer->bit_count += count;
+    while (writer->bit_count >= 8) {
+        put_byte(writer, writer->bits & 0xFF);
+        writer->bits >>= 8;
+        writer->bit_count -= 8;
+    }
+}
+
+/**
+ * \brief La fonction ajoute un code de Huffman, écrit en commençant par son bit de poids fort
+ * \param writer l'écriture
+ * \param code le code
+ * \param length la longueur du code
+ */
+static void put_huffman_code(png_writer_t *writer, Uint32 code, int length) {
+    Uint32 reversed = 0;
+    for (int i = 0; i < length; i++) {
+        reversed = (reversed << 1) | ((code >> i) & 1);
+    }
+    put_bits(writer, reversed, length);
+}
+
+/**
+ * \brief La fonction ajoute un symbole de l'alphabet des littéraux et des longueurs, avec les codes de Huffman fixes
+ * \param writer l'écriture
+ * \param symbol le symbole, de 0 à 287
+ */
+static void put_symbol(png_writer_t *writer, int symbol) {
+    if (symbol < 144) {
+        put_huffman_code(writer, 0x30 + symbol, 8);
+    } else if (symbol < 256) {
+        put_huffman_code(writer, 0x190 + symbol - 144, 9);
+    } else if (symbol < 280) {
+        put_huffman_code(writer, symbol - 256, 7);
+    } else {
+        put_huffman_code(writer, 0xC0 + symbol - 280, 8);
+    }
+}
+
+/**
+ * \brief La fonction ajoute une répétition de l'octet précédent (distance 1)
+ * \param writer l'écriture
+ * \param length la longueur de la répétition, de 3 à DEFLATE_MAX_MATCH
+ */
+static void put_match(png_writer_t *writer, int length) {
+    static const int bases[] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+    static const int extra_bits[] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+    int code = sizeof(bases) / sizeof(bases[0]) - 1;
+    while (bases[code] > length) {
+        code--;
+    }
+    put_symbol(writer, 257 + code);
+    put_bits(writer, length - bases[code], extra_bits[code]);
+    // Code de distance 0, c'est-à-dire une distance de 1, sur 5 bits
+    put_huffman_code(writer, 0, 5);
+}
+
+/**
+ * \brief La fonction écrit les répétitions en attente, en littéraux si elles sont trop courtes pour une répétition deflate
+ * \param writer l'écriture
+ */
+static void flush_run(png_writer_t *writer) {
+    if (writer->run >= 3) {
+        put_match(writer, writer->run);
+    } else {
+        for (int i = 0; i < writer->run; i++) {
+            put_symbol(writer, writer->previous);
+        }
+    }
+    writer->run = 0;
+}
+
+/**
+ * \brief La fonction compresse un octet de l'image
+ * \param writer l'écriture
+ * \param byte l'octet
+ */
+static void put_image_byte(png_writer_t *writer, Uint8 byte) {
+    writer->adler_a = (writer->adler_a + byte) % 65521;
+    writer->adler_b = (writer->adler_b + writer->adler_a) % 65521;
+    if (byte == writer->previous) {
+        if (++writer->run == DEFLATE_MAX_MATCH) {
+            flush_run(writer);
+        }
+        return;
+    }
+    flush_run(writer);
+    put_symbol(writer, byte);
+    writer->previous = byte;
+}
+
+/**
+ * \brief La fonction ouvre le fichier et écrit l'en-tête, la palette et le début du flux compressé
+ * \param writer l'écriture
+ * \param path le chemin du fichier
+ * \param width la largeur de l'image
+ * \param height la hauteur de l'image
+ * \param palette les couleurs de la palette, en RGB
+ * \param color_count le nombre de couleurs
+ * \return true si le fichier a été ouvert, false sinon
+ */
+static bool start_png(png_writer_t *writer, const char *path, Uint32 width, Uint32 height, const Uint8 *palette, int color_count) {
+    writer->file = fopen(path, "wb");
+    if (writer->file == NULL) {
+        return false;
+    }
+    static const Uint8 signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    fwrite(signature, 1, sizeof(signature), writer->file);
+    // 8 bits par pixel, couleurs indexées, compression deflate, filtrage standard, pas d'entrelacement
+    Uint8 header[13] = {0, 0, 0, 0, 0, 0, 0, 0, 8, 3, 0, 0, 0};
+    store_be32(header, width);
+    store_be32(header + 4, height);
+    write_png_chunk(writer->file, "IHDR", header, sizeof(header));
+    write_png_chunk(writer->file, "PLTE", palette, (size_t)color_count * 3);
+
+    writer->length = 0;
+    writer->bits = 0;
+    writer->bit_count = 0;
+    writer->adler_a = 1;
+    writer->adler_b = 0;
+    writer->previous = -1;
+    writer->run = 0;
+    // En-tête zlib (deflate, fenêtre de 32 Kio), puis un unique bloc final à codes de Huffman fixes
+    put_byte(writer, 0x78);
+    put_byte(writer, 0x01);
+    put_bits(writer, 1, 1);
+    put_bits(writer, 1, 2);
+    return true;
+}
+
+/**
+ * \brief La fonction termine le flux compressé, écrit la fin du fichier et le ferme
+ * \param writer l'écriture
+ * \return true si le fichier a été écrit, false sinon
+ */
+static bool finish_png(png_writer_t *writer) {
+    flush_run(writer);
+    put_symbol(writer, 256);
+    if (writer->bit_count > 0) {
+        put_bits(writer, 0, 8 - writer->bit_count);
+    }
+    Uint8 adler[4];
+    store_be32(adler, (writer->adler_b << 16) | writer->adler_a);
+    for (int i = 0; i < 4; i++) {
+        put_byte(writer, adler[i]);
+    }
+    if (writer->length > 0) {
+        write_png_chunk(writer->file, "IDAT", writer->data, writer->length);
+    }
+    write_png_chunk(writer->file, "IEND", NULL, 0);
+    return fclose(writer->file) == 0;
+}
+
+/**
+ * \brief La fonction tire un nombre pseudo-aléatoire (xorshift64*), reproductible pour une graine donnée
+ * \param state l'état du générateur, non nul
+ * \return le nombre tiré
+ */
+static Uint64 next_random(Uint64 *state) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1DULL;
+}
+
+/**
+ * \brief La fonction tire un réel uniforme dans [0, 1)
+ * \param state l'état du générateur
+ * \return le réel tiré
+ */
+static double random_unit(Uint64 *state) {
+    return (next_random(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * \brief La fonction remplit la palette : le noir est le vide, le blanc une météorite fixe, et les autres couleurs des météorites mobiles qui
+ * oscillent et tournent sur elles-mêmes, selon le codage lu par le jeu (amplitude et phase dans le rouge, rotation dans le bleu). Les météorites
+ * générées ne dérivent jamais, pour ne pas traverser le couloir central.
+ * \param palette la palette à remplir, en RGB
+ * \return le nombre de couleurs
+ */
+static int fill_palette(Uint8 *palette) {
+    int count = 0;
+    palette[count * 3] = palette[count * 3 + 1] = palette[count * 3 + 2] = 0x00;
+    count++;
+    palette[count * 3] = palette[count * 3 + 1] = palette[count * 3 + 2] = 0xFF;
+    count++;
+    for (int amplitude = 0; amplitude < 16; amplitude++) {
+        for (int variant = 0; variant < GENERATE_MOBILE_VARIANTS; variant++) {
+            int angular_speed = (16 + variant * 7) * (variant % 2 == 0 ? 1 : -1);
+            palette[count * 3] = amplitude << 4 | variant;
+            palette[count * 3 + 1] = 0;
+            palette[count * 3 + 2] = (Uint8)(Sint8)angular_speed;
+            count++;
+        }
+    }
+    return count;
+}
+
+/**
+ * \brief Programme principal : spacecorridor-generate NIVEAU LARGEUR HAUTEUR DENSITE [MOBILES] [GRAINE]
+ *
+ * Chaque case hors du couloir central porte une météorite avec la probabilité DENSITE, mobile avec la probabilité MOBILES (0.1 par défaut).
+ * L'amplitude d'oscillation d'une météorite mobile est bornée par sa distance au couloir.
+ */
+int main(int argc, char **argv) {
+    if (argc < 5) {
+        fprintf(stderr, "Usage : %s NIVEAU LARGEUR HAUTEUR DENSITE [MOBILES] [GRAINE]\n", argv[0]);
+        return 1;
+    }
+    const char *output_path = argv[1];
+    long width = strtol(argv[2], NULL, 10), height = strtol(argv[3], NULL, 10);
+    double density = strtod(argv[4], NULL);
+    double mobile_share = argc > 5 ? strtod(argv[5], NULL) : 0.1;
+    Uint64 seed = argc > 6 ? strtoull(argv[6], NULL, 10) : 1;
+    if (width <= 0 || height <= 0 || width > 0x7FFFFFFF || height > 0x7FFFFFFF) {
+        fprintf(stderr, "Taille invalide : %ldx%ld\n", width, height);
+        return 1;
+    }
+
+    init_crc_table();
+    Uint8 palette[256 * 3];
+    int color_count = fill_palette(palette);
+    static png_writer_t writer;
+    if (!start_png(&writer, output_path, width, height, palette, color_count)) {
+        fprintf(stderr, "Erreur pendant l'ouverture de %s\n", output_path);
+        return 1;
+    }
+
+    Uint64 state = seed * 0x9E3779B97F4A7C15ULL | 1, meteorite_count = 0;
+    for (long y = 0; y < height; y++) {
+        // Filtre PNG « aucun » en début de ligne
+        put_image_byte(&writer, 0);
+        for (long x = 0; x < width; x++) {
+            // Distance du centre de la case au centre du niveau, où part le vaisseau
+            double center_distance = fabs(x - width / 2.0 + 0.5);
+            Uint8 color = 0;
+            if (center_distance > GENERATE_CORRIDOR_HALF_WIDTH + 0.5 && random_unit(&state) < density) {
+                color = 1;
+                if (random_unit(&state) < mobile_share) {
+                    // L'oscillation s'arrête une demi-case avant le couloir
+                    double room = center_distance - GENERATE_CORRIDOR_HALF_WIDTH - 1.0;
+                    int max_amplitude = CLAMP((int)(room / METEORITE_MAX_AMPLITUDE * 15.0), 0, 15);
+                    int amplitude = next_random(&state) % (max_amplitude + 1);
+                    color = 2 + amplitude * GENERATE_MOBILE_VARIANTS + next_random(&state) % GENERATE_MOBILE_VARIANTS;
+                }
+                meteorite_count++;
+            }
+            put_image_byte(&writer, color);
+        }
+    }
+
+    if (!finish_png(&writer)) {
+        fprintf(stderr, "Erreur pendant l'écriture de %s\n", output_path);
+        return 1;
+    }
+    printf("%s : %ldx%ld cases, %llu météorites\n", output_path, width, height, (unsigned long long)meteorite_count);
+    return 0;
+}
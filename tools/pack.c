@@ -0,0 +1,195 @@
+/**
+ * \file pack.c
+ * \brief Programme de construction de l'archive des ressources : les images sont décodées en RGBA8888 et les sons convertis au format de sortie
+ * de l'audio, pour que le jeu n'ait plus rien à décoder au démarrage
+ * \author DANILKIN Artem, RUSCUK Emre
+ * \version 1.0
+ * \date 19 octobre 2026
+ */
+
+#include "archive.h"
+#include "constants.h"
+#include "utilities.h"
+#include <SDL_image.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * \brief Entrée en cours de construction
+ */
+typedef struct pack_entry_s {
+    archive_entry_t entry;
+    Uint8 *data;
+} pack_entry_t;
+
+/**
+ * \brief La fonction lit un fichier en entier
+ * \param path le chemin du fichier
+ * \param size la taille lue
+ * \return le contenu du fichier, ou NULL en cas d'erreur
+ */
+static Uint8 *read_file(const char *path, Uint64 *size) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    *size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    Uint8 *data = malloc(*size);
+    if (fread(data, 1, *size, file) != *size) {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    return data;
+}
+
+/**
+ * \brief La fonction décode une image en pixels RGBA8888 sans remplissage en fin de ligne
+ * \param path le chemin du fichier
+ * \param entry l'entrée à remplir
+ * \return true en cas de succès, false sinon
+ */
+static bool pack_image(const char *path, pack_entry_t *entry) {
+    SDL_Surface *image_surface = IMG_Load(path);
+    if (image_surface == NULL) {
+        fprintf(stderr, "Erreur pendant chargement image %s : %s\n", path, IMG_GetError());
+        return false;
+    }
+    SDL_Surface *surface = SDL_ConvertSurfaceFormat(image_surface, SDL_PIXELFORMAT_RGBA8888, 0);
+    SDL_FreeSurface(image_surface);
+    if (surface == NULL) {
+        fprintf(stderr, "Erreur pendant conversion image %s : %s\n", path, SDL_GetError());
+        return false;
+    }
+    entry->entry.type = ARCHIVE_ENTRY_IMAGE;
+    entry->entry.width = surface->w;
+    entry->entry.height = surface->h;
+    entry->entry.format = SDL_PIXELFORMAT_RGBA8888;
+    entry->entry.size = (Uint64)surface->w * surface->h * 4;
+    entry->data = malloc(entry->entry.size);
+    for (int y = 0; y < surface->h; y++) {
+        memcpy(entry->data + (size_t)y * surface->w * 4, (Uint8 *)surface->pixels + (size_t)y * surface->pitch, (size_t)surface->w * 4);
+    }
+    SDL_FreeSurface(surface);
+    return true;
+}
+
+/**
+ * \brief La fonction décode un son WAV et le convertit au format de sortie de l'audio du jeu
+ * \param path le chemin du fichier
+ * \param entry l'entrée à remplir
+ * \return true en cas de succès, false sinon
+ */
+static bool pack_sound(const char *path, pack_entry_t *entry) {
+    SDL_AudioSpec spec;
+    Uint8 *buffer;
+    Uint32 length;
+    if (SDL_LoadWAV(path, &spec, &buffer, &length) == NULL) {
+        fprintf(stderr, "Erreur pendant chargement du son %s : %s\n", path, SDL_GetError());
+        return false;
+    }
+    SDL_AudioCVT cvt;
+    SDL_BuildAudioCVT(&cvt, spec.format, spec.channels, spec.freq, AUDIO_FORMAT, AUDIO_CHANNELS, AUDIO_FREQUENCY);
+    cvt.len = length;
+    cvt.buf = malloc((size_t)length * cvt.len_mult);
+    memcpy(cvt.buf, buffer, length);
+    SDL_FreeWAV(buffer);
+    if (SDL_ConvertAudio(&cvt) != 0) {
+        fprintf(stderr, "Erreur pendant conversion du son %s : %s\n", path, SDL_GetError());
+        free(cvt.buf);
+        return false;
+    }
+    entry->entry.type = ARCHIVE_ENTRY_SOUND;
+    entry->entry.width = AUDIO_FREQUENCY;
+    entry->entry.height = AUDIO_CHANNELS;
+    entry->entry.format = AUDIO_FORMAT;
+    entry->entry.size = cvt.len_cvt;
+    entry->data = cvt.buf;
+    return true;
+}
+
+/**
+ * \brief La fonction copie une police telle quelle
+ * \param path le chemin du fichier
+ * \param entry l'entrée à remplir
+ * \return true en cas de succès, false sinon
+ */
+static bool pack_font(const char *path, pack_entry_t *entry) {
+    entry->data = read_file(path, &entry->entry.size);
+    if (entry->data == NULL) {
+        fprintf(stderr, "Erreur pendant lecture de la police %s\n", path);
+        return false;
+    }
+    entry->entry.type = ARCHIVE_ENTRY_FONT;
+    return true;
+}
+
+/**
+ * \brief Programme principal : spacecorridor-pack ARCHIVE RACINE CHEMIN...
+ */
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        fprintf(stderr, "Usage : %s ARCHIVE RACINE CHEMIN...\n", argv[0]);
+        return 1;
+    }
+    const char *output_path = argv[1], *root = argv[2];
+    int entry_count = argc - 3;
+    pack_entry_t *entries = calloc(MAX(entry_count, 1), sizeof(pack_entry_t));
+
+    Uint64 offset = sizeof(archive_header_t) + sizeof(archive_entry_t) * entry_count;
+    for (int i = 0; i < entry_count; i++) {
+        const char *name = argv[i + 3];
+        if (strlen(name) >= ARCHIVE_NAME_SIZE) {
+            fprintf(stderr, "Nom trop long : %s\n", name);
+            return 1;
+        }
+        strcpy(entries[i].entry.name, name);
+        char *path = concat_paths(root, name);
+        const char *extension = strrchr(name, '.');
+        bool success = false;
+        if (extension != NULL && strcmp(extension, ".png") == 0) {
+            success = pack_image(path, &entries[i]);
+        } else if (extension != NULL && strcmp(extension, ".wav") == 0) {
+            success = pack_sound(path, &entries[i]);
+        } else if (extension != NULL && strcmp(extension, ".ttf") == 0) {
+            success = pack_font(path, &entries[i]);
+        } else {
+            fprintf(stderr, "Type de ressource inconnu : %s\n", name);
+        }
+        free(path);
+        if (!success) {
+            return 1;
+        }
+        offset = (offset + ARCHIVE_ALIGNMENT - 1) / ARCHIVE_ALIGNMENT * ARCHIVE_ALIGNMENT;
+        entries[i].entry.offset = offset;
+        offset += entries[i].entry.size;
+    }
+
+    FILE *file = fopen(output_path, "wb");
+    if (file == NULL) {
+        fprintf(stderr, "Erreur pendant l'ouverture de %s\n", output_path);
+        return 1;
+    }
+    archive_header_t header = {ARCHIVE_MAGIC, ARCHIVE_VERSION, entry_count, 0};
+    fwrite(&header, sizeof(header), 1, file);
+    for (int i = 0; i < entry_count; i++) {
+        fwrite(&entries[i].entry, sizeof(archive_entry_t), 1, file);
+    }
+    for (int i = 0; i < entry_count; i++) {
+        // Remplissage jusqu'à l'alignement
+        for (long position = ftell(file); (Uint64)position < entries[i].entry.offset; position++) {
+            fputc(0, file);
+        }
+        fwrite(entries[i].data, 1, entries[i].entry.size, file);
+        free(entries[i].data);
+    }
+    free(entries);
+    if (fclose(file) != 0) {
+        fprintf(stderr, "Erreur pendant l'écriture de %s\n", output_path);
+        return 1;
+    }
+    return 0;
+}